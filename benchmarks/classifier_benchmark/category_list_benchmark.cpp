@@ -0,0 +1,240 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_benchmark/category_list_benchmark.cpp
+ * @brief       category_list benchmark.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "classifier/category_list.hpp"
+#include "classifier/flat_json_parser.hpp"
+#include "classifier/json.hpp"
+
+
+namespace {
+
+
+/** The number of categories files of the corpus. */
+constexpr std::size_t FILES_NBR = 10000;
+
+
+/**
+ * Categories files as they are usually written: a few keys, each with a handful of names taken
+ * from a small vocabulary, a mark and a flag.
+ */
+std::vector<std::string> make_corpus()
+{
+    static const char* const genres[] = {"Drama", "Comedy", "Horror", "Science Fiction", "Action",
+                                         "Documentary", "Animation", "Thriller"};
+    static const char* const peopl[] = {"Alice Martin", "Bob Durand", "Chloé Petit",
+                                        "David Moreau", "Emma Laurent", "François Simon"};
+    std::vector<std::string> corpus;
+    std::mt19937_64 rnd(3);
+    std::string contnt;
+
+    corpus.reserve(FILES_NBR);
+    for (std::size_t i = 0; i < FILES_NBR; ++i)
+    {
+        contnt = "{\n    \"Genres\": [";
+        for (std::size_t j = 0, n = 1 + rnd() % 3; j < n; ++j)
+        {
+            contnt += j > 0 ? ", \"" : "\"";
+            contnt += genres[rnd() % std::size(genres)];
+            contnt += "\"";
+        }
+
+        contnt += "],\n    \"Actors\": [";
+        for (std::size_t j = 0, n = 1 + rnd() % 4; j < n; ++j)
+        {
+            contnt += j > 0 ? ", \"" : "\"";
+            contnt += peopl[rnd() % std::size(peopl)];
+            contnt += "\"";
+        }
+
+        contnt += "],\n    \"Year\": " + std::to_string(1950 + rnd() % 75);
+        contnt += ",\n    \"Mark\": " + std::to_string(rnd() % 10);
+        contnt += ",\n    \"Seen\": ";
+        contnt += rnd() % 2 ? "true" : "false";
+        contnt += "\n}\n";
+
+        corpus.push_back(contnt);
+    }
+
+    return corpus;
+}
+
+
+/**
+ * A single large document holding the members of all the files of the corpus.
+ */
+std::string make_large_document(const std::vector<std::string>& corpus)
+{
+    std::string doc = "{";
+
+    for (std::size_t i = 0; i < corpus.size(); ++i)
+    {
+        doc += i > 0 ? "," : "";
+        doc += corpus[i].substr(1, corpus[i].rfind('}') - 1);
+    }
+
+    return doc + "}";
+}
+
+
+std::size_t get_corpus_size(const std::vector<std::string>& corpus)
+{
+    std::size_t sz = 0;
+
+    for (auto& x : corpus)
+    {
+        sz += x.size();
+    }
+
+    return sz;
+}
+
+
+}
+
+
+static void dom_parse(benchmark::State& stte)
+{
+    auto corpus = make_corpus();
+
+    for (auto _ : stte)
+    {
+        for (auto& x : corpus)
+        {
+            json json_parsr = json::parse(x.data(), x.data() + x.size(), nullptr, false);
+
+            // The document is walked like the planner used to walk it.
+            for (auto it = json_parsr.begin(); it != json_parsr.end(); ++it)
+            {
+                benchmark::DoNotOptimize(it.key().data());
+                benchmark::DoNotOptimize(&it.value());
+            }
+        }
+    }
+
+    stte.SetBytesProcessed(static_cast<std::int64_t>(stte.iterations() * get_corpus_size(corpus)));
+    stte.SetItemsProcessed(static_cast<std::int64_t>(stte.iterations() * corpus.size()));
+}
+
+
+static void sax_parse(benchmark::State& stte)
+{
+    auto corpus = make_corpus();
+    classifier::category_list categories;
+
+    for (auto _ : stte)
+    {
+        for (auto& x : corpus)
+        {
+            categories.parse(x);
+
+            for (auto& tokn : categories.get_tokens())
+            {
+                benchmark::DoNotOptimize(categories.get_text(tokn).data());
+            }
+        }
+    }
+
+    stte.SetBytesProcessed(static_cast<std::int64_t>(stte.iterations() * get_corpus_size(corpus)));
+    stte.SetItemsProcessed(static_cast<std::int64_t>(stte.iterations() * corpus.size()));
+}
+
+
+static void flat_parse(benchmark::State& stte)
+{
+    auto corpus = make_corpus();
+    classifier::flat_json_parser flat_json_parsr(static_cast<classifier::simd_levels>(stte.range(0)));
+    classifier::category_list categories;
+
+    if (flat_json_parsr.get_simd_level() != static_cast<classifier::simd_levels>(stte.range(0)))
+    {
+        stte.SkipWithError("Instruction set not supported");
+        return;
+    }
+
+    for (auto _ : stte)
+    {
+        for (auto& x : corpus)
+        {
+            categories.clear();
+            benchmark::DoNotOptimize(flat_json_parsr.parse(x, &categories));
+        }
+    }
+
+    stte.SetBytesProcessed(static_cast<std::int64_t>(stte.iterations() * get_corpus_size(corpus)));
+    stte.SetItemsProcessed(static_cast<std::int64_t>(stte.iterations() * corpus.size()));
+}
+
+
+static void large_document_dom_parse(benchmark::State& stte)
+{
+    auto doc = make_large_document(make_corpus());
+
+    for (auto _ : stte)
+    {
+        benchmark::DoNotOptimize(json::parse(doc.data(), doc.data() + doc.size(), nullptr, false));
+    }
+
+    stte.SetBytesProcessed(static_cast<std::int64_t>(stte.iterations() * doc.size()));
+}
+
+
+static void large_document_flat_parse(benchmark::State& stte)
+{
+    auto doc = make_large_document(make_corpus());
+    classifier::flat_json_parser flat_json_parsr(static_cast<classifier::simd_levels>(stte.range(0)));
+    classifier::category_list categories;
+
+    if (flat_json_parsr.get_simd_level() != static_cast<classifier::simd_levels>(stte.range(0)))
+    {
+        stte.SkipWithError("Instruction set not supported");
+        return;
+    }
+
+    for (auto _ : stte)
+    {
+        categories.clear();
+        benchmark::DoNotOptimize(flat_json_parsr.parse(doc, &categories));
+    }
+
+    stte.SetBytesProcessed(static_cast<std::int64_t>(stte.iterations() * doc.size()));
+}
+
+
+BENCHMARK(dom_parse)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(sax_parse)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(flat_parse)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(large_document_dom_parse)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(large_document_flat_parse)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,139 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_benchmark/file_id_set_benchmark.cpp
+ * @brief       file_id_set benchmark.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "classifier/file_id_set.hpp"
+
+
+namespace {
+
+
+/** The number of lookups done per iteration, half of them hits and half of them misses. */
+constexpr std::size_t LOOKUPS_NBR = 1 << 20;
+
+
+/**
+ * Inode numbers of a destination directory: increasing with small gaps, spread over two devices.
+ */
+std::vector<classifier::file_id> make_file_ids(std::size_t ids_nbr, std::uint64_t seed)
+{
+    std::vector<classifier::file_id> ids;
+    std::mt19937_64 rnd(seed);
+    std::uint64_t ino = 1000;
+
+    ids.reserve(ids_nbr);
+    for (std::size_t i = 0; i < ids_nbr; ++i)
+    {
+        ino += 1 + rnd() % 4;
+        ids.push_back({2049 + (i & 1), ino});
+    }
+
+    return ids;
+}
+
+
+std::vector<classifier::file_id> make_lookups(const std::vector<classifier::file_id>& ids)
+{
+    std::vector<classifier::file_id> lookps;
+    std::mt19937_64 rnd(7);
+
+    lookps.reserve(LOOKUPS_NBR);
+    for (std::size_t i = 0; i < LOOKUPS_NBR; ++i)
+    {
+        classifier::file_id id = ids[rnd() % ids.size()];
+        if (i & 1)
+        {
+            id.ino += 1ULL << 40;
+        }
+
+        lookps.push_back(id);
+    }
+
+    return lookps;
+}
+
+
+}
+
+
+static void file_id_set_contains(benchmark::State& stte)
+{
+    auto ids = make_file_ids(static_cast<std::size_t>(stte.range(0)), 1);
+    auto lookps = make_lookups(ids);
+    classifier::file_id_set id_st;
+
+    id_st.reserve(ids.size());
+    for (auto& x : ids)
+    {
+        id_st.insert(x);
+    }
+
+    for (auto _ : stte)
+    {
+        for (auto& x : lookps)
+        {
+            benchmark::DoNotOptimize(id_st.contains(x));
+        }
+    }
+
+    stte.SetItemsProcessed(static_cast<std::int64_t>(stte.iterations() * lookps.size()));
+}
+
+
+static void std_set_contains(benchmark::State& stte)
+{
+    auto ids = make_file_ids(static_cast<std::size_t>(stte.range(0)), 1);
+    auto lookps = make_lookups(ids);
+    std::set<std::uint64_t> ino_st;
+
+    for (auto& x : ids)
+    {
+        ino_st.insert(x.ino);
+    }
+
+    for (auto _ : stte)
+    {
+        for (auto& x : lookps)
+        {
+            benchmark::DoNotOptimize(ino_st.contains(x.ino));
+        }
+    }
+
+    stte.SetItemsProcessed(static_cast<std::int64_t>(stte.iterations() * lookps.size()));
+}
+
+
+BENCHMARK(file_id_set_contains)->Arg(100000)->Arg(1000000)->Arg(10000000)
+                               ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(std_set_contains)->Arg(100000)->Arg(1000000)->Arg(10000000)
+                           ->Unit(benchmark::kMillisecond);
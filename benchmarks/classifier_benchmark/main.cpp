@@ -0,0 +1,42 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_benchmark/main.cpp
+ * @brief       classifier_benchmark entry point.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <benchmark/benchmark.h>
+
+
+int main(int argc, char* argv[])
+{
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+
+    return 0;
+}
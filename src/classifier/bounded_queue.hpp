@@ -0,0 +1,246 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/bounded_queue.hpp
+ * @brief       bounded_queue class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_BOUNDED_QUEUE_HPP
+#define CLASSIFIER_BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Lock-free multi-producer multi-consumer queue with a fixed capacity (Dmitry
+ *              Vyukov's bounded queue). Every cell holds a sequence number that tells producers
+ *              and consumers whether it is free or filled for the current lap, so both ends only
+ *              compete through a single compare-and-swap. The blocking operations back off while
+ *              the queue is full or empty, which keeps the memory used by a pipeline bounded.
+ */
+template<typename T>
+class bounded_queue
+{
+public:
+    using value_type = T;
+
+    /**
+     * @brief       Constructor with parameters.
+     * @param       capacity : The minimum number of elements the queue can hold. It is rounded
+     *              up to the next power of two.
+     */
+    explicit bounded_queue(std::size_t capacity)
+            : cells_()
+            , mask_(0)
+            , enqueue_pos_(0)
+            , dequeue_pos_(0)
+            , closed_(false)
+    {
+        std::size_t cells_nbr = 2;
+
+        while (cells_nbr < capacity)
+        {
+            cells_nbr <<= 1;
+        }
+
+        cells_ = std::make_unique<cell[]>(cells_nbr);
+        mask_ = cells_nbr - 1;
+
+        for (std::size_t i = 0; i < cells_nbr; ++i)
+        {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bounded_queue(const bounded_queue& rhs) = delete;
+
+    bounded_queue& operator =(const bounded_queue& rhs) = delete;
+
+    /**
+     * @brief       Try to push an element without blocking.
+     * @param       val : The element to push.
+     * @return      If function was successful true is returned, otherwise false is returned
+     *              and the element is left untouched.
+     */
+    bool try_push(T&& val)
+    {
+        cell* cll;
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        std::size_t seq;
+        std::intptr_t diff;
+
+        for (;;)
+        {
+            cll = &cells_[pos & mask_];
+            seq = cll->seq.load(std::memory_order_acquire);
+            diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cll->val = std::move(val);
+        cll->seq.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * @brief       Try to pop an element without blocking.
+     * @param       val : The object in which the element will be moved.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool try_pop(T& val)
+    {
+        cell* cll;
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        std::size_t seq;
+        std::intptr_t diff;
+
+        for (;;)
+        {
+            cll = &cells_[pos & mask_];
+            seq = cll->seq.load(std::memory_order_acquire);
+            diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0)
+            {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        val = std::move(cll->val);
+        cll->seq.store(pos + mask_ + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * @brief       Push an element, waiting while the queue is full.
+     * @param       val : The element to push.
+     */
+    void push(T&& val)
+    {
+        for (std::size_t tries_nbr = 0; !try_push(std::move(val)); ++tries_nbr)
+        {
+            back_off(tries_nbr);
+        }
+    }
+
+    /**
+     * @brief       Pop an element, waiting while the queue is empty and has not been closed.
+     * @param       val : The object in which the element will be moved.
+     * @return      If an element has been popped true is returned, otherwise false is returned,
+     *              meaning that the queue has been closed and is empty.
+     */
+    bool pop(T& val)
+    {
+        for (std::size_t tries_nbr = 0; !try_pop(val); ++tries_nbr)
+        {
+            if (closed_.load(std::memory_order_acquire))
+            {
+                return try_pop(val);
+            }
+
+            back_off(tries_nbr);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief       Notify the consumers that no more elements will be pushed. It has to be called
+     *              once all the producers have finished.
+     */
+    void close() noexcept
+    {
+        closed_.store(true, std::memory_order_release);
+    }
+
+private:
+    struct cell
+    {
+        std::atomic<std::size_t> seq;
+        T val;
+    };
+
+    static void back_off(std::size_t tries_nbr)
+    {
+        if (tries_nbr < 64)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+private:
+    std::unique_ptr<cell[]> cells_;
+
+    std::size_t mask_;
+
+    alignas(64) std::atomic<std::size_t> enqueue_pos_;
+
+    alignas(64) std::atomic<std::size_t> dequeue_pos_;
+
+    alignas(64) std::atomic<bool> closed_;
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,370 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/catalog_reader.cpp
+ * @brief       catalog_reader class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "catalog_reader.hpp"
+#include "json.hpp"
+
+
+namespace classifier {
+
+
+namespace {
+
+
+inline bool is_whitespace(char ch) noexcept
+{
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
+
+
+std::size_t skip_whitespaces(std::string_view str, std::size_t pos) noexcept
+{
+    while (pos < str.size() && is_whitespace(str[pos]))
+    {
+        ++pos;
+    }
+
+    return pos;
+}
+
+
+}
+
+
+catalog_reader::catalog_reader(std::size_t buf_sz)
+        : buf_(std::make_unique_for_overwrite<char[]>(std::max<std::size_t>(buf_sz, 1)))
+        , buf_cap_(std::max<std::size_t>(buf_sz, 1))
+        , begn_(0)
+        , end_(0)
+        , lne_nbr_(0)
+#if defined(_WIN32)
+        , ifstr_()
+#else
+        , fd_(-1)
+#endif
+        , eof_(true)
+        , faild_(false)
+{
+}
+
+
+catalog_reader::~catalog_reader()
+{
+    close();
+}
+
+
+bool catalog_reader::open(const std::filesystem::path& catalog_pth)
+{
+    close();
+
+#if defined(_WIN32)
+    ifstr_.open(catalog_pth, std::ios::binary);
+    if (!ifstr_.is_open())
+    {
+        return false;
+    }
+#else
+    fd_ = ::open(catalog_pth.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0)
+    {
+        return false;
+    }
+
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    eof_ = false;
+
+    return true;
+}
+
+
+void catalog_reader::close() noexcept
+{
+#if defined(_WIN32)
+    if (ifstr_.is_open())
+    {
+        ifstr_.close();
+    }
+#else
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+        fd_ = -1;
+    }
+#endif
+
+    begn_ = 0;
+    end_ = 0;
+    lne_nbr_ = 0;
+    eof_ = true;
+    faild_ = false;
+}
+
+
+bool catalog_reader::read_line(std::string_view* lne)
+{
+    const char* newl;
+    std::size_t lne_end;
+
+    for (;;)
+    {
+        newl = static_cast<const char*>(std::memchr(buf_.get() + begn_, '\n', end_ - begn_));
+        if (newl != nullptr)
+        {
+            lne_end = static_cast<std::size_t>(newl - buf_.get());
+            break;
+        }
+
+        // The last line may not be terminated.
+        if (eof_)
+        {
+            if (begn_ == end_)
+            {
+                return false;
+            }
+
+            lne_end = end_;
+            break;
+        }
+
+        if (!fill_buffer())
+        {
+            return false;
+        }
+    }
+
+    *lne = std::string_view(buf_.get() + begn_, lne_end - begn_);
+    if (!lne->empty() && lne->back() == '\r')
+    {
+        lne->remove_suffix(1);
+    }
+
+    begn_ = std::min(lne_end + 1, end_);
+    ++lne_nbr_;
+
+    return true;
+}
+
+
+bool catalog_reader::parse_line(
+        std::string_view lne,
+        std::string* entry_pth,
+        std::string_view* categories_contnt
+)
+{
+    std::size_t pth_begn;
+    std::size_t pos = skip_whitespaces(lne, 0);
+    bool escaped = false;
+
+    if (pos >= lne.size() || lne[pos] != '[')
+    {
+        return false;
+    }
+
+    pos = skip_whitespaces(lne, pos + 1);
+    if (pos >= lne.size() || lne[pos] != '"')
+    {
+        return false;
+    }
+
+    pth_begn = pos++;
+    while (pos < lne.size() && lne[pos] != '"')
+    {
+        if (lne[pos] == '\\')
+        {
+            escaped = true;
+            ++pos;
+        }
+
+        ++pos;
+    }
+
+    if (pos >= lne.size())
+    {
+        return false;
+    }
+
+    // The escape sequences are rare in paths, they are left to the JSON library.
+    if (escaped)
+    {
+        json pth_json = json::parse(lne.substr(pth_begn, pos + 1 - pth_begn), nullptr, false);
+        if (!pth_json.is_string())
+        {
+            return false;
+        }
+
+        *entry_pth = pth_json.get_ref<const std::string&>();
+    }
+    else
+    {
+        entry_pth->assign(lne.substr(pth_begn + 1, pos - pth_begn - 1));
+    }
+
+    while (!entry_pth->empty() && entry_pth->back() == '/')
+    {
+        entry_pth->pop_back();
+    }
+
+    pos = skip_whitespaces(lne, pos + 1);
+    if (entry_pth->empty() || pos >= lne.size() || lne[pos] != ',')
+    {
+        return false;
+    }
+
+    *categories_contnt = lne.substr(skip_whitespaces(lne, pos + 1));
+    while (!categories_contnt->empty() && is_whitespace(categories_contnt->back()))
+    {
+        categories_contnt->remove_suffix(1);
+    }
+
+    if (categories_contnt->empty() || categories_contnt->back() != ']')
+    {
+        return false;
+    }
+
+    categories_contnt->remove_suffix(1);
+    while (!categories_contnt->empty() && is_whitespace(categories_contnt->back()))
+    {
+        categories_contnt->remove_suffix(1);
+    }
+
+    return !categories_contnt->empty();
+}
+
+
+bool catalog_reader::is_inner_entry_path(std::string_view entry_pth) noexcept
+{
+    std::size_t compnt_begn = 0;
+    std::size_t compnt_end;
+
+    if (entry_pth.empty() || entry_pth.front() == '/' || entry_pth.front() == '\\')
+    {
+        return false;
+    }
+
+#if defined(_WIN32)
+    // A drive letter makes the path absolute, or relative to the current directory of the drive.
+    if (entry_pth.size() >= 2 && entry_pth[1] == ':')
+    {
+        return false;
+    }
+#endif
+
+    // Both separators are checked on every system, so a catalog is refused the same way anywhere.
+    for (;;)
+    {
+        compnt_end = entry_pth.find_first_of("/\\", compnt_begn);
+        if (entry_pth.substr(compnt_begn, compnt_end - compnt_begn) == "..")
+        {
+            return false;
+        }
+
+        if (compnt_end == std::string_view::npos)
+        {
+            return true;
+        }
+
+        compnt_begn = compnt_end + 1;
+    }
+}
+
+
+bool catalog_reader::is_blank_line(std::string_view lne) noexcept
+{
+    return skip_whitespaces(lne, 0) == lne.size();
+}
+
+
+bool catalog_reader::fill_buffer()
+{
+    std::unique_ptr<char[]> new_buf;
+    std::size_t unread_sz = end_ - begn_;
+
+    if (unread_sz == buf_cap_)
+    {
+        new_buf = std::make_unique_for_overwrite<char[]>(buf_cap_ * 2);
+        std::copy(buf_.get(), buf_.get() + unread_sz, new_buf.get());
+        buf_ = std::move(new_buf);
+        buf_cap_ *= 2;
+    }
+    else if (begn_ > 0)
+    {
+        std::memmove(buf_.get(), buf_.get() + begn_, unread_sz);
+    }
+
+    begn_ = 0;
+    end_ = unread_sz;
+
+#if defined(_WIN32)
+    ifstr_.read(buf_.get() + end_, static_cast<std::streamsize>(buf_cap_ - end_));
+    end_ += static_cast<std::size_t>(ifstr_.gcount());
+
+    if (ifstr_.bad())
+    {
+        faild_ = true;
+        return false;
+    }
+
+    eof_ = ifstr_.eof();
+
+#else
+    ssize_t red_sz;
+
+    for (;;)
+    {
+        red_sz = ::read(fd_, buf_.get() + end_, buf_cap_ - end_);
+        if (red_sz >= 0)
+        {
+            break;
+        }
+
+        if (errno != EINTR)
+        {
+            faild_ = true;
+            return false;
+        }
+    }
+
+    end_ += static_cast<std::size_t>(red_sz);
+    eof_ = red_sz == 0;
+#endif
+
+    return true;
+}
+
+
+}
@@ -0,0 +1,176 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/catalog_reader.hpp
+ * @brief       catalog_reader class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_CATALOG_READER_HPP
+#define CLASSIFIER_CATALOG_READER_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#if defined(_WIN32)
+#include <fstream>
+#endif
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Streaming reader of a catalog, a JSON Lines file that gives the categories of many
+ *              entries at once. Every line is an array holding the entry path, relative to the
+ *              source directory, and the categories object of the entry:
+ *              ["Index/Kimi ni Todoke", {"Genres": ["Drama", "Shoujo"], "Mark": 9}]
+ *              The file is read sequentially in large chunks, so only the lines being handed out
+ *              are held in memory.
+ */
+class catalog_reader
+{
+public:
+    /** The initial size of the buffer, it only grows for the lines that do not fit in it. */
+    static constexpr std::size_t BUFFER_SIZE = 1024 * 1024;
+
+    /**
+     * @brief       Constructor with parameters.
+     * @param       buf_sz : The initial size of the buffer.
+     */
+    explicit catalog_reader(std::size_t buf_sz = BUFFER_SIZE);
+
+    catalog_reader(const catalog_reader& rhs) = delete;
+
+    /**
+     * @brief       Destructor.
+     */
+    ~catalog_reader();
+
+    catalog_reader& operator =(const catalog_reader& rhs) = delete;
+
+    /**
+     * @brief       Open a catalog, closing the previous one.
+     * @param       catalog_pth : The path of the catalog.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool open(const std::filesystem::path& catalog_pth);
+
+    /**
+     * @brief       Close the catalog.
+     */
+    void close() noexcept;
+
+    /**
+     * @brief       Read the next line of the catalog, without its line terminator.
+     * @param       lne : The object in which the line will be stored. It stays valid until the
+     *              next read.
+     * @return      If a line has been read true is returned, otherwise false is returned at the end
+     *              of the catalog or on a read error.
+     */
+    bool read_line(std::string_view* lne);
+
+    /**
+     * @brief       Get the number of the last line read, starting at one.
+     * @return      The number of the last line read.
+     */
+    [[nodiscard]] std::size_t get_line_number() const noexcept
+    {
+        return lne_nbr_;
+    }
+
+    /**
+     * @brief       Get whether the reading stopped because of a read error.
+     * @return      The value that represents if the reading failed.
+     */
+    [[nodiscard]] bool has_failed() const noexcept
+    {
+        return faild_;
+    }
+
+    /**
+     * @brief       Split a catalog line into the entry path and the categories object. The object
+     *              is only delimited here, it is validated when it is parsed.
+     * @param       lne : The line to split.
+     * @param       entry_pth : The object in which the entry path will be stored.
+     * @param       categories_contnt : The object in which the categories object will be stored.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    static bool parse_line(
+            std::string_view lne,
+            std::string* entry_pth,
+            std::string_view* categories_contnt
+    );
+
+    /**
+     * @brief       Get whether an entry path stays inside the source directory, that is whether it
+     *              is relative and none of its components is "..".
+     * @param       entry_pth : The entry path to check.
+     * @return      The value that represents if the entry path is inside the source directory.
+     */
+    static bool is_inner_entry_path(std::string_view entry_pth) noexcept;
+
+    /**
+     * @brief       Get whether a line holds only whitespaces, such lines are ignored.
+     * @param       lne : The line to check.
+     * @return      The value that represents if the line is blank.
+     */
+    static bool is_blank_line(std::string_view lne) noexcept;
+
+private:
+    /**
+     * @brief       Move the unread data to the front of the buffer, growing it if it is full, and
+     *              read the next chunk after it.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool fill_buffer();
+
+    std::unique_ptr<char[]> buf_;
+
+    std::size_t buf_cap_;
+
+    /** The position of the first byte not handed out yet. */
+    std::size_t begn_;
+
+    /** The position past the last byte read. */
+    std::size_t end_;
+
+    std::size_t lne_nbr_;
+
+#if defined(_WIN32)
+    std::ifstream ifstr_;
+#else
+    int fd_;
+#endif
+
+    bool eof_;
+
+    bool faild_;
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,431 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/categories_cache.cpp
+ * @brief       categories_cache class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <cstring>
+#include <fstream>
+
+#include "categories_cache.hpp"
+
+
+namespace classifier {
+
+
+namespace {
+
+
+constexpr char CACHE_MAGIC[8] = {'C', 'L', 'S', 'C', 'A', 'C', 'H', 'E'};
+
+constexpr std::uint32_t CACHE_VERSION = 1;
+
+/** The size of the signature and of the content hash that follow the path of a record. */
+constexpr std::size_t RECORD_HEADER_SIZE = sizeof(std::int64_t) + 3 * sizeof(std::uint64_t);
+
+
+template<typename T>
+void append_value(std::string& buf, const T& val)
+{
+    buf.append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+
+template<typename T>
+bool read_value(std::string_view contnt, std::size_t* offst, T* val)
+{
+    if (contnt.size() - *offst < sizeof(T))
+    {
+        return false;
+    }
+
+    std::memcpy(val, contnt.data() + *offst, sizeof(T));
+    *offst += sizeof(T);
+
+    return true;
+}
+
+
+void append_path(std::string& buf, const categories_cache::string_type& pth)
+{
+    append_value(buf, static_cast<std::uint32_t>(pth.size()));
+    buf.append(reinterpret_cast<const char*>(pth.data()),
+               pth.size() * sizeof(categories_cache::string_type::value_type));
+}
+
+
+void append_signature(std::string& buf, const file_signature& sig)
+{
+    append_value(buf, sig.mtime_ns);
+    append_value(buf, sig.sz);
+    append_value(buf, sig.ino);
+}
+
+
+}
+
+
+bool categories_cache::load(const std::filesystem::path& cache_file_pth)
+{
+    std::string_view contnt;
+    std::size_t offst = 0;
+    char magic[sizeof(CACHE_MAGIC)];
+    std::uint32_t versn;
+    std::uint32_t char_sz;
+    std::uint64_t recrds_nbr;
+    std::uint32_t pth_len;
+    std::size_t pth_sz;
+    std::uint64_t content_hsh;
+    std::uint32_t list_sz;
+    std::size_t sig_offst;
+
+    clear();
+
+    // The hint makes large caches memory mapped right away.
+    if (!readr_.read(cache_file_pth, file_reader::MMAP_THRESHOLD))
+    {
+        return false;
+    }
+
+    contnt = readr_.get_content();
+    if (contnt.size() < sizeof(magic) ||
+        std::memcmp(contnt.data(), CACHE_MAGIC, sizeof(magic)) != 0)
+    {
+        goto error;
+    }
+
+    offst = sizeof(magic);
+    if (!read_value(contnt, &offst, &versn) || versn != CACHE_VERSION ||
+        !read_value(contnt, &offst, &char_sz) || char_sz != sizeof(string_type::value_type) ||
+        !read_value(contnt, &offst, &recrds_nbr))
+    {
+        goto error;
+    }
+
+    // Only the paths are copied, the category lists are read from the mapping when needed.
+    offsts_.reserve(recrds_nbr);
+    contnt_offsts_.reserve(recrds_nbr);
+    for (std::uint64_t i = 0; i < recrds_nbr; ++i)
+    {
+        string_type pth;
+
+        if (!read_value(contnt, &offst, &pth_len))
+        {
+            goto error;
+        }
+
+        pth_sz = pth_len * sizeof(string_type::value_type);
+        if (contnt.size() - offst < pth_sz + RECORD_HEADER_SIZE)
+        {
+            goto error;
+        }
+
+        pth.resize(pth_len);
+        std::memcpy(pth.data(), contnt.data() + offst, pth_sz);
+        sig_offst = offst + pth_sz;
+        offst = sig_offst + RECORD_HEADER_SIZE - sizeof(content_hsh);
+
+        if (!read_value(contnt, &offst, &content_hsh) ||
+            !read_value(contnt, &offst, &list_sz) ||
+            contnt.size() - offst < list_sz)
+        {
+            goto error;
+        }
+
+        // A record appended replaces the previous record of the same file.
+        offsts_.insert_or_assign(std::move(pth), sig_offst);
+        contnt_offsts_.emplace(content_hsh, offst - sizeof(list_sz));
+        offst += list_sz;
+    }
+
+    return true;
+
+error:
+    clear();
+    return false;
+}
+
+
+bool categories_cache::find(
+        const string_type& categories_file_pth,
+        const file_signature& categories_file_sig,
+        std::uint64_t* content_hsh,
+        category_list* categories
+) const
+{
+    std::string_view contnt = readr_.get_content();
+    file_signature sig;
+    std::size_t offst;
+
+    auto it = offsts_.find(categories_file_pth);
+    if (it == offsts_.end())
+    {
+        return false;
+    }
+
+    offst = it->second;
+    read_value(contnt, &offst, &sig.mtime_ns);
+    read_value(contnt, &offst, &sig.sz);
+    read_value(contnt, &offst, &sig.ino);
+    read_value(contnt, &offst, content_hsh);
+
+    return sig == categories_file_sig && read_categories(offst, categories);
+}
+
+
+bool categories_cache::find(std::uint64_t content_hsh, category_list* categories) const
+{
+    auto it = contnt_offsts_.find(content_hsh);
+
+    return it != contnt_offsts_.end() && read_categories(it->second, categories);
+}
+
+
+void categories_cache::add(
+        const string_type& categories_file_pth,
+        const file_signature& categories_file_sig,
+        std::uint64_t content_hsh,
+        const category_list& categories
+)
+{
+    std::size_t list_sz_offst;
+    std::string_view txt;
+
+    append_path(next_recrds_, categories_file_pth);
+    append_signature(next_recrds_, categories_file_sig);
+    append_value(next_recrds_, content_hsh);
+
+    list_sz_offst = next_recrds_.size();
+    append_value(next_recrds_, std::uint32_t(0));
+    append_value(next_recrds_, static_cast<std::uint32_t>(categories.get_tokens().size()));
+
+    for (auto& x : categories.get_tokens())
+    {
+        txt = categories.get_text(x);
+        append_value(next_recrds_, static_cast<std::uint8_t>(x.tokn_type));
+        append_value(next_recrds_, static_cast<std::uint32_t>(txt.size()));
+        next_recrds_.append(txt);
+    }
+
+    auto list_sz = static_cast<std::uint32_t>(next_recrds_.size() - list_sz_offst -
+                                              sizeof(std::uint32_t));
+    std::memcpy(next_recrds_.data() + list_sz_offst, &list_sz, sizeof(list_sz));
+    ++next_recrds_nbr_;
+}
+
+
+bool categories_cache::keep(
+        const string_type& categories_file_pth,
+        const file_signature& categories_file_sig
+)
+{
+    std::string_view contnt = readr_.get_content();
+    std::uint32_t list_sz = 0;
+    std::size_t offst;
+
+    auto it = offsts_.find(categories_file_pth);
+    if (it == offsts_.end())
+    {
+        return false;
+    }
+
+    // The content hash and the category list are copied as they are.
+    offst = it->second + RECORD_HEADER_SIZE;
+    read_value(contnt, &offst, &list_sz);
+
+    append_path(next_recrds_, categories_file_pth);
+    append_signature(next_recrds_, categories_file_sig);
+    next_recrds_.append(contnt.substr(it->second + RECORD_HEADER_SIZE - sizeof(std::uint64_t),
+                                      sizeof(std::uint64_t) + sizeof(list_sz) + list_sz));
+    ++next_recrds_nbr_;
+
+    return true;
+}
+
+
+bool categories_cache::save(const std::filesystem::path& cache_file_pth)
+{
+    std::filesystem::path tmp_pth = cache_file_pth;
+    std::ofstream ofstr;
+    std::error_code err_code;
+    std::string hedr;
+
+    tmp_pth += ".tmp";
+
+    hedr.append(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    append_value(hedr, CACHE_VERSION);
+    append_value(hedr, static_cast<std::uint32_t>(sizeof(string_type::value_type)));
+    append_value(hedr, next_recrds_nbr_);
+
+    ofstr.open(tmp_pth, std::ios::binary | std::ios::trunc);
+    if (!ofstr.is_open())
+    {
+        return false;
+    }
+
+    ofstr.write(hedr.data(), static_cast<std::streamsize>(hedr.size()));
+    ofstr.write(next_recrds_.data(), static_cast<std::streamsize>(next_recrds_.size()));
+    ofstr.close();
+    if (!ofstr)
+    {
+        std::filesystem::remove(tmp_pth, err_code);
+        return false;
+    }
+
+    std::filesystem::rename(tmp_pth, cache_file_pth, err_code);
+    if (err_code)
+    {
+        return false;
+    }
+
+    saved_recrds_nbr_ = next_recrds_nbr_;
+    saved_sz_ = hedr.size() + next_recrds_.size();
+    appended_sz_ = 0;
+    next_recrds_.clear();
+    next_recrds_nbr_ = 0;
+
+    return true;
+}
+
+
+bool categories_cache::append(const std::filesystem::path& cache_file_pth)
+{
+    std::fstream fstr;
+    std::uint64_t recrds_nbr = saved_recrds_nbr_ + next_recrds_nbr_;
+    std::string_view contnt;
+    file_signature sig;
+    std::size_t offst;
+
+    if (saved_sz_ == 0)
+    {
+        return save(cache_file_pth);
+    }
+
+    if (next_recrds_nbr_ == 0)
+    {
+        return true;
+    }
+
+    // The records are written before their number, a record written without it is ignored.
+    fstr.open(cache_file_pth, std::ios::binary | std::ios::in | std::ios::out);
+    if (!fstr.is_open())
+    {
+        return false;
+    }
+
+    fstr.seekp(0, std::ios::end);
+    fstr.write(next_recrds_.data(), static_cast<std::streamsize>(next_recrds_.size()));
+    fstr.seekp(sizeof(CACHE_MAGIC) + sizeof(CACHE_VERSION) + sizeof(std::uint32_t));
+    fstr.write(reinterpret_cast<const char*>(&recrds_nbr), sizeof(recrds_nbr));
+    fstr.close();
+    if (!fstr)
+    {
+        saved_sz_ = 0;
+        return false;
+    }
+
+    saved_recrds_nbr_ = recrds_nbr;
+    appended_sz_ += next_recrds_.size();
+    next_recrds_.clear();
+    next_recrds_nbr_ = 0;
+
+    if (appended_sz_ <= saved_sz_)
+    {
+        return true;
+    }
+
+    if (!load(cache_file_pth))
+    {
+        return false;
+    }
+
+    contnt = readr_.get_content();
+    for (auto& x : offsts_)
+    {
+        offst = x.second;
+        read_value(contnt, &offst, &sig.mtime_ns);
+        read_value(contnt, &offst, &sig.sz);
+        read_value(contnt, &offst, &sig.ino);
+        keep(x.first, sig);
+    }
+
+    return save(cache_file_pth);
+}
+
+
+void categories_cache::clear() noexcept
+{
+    offsts_.clear();
+    contnt_offsts_.clear();
+    next_recrds_.clear();
+    next_recrds_nbr_ = 0;
+    saved_recrds_nbr_ = 0;
+    saved_sz_ = 0;
+    appended_sz_ = 0;
+}
+
+
+bool categories_cache::read_categories(std::size_t offst, category_list* categories) const
+{
+    std::string_view contnt = readr_.get_content();
+    std::uint32_t list_sz;
+    std::uint32_t tokns_nbr;
+    std::uint8_t tokn_type;
+    std::uint32_t txt_len;
+
+    categories->clear();
+
+    if (!read_value(contnt, &offst, &list_sz))
+    {
+        return false;
+    }
+
+    contnt = contnt.substr(0, offst + list_sz);
+    if (!read_value(contnt, &offst, &tokns_nbr) || tokns_nbr > list_sz)
+    {
+        return false;
+    }
+
+    // The texts are shorter than the record, a list that was not recycled grows only once.
+    categories->reserve(tokns_nbr, list_sz);
+
+    for (std::uint32_t i = 0; i < tokns_nbr; ++i)
+    {
+        if (!read_value(contnt, &offst, &tokn_type) ||
+            tokn_type > static_cast<std::uint8_t>(category_token_types::INVALID) ||
+            !read_value(contnt, &offst, &txt_len) || contnt.size() - offst < txt_len)
+        {
+            categories->clear();
+            return false;
+        }
+
+        categories->add_token(static_cast<category_token_types>(tokn_type),
+                              contnt.substr(offst, txt_len));
+        offst += txt_len;
+    }
+
+    return true;
+}
+
+
+}
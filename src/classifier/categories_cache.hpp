@@ -0,0 +1,188 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/categories_cache.hpp
+ * @brief       categories_cache class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_CATEGORIES_CACHE_HPP
+#define CLASSIFIER_CATEGORIES_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+#include "category_list.hpp"
+#include "file_reader.hpp"
+#include "state_file.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Compiled form of the categories files, kept in the destination directory so that the
+ *              files that have already been parsed once are never parsed again, even when the state
+ *              is ignored. Every categories file is stored with its signature, the hash of its
+ *              content and its category list in binary form. The previous cache is memory mapped
+ *              and only indexed when loaded, while the next cache is built in memory and saved at
+ *              the end of the run. Once saved, the records added later can be appended to the file
+ *              instead, a record appended replacing the one of the same file.
+ */
+class categories_cache
+{
+public:
+    using string_type = std::filesystem::path::string_type;
+
+    /** The name of the cache file inside the destination directory. */
+    static constexpr const char* FILE_NAME = ".classifier.cache";
+
+    /**
+     * @brief       Default constructor.
+     */
+    categories_cache() = default;
+
+    categories_cache(const categories_cache& rhs) = delete;
+
+    categories_cache& operator =(const categories_cache& rhs) = delete;
+
+    /**
+     * @brief       Load a cache file as the previous cache, replacing the current one.
+     * @param       cache_file_pth : The path of the cache file.
+     * @return      If function was successful true is returned, otherwise false is returned and
+     *              the previous cache is left empty.
+     */
+    bool load(const std::filesystem::path& cache_file_pth);
+
+    /**
+     * @brief       Find in the previous cache the category list of a categories file that has not
+     *              changed. This method can be called concurrently.
+     * @param       categories_file_pth : The path of the categories file.
+     * @param       categories_file_sig : The current signature of the categories file.
+     * @param       content_hsh : The object in which the hash of the content will be stored.
+     * @param       categories : The object in which the category list will be stored.
+     * @return      If the file is in the cache with the same signature true is returned, otherwise
+     *              false is returned.
+     */
+    bool find(
+            const string_type& categories_file_pth,
+            const file_signature& categories_file_sig,
+            std::uint64_t* content_hsh,
+            category_list* categories
+    ) const;
+
+    /**
+     * @brief       Find in the previous cache the category list of a content, whatever the file it
+     *              came from. This method can be called concurrently.
+     * @param       content_hsh : The hash of the content.
+     * @param       categories : The object in which the category list will be stored.
+     * @return      If a content with the same hash is in the cache true is returned, otherwise
+     *              false is returned.
+     */
+    bool find(std::uint64_t content_hsh, category_list* categories) const;
+
+    /**
+     * @brief       Add a categories file to the next cache.
+     * @param       categories_file_pth : The path of the categories file.
+     * @param       categories_file_sig : The signature of the categories file.
+     * @param       content_hsh : The hash of the content of the categories file.
+     * @param       categories : The category list of the categories file.
+     */
+    void add(
+            const string_type& categories_file_pth,
+            const file_signature& categories_file_sig,
+            std::uint64_t content_hsh,
+            const category_list& categories
+    );
+
+    /**
+     * @brief       Carry a categories file over from the previous cache to the next cache.
+     * @param       categories_file_pth : The path of the categories file.
+     * @param       categories_file_sig : The current signature of the categories file.
+     * @return      If the file was in the previous cache true is returned, otherwise false is
+     *              returned.
+     */
+    bool keep(const string_type& categories_file_pth, const file_signature& categories_file_sig);
+
+    /**
+     * @brief       Save the next cache. The file is first written under a temporary name and then
+     *              renamed, since the previous cache may still be mapped. The records saved are
+     *              then dropped from the next cache.
+     * @param       cache_file_pth : The path of the cache file.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool save(const std::filesystem::path& cache_file_pth);
+
+    /**
+     * @brief       Append the records added since the last save to the cache file saved, which is
+     *              saved in full if it has not been yet or if an append failed. Once the records
+     *              appended outgrow the ones saved, the file is loaded and saved again with the
+     *              last record of every file only.
+     * @param       cache_file_pth : The path of the cache file.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool append(const std::filesystem::path& cache_file_pth);
+
+    /**
+     * @brief       Remove the previous and the next caches, the next save is done in full.
+     */
+    void clear() noexcept;
+
+private:
+    /**
+     * @brief       Read a category list stored in the previous cache.
+     * @param       offst : The position of the category list in the previous cache.
+     * @param       categories : The object in which the category list will be stored.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool read_categories(std::size_t offst, category_list* categories) const;
+
+    /** The reader holding the previous cache. */
+    file_reader readr_;
+
+    /** The position of the signature of every file of the previous cache. */
+    std::unordered_map<string_type, std::size_t> offsts_;
+
+    /** The position of the category list of every content of the previous cache. */
+    std::unordered_map<std::uint64_t, std::size_t> contnt_offsts_;
+
+    /** The records of the next cache. */
+    std::string next_recrds_;
+
+    std::uint64_t next_recrds_nbr_ = 0;
+
+    /** The number of records in the cache file saved, including the ones appended. */
+    std::uint64_t saved_recrds_nbr_ = 0;
+
+    /** The size of the cache file when it was saved in full, zero until then. */
+    std::uint64_t saved_sz_ = 0;
+
+    /** The size of the records appended since. */
+    std::uint64_t appended_sz_ = 0;
+};
+
+
+}
+
+
+#endif
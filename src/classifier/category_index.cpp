@@ -0,0 +1,447 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier/category_index.cpp
+ * @brief       category_index class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "category_index.hpp"
+#include "file_reader.hpp"
+
+
+namespace classifier {
+
+
+namespace {
+
+
+template<typename T>
+void append_value(std::string& buf, const T& val)
+{
+    buf.append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+
+template<typename T>
+bool read_value(std::string_view contnt, std::size_t* offst, T* val)
+{
+    if (contnt.size() - *offst < sizeof(T))
+    {
+        return false;
+    }
+
+    std::memcpy(val, contnt.data() + *offst, sizeof(T));
+    *offst += sizeof(T);
+
+    return true;
+}
+
+
+template<typename T>
+void append_vector(std::string& buf, const std::vector<T>& vals)
+{
+    buf.append(reinterpret_cast<const char*>(vals.data()), vals.size() * sizeof(T));
+}
+
+
+void append_string(std::string& buf, std::string_view str)
+{
+    append_value(buf, static_cast<std::uint32_t>(str.size()));
+    buf.append(str);
+}
+
+
+bool read_string(std::string_view contnt, std::size_t* offst, std::string_view* str)
+{
+    std::uint32_t str_len;
+
+    if (!read_value(contnt, offst, &str_len) || contnt.size() - *offst < str_len)
+    {
+        return false;
+    }
+
+    *str = contnt.substr(*offst, str_len);
+    *offst += str_len;
+
+    return true;
+}
+
+
+}
+
+
+std::uint32_t category_index::add_category(std::uint32_t key_ctgry_id, std::string_view nme)
+{
+    std::uint32_t nme_id = nmes_.intern(nme);
+
+    auto [it, insertd] = ctgry_ids_.try_emplace(get_category_key(key_ctgry_id, nme_id),
+                                                static_cast<std::uint32_t>(ctgries_.size()));
+    if (insertd)
+    {
+        ctgries_.push_back({key_ctgry_id, nme_id, {}});
+    }
+
+    return it->second;
+}
+
+
+std::uint32_t category_index::find_category(std::uint32_t key_ctgry_id, std::string_view nme) const
+{
+    std::uint32_t nme_id = nmes_.find(nme);
+
+    if (nme_id == string_interner::NPOS)
+    {
+        return NPOS;
+    }
+
+    auto it = ctgry_ids_.find(get_category_key(key_ctgry_id, nme_id));
+
+    return it != ctgry_ids_.end() ? it->second : NPOS;
+}
+
+
+std::uint32_t category_index::add_entry(
+        std::string_view entry_pth,
+        std::span<const std::uint32_t> ctgry_ids
+)
+{
+    std::uint32_t entry_id = entry_pths_.intern(entry_pth);
+    std::size_t first_ctgry_idx = entry_ctgry_ids_.size();
+
+    if (entry_id < entry_ctgry_rngs_.size())
+    {
+        return entry_id;
+    }
+
+    // The same category given twice, through a duplicated value, is only kept once.
+    entry_ctgry_ids_.insert(entry_ctgry_ids_.end(), ctgry_ids.begin(), ctgry_ids.end());
+    std::sort(entry_ctgry_ids_.begin() + first_ctgry_idx, entry_ctgry_ids_.end());
+    entry_ctgry_ids_.erase(std::unique(entry_ctgry_ids_.begin() + first_ctgry_idx,
+                                       entry_ctgry_ids_.end()),
+                           entry_ctgry_ids_.end());
+
+    for (std::size_t i = first_ctgry_idx; i < entry_ctgry_ids_.size(); ++i)
+    {
+        ctgries_[entry_ctgry_ids_[i]].entries.add(entry_id);
+    }
+
+    entry_ctgry_rngs_.push_back({static_cast<std::uint32_t>(first_ctgry_idx),
+                                 static_cast<std::uint32_t>(entry_ctgry_ids_.size() -
+                                                            first_ctgry_idx)});
+
+    return entry_id;
+}
+
+
+bool category_index::remove_entry(std::string_view entry_pth)
+{
+    std::uint32_t entry_id = entry_pths_.find(entry_pth);
+    auto last_entry_id = static_cast<std::uint32_t>(entry_ctgry_rngs_.size() - 1);
+
+    if (entry_id == string_interner::NPOS)
+    {
+        return false;
+    }
+
+    for (auto& x : get_entry_categories(entry_id))
+    {
+        ctgries_[x].entries.remove(entry_id);
+    }
+
+    if (entry_id != last_entry_id)
+    {
+        for (auto& x : get_entry_categories(last_entry_id))
+        {
+            ctgries_[x].entries.remove(last_entry_id);
+            ctgries_[x].entries.add(entry_id);
+        }
+
+        entry_ctgry_rngs_[entry_id] = entry_ctgry_rngs_[last_entry_id];
+    }
+
+    entry_ctgry_rngs_.pop_back();
+    entry_pths_.remove(entry_id);
+
+    // The paths and the categories of the removed entries are dropped once they outnumber the
+    // entries left.
+    if (++removed_entries_nbr_ > entry_ctgry_rngs_.size())
+    {
+        compact_entries();
+    }
+
+    return true;
+}
+
+
+std::uint32_t category_index::find_entry(std::string_view entry_pth) const
+{
+    std::uint32_t entry_id = entry_pths_.find(entry_pth);
+
+    return entry_id != string_interner::NPOS ? entry_id : NPOS;
+}
+
+
+bool category_index::load(const std::filesystem::path& index_file_pth)
+{
+    file_reader readr;
+    std::string_view contnt;
+    std::size_t offst = 0;
+    std::uint32_t versn;
+    std::uint32_t nmes_nbr;
+    std::uint32_t ctgries_nbr;
+    std::uint32_t entries_nbr;
+    std::uint32_t key_ctgry_id;
+    std::uint32_t nme_id;
+    std::uint32_t entry_ctgries_nbr;
+    std::uint32_t ctgry_id;
+    std::string_view str;
+
+    clear();
+
+    // The hint makes large indexes memory mapped right away.
+    if (!readr.read(index_file_pth, file_reader::MMAP_THRESHOLD))
+    {
+        return false;
+    }
+
+    contnt = readr.get_content();
+    if (contnt.size() < sizeof(FILE_MAGIC) ||
+        std::memcmp(contnt.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+    {
+        goto error;
+    }
+
+    offst = sizeof(FILE_MAGIC);
+    if (!read_value(contnt, &offst, &versn) || versn != FILE_VERSION ||
+        !read_value(contnt, &offst, &nmes_nbr))
+    {
+        goto error;
+    }
+
+    for (std::uint32_t i = 0; i < nmes_nbr; ++i)
+    {
+        if (!read_string(contnt, &offst, &str) || nmes_.intern(str) != i)
+        {
+            goto error;
+        }
+    }
+
+    if (!read_value(contnt, &offst, &ctgries_nbr))
+    {
+        goto error;
+    }
+
+    // A key is always added before its values.
+    ctgries_.reserve(ctgries_nbr);
+    ctgry_ids_.reserve(ctgries_nbr);
+    for (std::uint32_t i = 0; i < ctgries_nbr; ++i)
+    {
+        category ctgry;
+
+        if (!read_value(contnt, &offst, &key_ctgry_id) ||
+            (key_ctgry_id != NPOS && key_ctgry_id >= i) ||
+            !read_value(contnt, &offst, &nme_id) || nme_id >= nmes_nbr ||
+            !ctgry.entries.deserialize(contnt, &offst) ||
+            !ctgry_ids_.emplace(get_category_key(key_ctgry_id, nme_id), i).second)
+        {
+            goto error;
+        }
+
+        ctgry.key_ctgry_id = key_ctgry_id;
+        ctgry.nme_id = nme_id;
+        ctgries_.push_back(std::move(ctgry));
+    }
+
+    if (!read_value(contnt, &offst, &entries_nbr))
+    {
+        goto error;
+    }
+
+    entry_ctgry_rngs_.reserve(entries_nbr);
+    for (std::uint32_t i = 0; i < entries_nbr; ++i)
+    {
+        if (!read_string(contnt, &offst, &str) || entry_pths_.intern(str) != i ||
+            !read_value(contnt, &offst, &entry_ctgries_nbr))
+        {
+            goto error;
+        }
+
+        for (std::uint32_t j = 0; j < entry_ctgries_nbr; ++j)
+        {
+            if (!read_value(contnt, &offst, &ctgry_id) || ctgry_id >= ctgries_nbr)
+            {
+                goto error;
+            }
+
+            entry_ctgry_ids_.push_back(ctgry_id);
+        }
+
+        entry_ctgry_rngs_.push_back({static_cast<std::uint32_t>(entry_ctgry_ids_.size() -
+                                                                entry_ctgries_nbr),
+                                     entry_ctgries_nbr});
+    }
+
+    return true;
+
+error:
+    clear();
+    return false;
+}
+
+
+bool category_index::save(const std::filesystem::path& index_file_pth) const
+{
+    std::filesystem::path tmp_pth = index_file_pth;
+    std::ofstream ofstr;
+    std::error_code err_code;
+    std::string contnt;
+    std::span<const std::uint32_t> ctgry_ids;
+    std::vector<std::uint64_t> nme_offsts;
+    std::vector<std::uint64_t> ctgry_offsts;
+    std::vector<std::uint64_t> entry_offsts;
+    std::vector<std::uint32_t> sorted_ctgry_ids;
+    std::uint64_t footer_offst;
+
+    tmp_pth += ".tmp";
+
+    contnt.append(FILE_MAGIC, sizeof(FILE_MAGIC));
+    append_value(contnt, FILE_VERSION);
+
+    append_value(contnt, static_cast<std::uint32_t>(nmes_.size()));
+    nme_offsts.reserve(nmes_.size());
+    for (std::uint32_t i = 0; i < nmes_.size(); ++i)
+    {
+        nme_offsts.push_back(contnt.size());
+        append_string(contnt, nmes_.get_string(i));
+    }
+
+    append_value(contnt, static_cast<std::uint32_t>(ctgries_.size()));
+    ctgry_offsts.reserve(ctgries_.size());
+    for (auto& x : ctgries_)
+    {
+        ctgry_offsts.push_back(contnt.size());
+        append_value(contnt, x.key_ctgry_id);
+        append_value(contnt, x.nme_id);
+        x.entries.serialize(&contnt);
+    }
+
+    append_value(contnt, static_cast<std::uint32_t>(entry_pths_.size()));
+    entry_offsts.reserve(entry_pths_.size());
+    for (std::uint32_t i = 0; i < entry_pths_.size(); ++i)
+    {
+        ctgry_ids = get_entry_categories(i);
+
+        entry_offsts.push_back(contnt.size());
+        append_string(contnt, entry_pths_.get_string(i));
+        append_value(contnt, static_cast<std::uint32_t>(ctgry_ids.size()));
+        contnt.append(reinterpret_cast<const char*>(ctgry_ids.data()),
+                      ctgry_ids.size() * sizeof(std::uint32_t));
+    }
+
+    // The footer gives a random access to the records above, and the categories sorted by key and
+    // name for the lookups. Its offset closes the file.
+    sorted_ctgry_ids.resize(ctgries_.size());
+    for (std::uint32_t i = 0; i < ctgries_.size(); ++i)
+    {
+        sorted_ctgry_ids[i] = i;
+    }
+
+    std::sort(sorted_ctgry_ids.begin(), sorted_ctgry_ids.end(),
+              [&](std::uint32_t lhs, std::uint32_t rhs)
+    {
+        if (ctgries_[lhs].key_ctgry_id != ctgries_[rhs].key_ctgry_id)
+        {
+            return ctgries_[lhs].key_ctgry_id < ctgries_[rhs].key_ctgry_id;
+        }
+
+        return get_category_name(lhs) < get_category_name(rhs);
+    });
+
+    footer_offst = contnt.size();
+    append_value(contnt, static_cast<std::uint32_t>(nmes_.size()));
+    append_value(contnt, static_cast<std::uint32_t>(ctgries_.size()));
+    append_value(contnt, static_cast<std::uint32_t>(entry_pths_.size()));
+    append_vector(contnt, nme_offsts);
+    append_vector(contnt, ctgry_offsts);
+    append_vector(contnt, entry_offsts);
+    append_vector(contnt, sorted_ctgry_ids);
+    append_value(contnt, footer_offst);
+
+    ofstr.open(tmp_pth, std::ios::binary | std::ios::trunc);
+    if (!ofstr.is_open())
+    {
+        return false;
+    }
+
+    ofstr.write(contnt.data(), static_cast<std::streamsize>(contnt.size()));
+    ofstr.close();
+    if (!ofstr)
+    {
+        std::filesystem::remove(tmp_pth, err_code);
+        return false;
+    }
+
+    std::filesystem::rename(tmp_pth, index_file_pth, err_code);
+
+    return !err_code;
+}
+
+
+void category_index::clear() noexcept
+{
+    nmes_.clear();
+    ctgries_.clear();
+    ctgry_ids_.clear();
+    entry_pths_.clear();
+    entry_ctgry_rngs_.clear();
+    entry_ctgry_ids_.clear();
+    removed_entries_nbr_ = 0;
+}
+
+
+void category_index::compact_entries()
+{
+    string_interner entry_pths;
+    std::vector<std::uint32_t> entry_ctgry_ids;
+    std::span<const std::uint32_t> ctgry_ids;
+
+    for (std::uint32_t i = 0; i < entry_ctgry_rngs_.size(); ++i)
+    {
+        ctgry_ids = get_entry_categories(i);
+        entry_pths.intern(entry_pths_.get_string(i));
+        entry_ctgry_rngs_[i].offst = static_cast<std::uint32_t>(entry_ctgry_ids.size());
+        entry_ctgry_ids.insert(entry_ctgry_ids.end(), ctgry_ids.begin(), ctgry_ids.end());
+    }
+
+    entry_pths_ = std::move(entry_pths);
+    entry_ctgry_ids_ = std::move(entry_ctgry_ids);
+    removed_entries_nbr_ = 0;
+}
+
+
+}
@@ -0,0 +1,287 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier/category_index.hpp
+ * @brief       category_index class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_CATEGORY_INDEX_HPP
+#define CLASSIFIER_CATEGORY_INDEX_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "roaring_bitmap.hpp"
+#include "string_interner.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Index of the library as data. Every entry is identified by a dense integer and
+ *              every category, a key or a value of a key, holds the compressed bitmap of the
+ *              entries linked in its directory. Every entry also keeps the list of its categories,
+ *              so that an unchanged entry can be carried from the index of a previous run without
+ *              being parsed. The index is saved in the destination directory at the end of a run.
+ */
+class category_index
+{
+public:
+    /** The value returned when an entry or a category is not in the index. */
+    static constexpr std::uint32_t NPOS = static_cast<std::uint32_t>(-1);
+
+    /** The name of the index file inside the destination directory. */
+    static constexpr const char* FILE_NAME = ".classifier.index";
+
+    /** The bytes that open an index file. */
+    static constexpr char FILE_MAGIC[8] = {'C', 'L', 'S', 'I', 'N', 'D', 'E', 'X'};
+
+    /** The version of the format of the index file. */
+    static constexpr std::uint32_t FILE_VERSION = 2;
+
+    /**
+     * @brief       Default constructor.
+     */
+    category_index() = default;
+
+    category_index(const category_index& rhs) = delete;
+
+    /**
+     * @brief       Move constructor.
+     * @param       rhs : Object to move.
+     */
+    category_index(category_index&& rhs) noexcept = default;
+
+    category_index& operator =(const category_index& rhs) = delete;
+
+    /**
+     * @brief       Move assignment operator.
+     * @param       rhs : Object to move.
+     * @return      The object who call the method.
+     */
+    category_index& operator =(category_index&& rhs) noexcept = default;
+
+    /**
+     * @brief       Get the identifier of a category, adding the category if it is not in the index.
+     * @param       key_ctgry_id : The category of the key for a value, NPOS for a key.
+     * @param       nme : The name of the key or of the value.
+     * @return      The identifier of the category.
+     */
+    std::uint32_t add_category(std::uint32_t key_ctgry_id, std::string_view nme);
+
+    /**
+     * @brief       Get the identifier of a category without adding it.
+     * @param       key_ctgry_id : The category of the key for a value, NPOS for a key.
+     * @param       nme : The name of the key or of the value.
+     * @return      The identifier of the category if found, otherwise NPOS.
+     */
+    [[nodiscard]] std::uint32_t find_category(std::uint32_t key_ctgry_id,
+                                              std::string_view nme) const;
+
+    /**
+     * @brief       Add an entry with its categories. An entry already in the index is left as it
+     *              is.
+     * @param       entry_pth : The path of the entry directory.
+     * @param       ctgry_ids : The categories of the entry, they have to come from this index.
+     * @return      The identifier of the entry.
+     */
+    std::uint32_t add_entry(std::string_view entry_pth, std::span<const std::uint32_t> ctgry_ids);
+
+    /**
+     * @brief       Remove an entry. The last entry takes its identifier so that the identifiers
+     *              stay dense, and its categories are kept even once they have no entry left.
+     *              The views of the entry paths handed out before are invalidated.
+     * @param       entry_pth : The path of the entry directory.
+     * @return      If the entry has been found true is returned, otherwise false is returned.
+     */
+    bool remove_entry(std::string_view entry_pth);
+
+    /**
+     * @brief       Get the identifier of an entry. This method can be called concurrently.
+     * @param       entry_pth : The path of the entry directory.
+     * @return      The identifier of the entry if found, otherwise NPOS.
+     */
+    [[nodiscard]] std::uint32_t find_entry(std::string_view entry_pth) const;
+
+    /**
+     * @brief       Get the path of an entry.
+     * @param       entry_id : The identifier of the entry.
+     * @return      The path of the entry directory.
+     */
+    [[nodiscard]] std::string_view get_entry_path(std::uint32_t entry_id) const noexcept
+    {
+        return entry_pths_.get_string(entry_id);
+    }
+
+    /**
+     * @brief       Get the categories of an entry.
+     * @param       entry_id : The identifier of the entry.
+     * @return      The sorted identifiers of the categories of the entry.
+     */
+    [[nodiscard]] std::span<const std::uint32_t> get_entry_categories(
+            std::uint32_t entry_id
+    ) const noexcept
+    {
+        return std::span<const std::uint32_t>(entry_ctgry_ids_).subspan(
+                entry_ctgry_rngs_[entry_id].offst, entry_ctgry_rngs_[entry_id].nbr);
+    }
+
+    /**
+     * @brief       Get the category of the key of a category.
+     * @param       ctgry_id : The identifier of the category.
+     * @return      The identifier of the category of the key for a value, NPOS for a key.
+     */
+    [[nodiscard]] std::uint32_t get_key_category(std::uint32_t ctgry_id) const noexcept
+    {
+        return ctgries_[ctgry_id].key_ctgry_id;
+    }
+
+    /**
+     * @brief       Get the name of a category.
+     * @param       ctgry_id : The identifier of the category.
+     * @return      The name of the key or of the value.
+     */
+    [[nodiscard]] std::string_view get_category_name(std::uint32_t ctgry_id) const noexcept
+    {
+        return nmes_.get_string(ctgries_[ctgry_id].nme_id);
+    }
+
+    /**
+     * @brief       Get the entries of a category.
+     * @param       ctgry_id : The identifier of the category.
+     * @return      The identifiers of the entries linked in the directory of the category.
+     */
+    [[nodiscard]] const roaring_bitmap& get_category_entries(std::uint32_t ctgry_id) const noexcept
+    {
+        return ctgries_[ctgry_id].entries;
+    }
+
+    /**
+     * @brief       Get the number of entries.
+     * @return      The number of entries.
+     */
+    [[nodiscard]] std::size_t get_entries_number() const noexcept
+    {
+        return entry_pths_.size();
+    }
+
+    /**
+     * @brief       Get the number of categories.
+     * @return      The number of categories.
+     */
+    [[nodiscard]] std::size_t get_categories_number() const noexcept
+    {
+        return ctgries_.size();
+    }
+
+    /**
+     * @brief       Load an index file, replacing the current index.
+     * @param       index_file_pth : The path of the index file.
+     * @return      If function was successful true is returned, otherwise false is returned and
+     *              the index is left empty.
+     */
+    bool load(const std::filesystem::path& index_file_pth);
+
+    /**
+     * @brief       Save the index. The file is first written under a temporary name and then
+     *              renamed, so that an interrupted run leaves the previous index intact. The
+     *              file ends with the offsets of its names, categories and entries, and with the
+     *              categories sorted by key and name, which mapped_category_index uses to answer
+     *              queries without loading the file.
+     * @param       index_file_pth : The path of the index file.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool save(const std::filesystem::path& index_file_pth) const;
+
+    /**
+     * @brief       Remove all the entries and all the categories.
+     */
+    void clear() noexcept;
+
+private:
+    /**
+     * @brief       A key or a value of a key, with the entries linked in its directory.
+     */
+    struct category
+    {
+        std::uint32_t key_ctgry_id = NPOS;
+        std::uint32_t nme_id = 0;
+        roaring_bitmap entries;
+    };
+
+    /**
+     * @brief       The position and the number of the categories of an entry.
+     */
+    struct category_range
+    {
+        std::uint32_t offst = 0;
+        std::uint32_t nbr = 0;
+    };
+
+    /**
+     * @brief       Copy the paths and the categories of the entries without the ones left by the
+     *              removed entries.
+     */
+    void compact_entries();
+
+    [[nodiscard]] static std::uint64_t get_category_key(
+            std::uint32_t key_ctgry_id,
+            std::uint32_t nme_id
+    ) noexcept
+    {
+        return (static_cast<std::uint64_t>(key_ctgry_id + 1) << 32) | nme_id;
+    }
+
+private:
+    /** The names of the keys and of the values. */
+    string_interner nmes_;
+
+    std::vector<category> ctgries_;
+
+    /** The categories by the identifier of their key category plus one, zero for the keys, and
+     *  the identifier of their name. */
+    std::unordered_map<std::uint64_t, std::uint32_t> ctgry_ids_;
+
+    /** The paths of the entries, their identifiers being the identifiers of the entries. */
+    string_interner entry_pths_;
+
+    /** The categories of every entry. */
+    std::vector<category_range> entry_ctgry_rngs_;
+
+    /** The categories of all the entries, one after the other. */
+    std::vector<std::uint32_t> entry_ctgry_ids_;
+
+    /** The number of entries removed since the last compaction. */
+    std::size_t removed_entries_nbr_ = 0;
+};
+
+
+}
+
+
+#endif
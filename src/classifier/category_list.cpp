@@ -0,0 +1,233 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/category_list.cpp
+ * @brief       category_list class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <charconv>
+
+#include "category_list.hpp"
+#include "flat_json_parser.hpp"
+#include "json.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       The SAX handler that turns the events of the parser into tokens. The values nested
+ *              in an object are skipped once the object has been reported as invalid.
+ */
+class category_list::sax_handler
+{
+public:
+    using number_integer_t = json::number_integer_t;
+
+    using number_unsigned_t = json::number_unsigned_t;
+
+    using number_float_t = json::number_float_t;
+
+    using string_t = json::string_t;
+
+    using binary_t = json::binary_t;
+
+    explicit sax_handler(category_list* categories) noexcept
+            : categories_(categories)
+            , depth_(0)
+            , skipped_depth_(0)
+    {
+    }
+
+    bool null()
+    {
+        return add_value(category_token_types::INVALID);
+    }
+
+    bool boolean(bool val)
+    {
+        return add_value(val ? category_token_types::TRUE_VALUE : category_token_types::FALSE_VALUE);
+    }
+
+    bool number_integer(number_integer_t val)
+    {
+        return add_number(val);
+    }
+
+    bool number_unsigned(number_unsigned_t val)
+    {
+        return add_number(val);
+    }
+
+    bool number_float(number_float_t val, const string_t&)
+    {
+        // The name must be the one the document form gives, not the text of the file.
+        return add_value(category_token_types::NAME, json(val).dump());
+    }
+
+    bool string(string_t& val)
+    {
+        return add_value(category_token_types::NAME, val);
+    }
+
+    bool binary(binary_t&)
+    {
+        return add_value(category_token_types::INVALID);
+    }
+
+    bool start_object(std::size_t)
+    {
+        if (depth_ > 0 && skipped_depth_ == 0)
+        {
+            categories_->add_token(category_token_types::INVALID);
+            skipped_depth_ = depth_ + 1;
+        }
+
+        ++depth_;
+        return true;
+    }
+
+    bool key(string_t& val)
+    {
+        if (depth_ == 1)
+        {
+            categories_->add_token(category_token_types::KEY, val);
+        }
+
+        return true;
+    }
+
+    bool end_object()
+    {
+        if (depth_ == skipped_depth_)
+        {
+            skipped_depth_ = 0;
+        }
+
+        --depth_;
+        return true;
+    }
+
+    bool start_array(std::size_t)
+    {
+        if (depth_ == 0)
+        {
+            return false;
+        }
+
+        ++depth_;
+        return true;
+    }
+
+    bool end_array()
+    {
+        --depth_;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&)
+    {
+        return false;
+    }
+
+private:
+    template<typename NumberT>
+    bool add_number(NumberT val)
+    {
+        char buf[24];
+        auto [end, err] = std::to_chars(buf, buf + sizeof(buf), val);
+
+        return add_value(category_token_types::NAME, std::string_view(buf, end - buf));
+    }
+
+    bool add_value(category_token_types tokn_type, std::string_view txt = {})
+    {
+        // The document itself has to be an object.
+        if (depth_ == 0)
+        {
+            return false;
+        }
+
+        if (skipped_depth_ == 0)
+        {
+            categories_->add_token(tokn_type, txt);
+        }
+
+        return true;
+    }
+
+    category_list* categories_;
+
+    std::size_t depth_;
+
+    /** The depth of the object being skipped, 0 if none is. */
+    std::size_t skipped_depth_;
+};
+
+
+bool category_list::parse(std::string_view contnt)
+{
+    thread_local flat_json_parser flat_json_parsr;
+    sax_handler handlr(this);
+
+    clear();
+
+    if (flat_json_parsr.parse(contnt, this))
+    {
+        return true;
+    }
+
+    clear();
+
+    if (!json::sax_parse(contnt.data(), contnt.data() + contnt.size(), &handlr))
+    {
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+void category_list::reserve(std::size_t tokns_nbr, std::size_t txt_sz)
+{
+    tokns_.reserve(tokns_nbr);
+    txt_.reserve(txt_sz);
+}
+
+
+void category_list::clear() noexcept
+{
+    txt_.clear();
+    tokns_.clear();
+}
+
+
+void category_list::add_token(category_token_types tokn_type, std::string_view txt)
+{
+    tokns_.push_back({tokn_type, static_cast<std::uint32_t>(txt_.size()),
+                      static_cast<std::uint32_t>(txt.size())});
+    txt_.append(txt);
+}
+
+
+}
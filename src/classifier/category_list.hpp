@@ -0,0 +1,138 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/category_list.hpp
+ * @brief       category_list class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_CATEGORY_LIST_HPP
+#define CLASSIFIER_CATEGORY_LIST_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace classifier {
+
+
+/**
+ * @brief       The kinds of token of a category list.
+ */
+enum class category_token_types : std::uint8_t
+{
+    /** A key of the categories file, the tokens up to the next key are its values. */
+    KEY,
+
+    /** A string or a number value, the name of a value directory. */
+    NAME,
+
+    /** The value true, the entry is linked in the key directory. */
+    TRUE_VALUE,
+
+    /** The value false, the entry is not linked for the key. */
+    FALSE_VALUE,
+
+    /** An object or a null value, the categories file cannot be applied. */
+    INVALID,
+};
+
+
+/**
+ * @brief       Flat form of a categories file: its keys, each followed by its values with the
+ *              arrays flattened. It is filled without building any document, by the SIMD flat
+ *              parser when the file has the usual shape and by a SAX parser otherwise, the texts of
+ *              all the tokens sharing a single buffer.
+ */
+class category_list
+{
+public:
+    /**
+     * @brief       A token of the list.
+     */
+    struct token
+    {
+        category_token_types tokn_type;
+        std::uint32_t txt_offst;
+        std::uint32_t txt_len;
+    };
+
+    /**
+     * @brief       Parse a categories file, replacing the current tokens.
+     * @param       contnt : The content of the categories file.
+     * @return      If the content is a JSON object true is returned, otherwise false is returned.
+     */
+    bool parse(std::string_view contnt);
+
+    /**
+     * @brief       Append a token.
+     * @param       tokn_type : The token type.
+     * @param       txt : The text of the token.
+     */
+    void add_token(category_token_types tokn_type, std::string_view txt = {});
+
+    /**
+     * @brief       Reserve the storage of a list whose size is known beforehand.
+     * @param       tokns_nbr : The number of tokens.
+     * @param       txt_sz : The total size of the texts of the tokens.
+     */
+    void reserve(std::size_t tokns_nbr, std::size_t txt_sz);
+
+    /**
+     * @brief       Remove all the tokens.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief       Get the tokens, in the order of the file.
+     * @return      The tokens.
+     */
+    [[nodiscard]] const std::vector<token>& get_tokens() const noexcept
+    {
+        return tokns_;
+    }
+
+    /**
+     * @brief       Get the text of a key or of a name token.
+     * @param       tokn : The token.
+     * @return      The text of the token.
+     */
+    [[nodiscard]] std::string_view get_text(const token& tokn) const noexcept
+    {
+        return std::string_view(txt_).substr(tokn.txt_offst, tokn.txt_len);
+    }
+
+private:
+    class sax_handler;
+
+    /** The texts of the tokens, one after the other. */
+    std::string txt_;
+
+    std::vector<token> tokns_;
+};
+
+
+}
+
+
+#endif
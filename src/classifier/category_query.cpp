@@ -0,0 +1,540 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/**
+ * @file        classifier/category_query.cpp
+ * @brief       category_query class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <compare>
+#include <utility>
+
+#include "category_query.hpp"
+#include "mapped_category_index.hpp"
+
+
+namespace classifier {
+
+
+namespace {
+
+
+constexpr bool is_space(char ch) noexcept
+{
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+
+constexpr bool is_special(char ch) noexcept
+{
+    return ch == '(' || ch == ')' || ch == '=' || ch == '!' || ch == '<' || ch == '>' ||
+           ch == '"';
+}
+
+
+bool parse_number(std::string_view str, double* val) noexcept
+{
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), *val);
+
+    return ec == std::errc() && ptr == str.data() + str.size() && !str.empty();
+}
+
+
+}
+
+
+bool category_query::parse(std::string_view expr)
+{
+    std::vector<token> tokns;
+    std::size_t pos = 0;
+
+    nodes_.clear();
+
+    if (!tokenize(expr, &tokns) || !parse_or(tokns, &pos) ||
+        tokns[pos].token_type != token_types::END)
+    {
+        nodes_.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+template<typename TpIndex>
+roaring_bitmap category_query::evaluate(const TpIndex& indx) const
+{
+    if (nodes_.empty())
+    {
+        return roaring_bitmap();
+    }
+
+    return evaluate_node(indx, static_cast<std::uint32_t>(nodes_.size() - 1));
+}
+
+
+bool category_query::tokenize(std::string_view expr, std::vector<token>* tokns)
+{
+    std::size_t i = 0;
+    std::size_t j;
+    std::string wrd;
+
+    while (i < expr.size())
+    {
+        if (is_space(expr[i]))
+        {
+            ++i;
+        }
+        else if (expr[i] == '(' || expr[i] == ')')
+        {
+            tokns->push_back({expr[i] == '(' ? token_types::OPEN_PARENTHESIS :
+                                               token_types::CLOSE_PARENTHESIS, {}});
+            ++i;
+        }
+        else if (expr[i] == '=' || expr[i] == '!' || expr[i] == '<' || expr[i] == '>')
+        {
+            j = i + 1;
+            if (expr[i] != '=' && j < expr.size() && expr[j] == '=')
+            {
+                ++j;
+            }
+
+            if (expr.substr(i, j - i) == "!")
+            {
+                return false;
+            }
+
+            tokns->push_back({token_types::OPERATOR, std::string(expr.substr(i, j - i))});
+            i = j;
+        }
+        else if (expr[i] == '"')
+        {
+            wrd.clear();
+            for (++i; i < expr.size() && expr[i] != '"'; ++i)
+            {
+                if (expr[i] == '\\' && i + 1 < expr.size())
+                {
+                    ++i;
+                }
+
+                wrd += expr[i];
+            }
+
+            if (i == expr.size())
+            {
+                return false;
+            }
+
+            tokns->push_back({token_types::WORD, wrd});
+            ++i;
+        }
+        else
+        {
+            for (j = i; j < expr.size() && !is_space(expr[j]) && !is_special(expr[j]); ++j)
+            {
+            }
+
+            wrd = expr.substr(i, j - i);
+            if (wrd == "AND")
+            {
+                tokns->push_back({token_types::AND, {}});
+            }
+            else if (wrd == "OR")
+            {
+                tokns->push_back({token_types::OR, {}});
+            }
+            else if (wrd == "NOT")
+            {
+                tokns->push_back({token_types::NOT, {}});
+            }
+            else
+            {
+                tokns->push_back({token_types::WORD, wrd});
+            }
+
+            i = j;
+        }
+    }
+
+    tokns->push_back({token_types::END, {}});
+
+    return true;
+}
+
+
+bool category_query::parse_or(std::span<const token> tokns, std::size_t* pos)
+{
+    std::uint32_t lhs;
+
+    if (!parse_and(tokns, pos))
+    {
+        return false;
+    }
+
+    while (tokns[*pos].token_type == token_types::OR)
+    {
+        lhs = static_cast<std::uint32_t>(nodes_.size() - 1);
+        ++*pos;
+
+        if (!parse_and(tokns, pos))
+        {
+            return false;
+        }
+
+        nodes_.push_back({node_types::OR, lhs, static_cast<std::uint32_t>(nodes_.size() - 1),
+                          {}, {}});
+    }
+
+    return true;
+}
+
+
+bool category_query::parse_and(std::span<const token> tokns, std::size_t* pos)
+{
+    std::uint32_t lhs;
+
+    if (!parse_unary(tokns, pos))
+    {
+        return false;
+    }
+
+    while (tokns[*pos].token_type == token_types::AND)
+    {
+        lhs = static_cast<std::uint32_t>(nodes_.size() - 1);
+        ++*pos;
+
+        if (!parse_unary(tokns, pos))
+        {
+            return false;
+        }
+
+        nodes_.push_back({node_types::AND, lhs, static_cast<std::uint32_t>(nodes_.size() - 1),
+                          {}, {}});
+    }
+
+    return true;
+}
+
+
+bool category_query::parse_unary(std::span<const token> tokns, std::size_t* pos)
+{
+    switch (tokns[*pos].token_type)
+    {
+        case token_types::NOT:
+            ++*pos;
+            if (!parse_unary(tokns, pos))
+            {
+                return false;
+            }
+
+            nodes_.push_back({node_types::NOT, static_cast<std::uint32_t>(nodes_.size() - 1), 0,
+                              {}, {}});
+            return true;
+
+        case token_types::OPEN_PARENTHESIS:
+            ++*pos;
+            if (!parse_or(tokns, pos) ||
+                tokns[*pos].token_type != token_types::CLOSE_PARENTHESIS)
+            {
+                return false;
+            }
+
+            ++*pos;
+            return true;
+
+        default:
+            return parse_predicate(tokns, pos);
+    }
+}
+
+
+bool category_query::parse_predicate(std::span<const token> tokns, std::size_t* pos)
+{
+    node nde = {node_types::HAS_KEY, 0, 0, {}, {}};
+
+    if (tokns[*pos].token_type != token_types::WORD)
+    {
+        return false;
+    }
+
+    nde.ky = tokns[*pos].txt;
+    ++*pos;
+
+    if (tokns[*pos].token_type == token_types::OPERATOR)
+    {
+        const std::string& op = tokns[*pos].txt;
+
+        if (op == "=")
+        {
+            nde.node_type = node_types::EQUAL;
+        }
+        else if (op == "!=")
+        {
+            nde.node_type = node_types::NOT_EQUAL;
+        }
+        else if (op == "<")
+        {
+            nde.node_type = node_types::LESS;
+        }
+        else if (op == "<=")
+        {
+            nde.node_type = node_types::LESS_EQUAL;
+        }
+        else if (op == ">")
+        {
+            nde.node_type = node_types::GREATER;
+        }
+        else
+        {
+            nde.node_type = node_types::GREATER_EQUAL;
+        }
+
+        ++*pos;
+        if (tokns[*pos].token_type != token_types::WORD)
+        {
+            return false;
+        }
+
+        nde.val = tokns[*pos].txt;
+        ++*pos;
+    }
+
+    nodes_.push_back(std::move(nde));
+
+    return true;
+}
+
+
+template<typename TpIndex>
+roaring_bitmap category_query::evaluate_node(
+        const TpIndex& indx,
+        std::uint32_t node_id
+) const
+{
+    const node& nde = nodes_[node_id];
+    roaring_bitmap res;
+
+    switch (nde.node_type)
+    {
+        case node_types::OR:
+            res = evaluate_node(indx, nde.lhs);
+            res |= evaluate_node(indx, nde.rhs);
+            return res;
+
+        case node_types::AND:
+            return evaluate_and(indx, node_id);
+
+        case node_types::NOT:
+            res.add_range(0, indx.get_entries_number());
+            res -= evaluate_node(indx, nde.lhs);
+            return res;
+
+        default:
+            return evaluate_predicate(indx, nde);
+    }
+}
+
+
+template<typename TpIndex>
+roaring_bitmap category_query::evaluate_and(
+        const TpIndex& indx,
+        std::uint32_t node_id
+) const
+{
+    std::vector<std::uint32_t> positive_ids;
+    std::vector<std::uint32_t> negative_ids;
+    std::vector<roaring_bitmap> positive_sets;
+    roaring_bitmap res;
+
+    collect_and_operands(node_id, &positive_ids, &negative_ids);
+
+    positive_sets.reserve(positive_ids.size());
+    for (auto& x : positive_ids)
+    {
+        positive_sets.push_back(evaluate_node(indx, x));
+    }
+
+    // The smallest sets are intersected first, so that the intermediate results stay small and
+    // an empty one stops the evaluation early.
+    std::sort(positive_sets.begin(), positive_sets.end(),
+              [](const roaring_bitmap& lhs, const roaring_bitmap& rhs)
+    {
+        return lhs.get_cardinality() < rhs.get_cardinality();
+    });
+
+    if (positive_sets.empty())
+    {
+        res.add_range(0, indx.get_entries_number());
+    }
+    else
+    {
+        res = std::move(positive_sets.front());
+        for (std::size_t i = 1; i < positive_sets.size() && !res.is_empty(); ++i)
+        {
+            res &= positive_sets[i];
+        }
+    }
+
+    for (std::size_t i = 0; i < negative_ids.size() && !res.is_empty(); ++i)
+    {
+        res -= evaluate_node(indx, negative_ids[i]);
+    }
+
+    return res;
+}
+
+
+template<typename TpIndex>
+roaring_bitmap category_query::evaluate_predicate(
+        const TpIndex& indx,
+        const node& nde
+) const
+{
+    std::uint32_t ky_id = indx.find_category(category_index::NPOS, nde.ky);
+    std::uint32_t val_id;
+    roaring_bitmap res;
+
+    if (ky_id == category_index::NPOS)
+    {
+        return res;
+    }
+
+    if (nde.node_type == node_types::EQUAL)
+    {
+        val_id = indx.find_category(ky_id, nde.val);
+        if (val_id != category_index::NPOS)
+        {
+            res = indx.get_category_entries(val_id);
+        }
+
+        // The entries whose value is true are linked in the directory of the key itself.
+        if (nde.val == "true")
+        {
+            res |= indx.get_category_entries(ky_id);
+        }
+
+        return res;
+    }
+
+    if (nde.node_type == node_types::HAS_KEY || nde.node_type == node_types::NOT_EQUAL)
+    {
+        res = indx.get_category_entries(ky_id);
+    }
+
+    for (std::uint32_t i = 0; i < indx.get_categories_number(); ++i)
+    {
+        if (indx.get_key_category(i) == ky_id &&
+            (nde.node_type == node_types::HAS_KEY || nde.node_type == node_types::NOT_EQUAL ||
+             compare_values(indx.get_category_name(i), nde.node_type, nde.val)))
+        {
+            res |= indx.get_category_entries(i);
+        }
+    }
+
+    if (nde.node_type == node_types::NOT_EQUAL)
+    {
+        val_id = indx.find_category(ky_id, nde.val);
+        if (val_id != category_index::NPOS)
+        {
+            res -= indx.get_category_entries(val_id);
+        }
+
+        if (nde.val == "true")
+        {
+            res -= indx.get_category_entries(ky_id);
+        }
+    }
+
+    return res;
+}
+
+
+void category_query::collect_and_operands(
+        std::uint32_t node_id,
+        std::vector<std::uint32_t>* positive_ids,
+        std::vector<std::uint32_t>* negative_ids
+) const
+{
+    const node& nde = nodes_[node_id];
+
+    switch (nde.node_type)
+    {
+        case node_types::AND:
+            collect_and_operands(nde.lhs, positive_ids, negative_ids);
+            collect_and_operands(nde.rhs, positive_ids, negative_ids);
+            break;
+
+        case node_types::NOT:
+            negative_ids->push_back(nde.lhs);
+            break;
+
+        default:
+            positive_ids->push_back(node_id);
+            break;
+    }
+}
+
+
+bool category_query::compare_values(
+        std::string_view lhs,
+        node_types node_type,
+        std::string_view rhs
+) noexcept
+{
+    double lhs_nbr;
+    double rhs_nbr;
+    std::partial_ordering ordr = lhs <=> rhs;
+
+    if (parse_number(lhs, &lhs_nbr) && parse_number(rhs, &rhs_nbr))
+    {
+        ordr = lhs_nbr <=> rhs_nbr;
+    }
+
+    switch (node_type)
+    {
+        case node_types::LESS:
+            return ordr < 0;
+
+        case node_types::LESS_EQUAL:
+            return ordr <= 0;
+
+        case node_types::GREATER:
+            return ordr > 0;
+
+        case node_types::GREATER_EQUAL:
+            return ordr >= 0;
+
+        default:
+            return false;
+    }
+}
+
+
+template roaring_bitmap category_query::evaluate(const category_index& indx) const;
+
+template roaring_bitmap category_query::evaluate(const mapped_category_index& indx) const;
+
+
+}
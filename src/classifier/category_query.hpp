@@ -0,0 +1,191 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/**
+ * @file        classifier/category_query.hpp
+ * @brief       category_query class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_CATEGORY_QUERY_HPP
+#define CLASSIFIER_CATEGORY_QUERY_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "category_index.hpp"
+#include "roaring_bitmap.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Boolean expression over the categories of an index, such as
+ *              `Genres=Drama AND Mark>=8 AND NOT Status=Ongoing`. The predicates are a key alone,
+ *              matching the entries that have the key, or a key compared with a value through =,
+ *              !=, <, <=, > or >=, the ordering comparisons being numeric when both sides are
+ *              numbers. They combine with NOT, AND, OR and parentheses, and the names holding
+ *              spaces or operators are written between double quotes. An expression is evaluated
+ *              with set operations over the entries of the categories, never entry by entry.
+ */
+class category_query
+{
+public:
+    /**
+     * @brief       Default constructor.
+     */
+    category_query() = default;
+
+    /**
+     * @brief       Parse an expression, replacing the current one.
+     * @param       expr : The expression to parse.
+     * @return      If function was successful true is returned, otherwise false is returned and
+     *              the query is left empty.
+     */
+    bool parse(std::string_view expr);
+
+    /**
+     * @brief       Get the entries of an index that match the expression.
+     * @param       indx : The index, a category_index or a mapped_category_index.
+     * @return      The ids of the matching entries, none if the query is empty.
+     */
+    template<typename TpIndex>
+    [[nodiscard]] roaring_bitmap evaluate(const TpIndex& indx) const;
+
+    /**
+     * @brief       Check whether the query holds an expression.
+     * @return      If the query is empty true is returned, otherwise false is returned.
+     */
+    [[nodiscard]] bool is_empty() const noexcept
+    {
+        return nodes_.empty();
+    }
+
+private:
+    /**
+     * @brief       The kinds of node of an expression.
+     */
+    enum class node_types : std::uint8_t
+    {
+        OR,
+        AND,
+        NOT,
+        HAS_KEY,
+        EQUAL,
+        NOT_EQUAL,
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL,
+    };
+
+    /**
+     * @brief       A node of an expression. Operators refer to their operands by index, and a
+     *              node always comes after its operands.
+     */
+    struct node
+    {
+        node_types node_type;
+        std::uint32_t lhs = 0;
+        std::uint32_t rhs = 0;
+        std::string ky;
+        std::string val;
+    };
+
+    /**
+     * @brief       The kinds of token of an expression.
+     */
+    enum class token_types : std::uint8_t
+    {
+        WORD,
+        OPERATOR,
+        OPEN_PARENTHESIS,
+        CLOSE_PARENTHESIS,
+        AND,
+        OR,
+        NOT,
+        END,
+    };
+
+    /**
+     * @brief       A token of an expression.
+     */
+    struct token
+    {
+        token_types token_type;
+        std::string txt;
+    };
+
+    static bool tokenize(std::string_view expr, std::vector<token>* tokns);
+
+    bool parse_or(std::span<const token> tokns, std::size_t* pos);
+
+    bool parse_and(std::span<const token> tokns, std::size_t* pos);
+
+    bool parse_unary(std::span<const token> tokns, std::size_t* pos);
+
+    bool parse_predicate(std::span<const token> tokns, std::size_t* pos);
+
+    template<typename TpIndex>
+    [[nodiscard]] roaring_bitmap evaluate_node(
+            const TpIndex& indx,
+            std::uint32_t node_id
+    ) const;
+
+    template<typename TpIndex>
+    [[nodiscard]] roaring_bitmap evaluate_and(
+            const TpIndex& indx,
+            std::uint32_t node_id
+    ) const;
+
+    template<typename TpIndex>
+    [[nodiscard]] roaring_bitmap evaluate_predicate(
+            const TpIndex& indx,
+            const node& nde
+    ) const;
+
+    void collect_and_operands(
+            std::uint32_t node_id,
+            std::vector<std::uint32_t>* positive_ids,
+            std::vector<std::uint32_t>* negative_ids
+    ) const;
+
+    [[nodiscard]] static bool compare_values(
+            std::string_view lhs,
+            node_types node_type,
+            std::string_view rhs
+    ) noexcept;
+
+private:
+    /** The nodes of the expression, the last one being its root. */
+    std::vector<node> nodes_;
+};
+
+
+}
+
+
+#endif
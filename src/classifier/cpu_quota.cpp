@@ -0,0 +1,118 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/cpu_quota.cpp
+ * @brief       cpu_quota functions implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "cpu_quota.hpp"
+
+
+namespace classifier {
+
+
+#if defined(__linux__)
+static std::size_t get_cgroup_cpu_limit()
+{
+    std::ifstream ifstr;
+    std::string quota_str;
+    long long quota;
+    long long period;
+
+    // cgroup v2: "<quota> <period>" or "max <period>".
+    ifstr.open("/sys/fs/cgroup/cpu.max");
+    if (ifstr.is_open())
+    {
+        if (ifstr >> quota_str >> period && quota_str != "max" && period > 0)
+        {
+            quota = std::stoll(quota_str);
+            if (quota > 0)
+            {
+                return static_cast<std::size_t>((quota + period - 1) / period);
+            }
+        }
+
+        return 0;
+    }
+
+    // cgroup v1: separated quota and period files, a negative quota means unlimited.
+    ifstr.open("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+    if (!ifstr.is_open() || !(ifstr >> quota) || quota <= 0)
+    {
+        return 0;
+    }
+    ifstr.close();
+
+    ifstr.open("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+    if (!ifstr.is_open() || !(ifstr >> period) || period <= 0)
+    {
+        return 0;
+    }
+
+    return static_cast<std::size_t>((quota + period - 1) / period);
+}
+#endif
+
+
+std::size_t get_cpu_quota()
+{
+    std::size_t cpus_nbr = std::thread::hardware_concurrency();
+
+#if defined(__linux__)
+    cpu_set_t cpu_st;
+    std::size_t cgroup_limit;
+
+    CPU_ZERO(&cpu_st);
+    if (sched_getaffinity(0, sizeof(cpu_st), &cpu_st) == 0)
+    {
+        cpus_nbr = static_cast<std::size_t>(CPU_COUNT(&cpu_st));
+    }
+
+    try
+    {
+        cgroup_limit = get_cgroup_cpu_limit();
+    }
+    catch (...)
+    {
+        cgroup_limit = 0;
+    }
+
+    if (cgroup_limit > 0)
+    {
+        cpus_nbr = cpus_nbr > 0 ? std::min(cpus_nbr, cgroup_limit) : cgroup_limit;
+    }
+#endif
+
+    return std::max<std::size_t>(cpus_nbr, 1);
+}
+
+
+}
@@ -0,0 +1,48 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/cpu_quota.hpp
+ * @brief       cpu_quota functions header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_CPU_QUOTA_HPP
+#define CLASSIFIER_CPU_QUOTA_HPP
+
+#include <cstddef>
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Get the number of CPUs the current process is allowed to use. On Linux the cgroup
+ *              CPU quota and the scheduler affinity mask are taken into account, otherwise the
+ *              hardware concurrency is used.
+ * @return      The number of CPUs available, always greater than zero.
+ */
+std::size_t get_cpu_quota();
+
+
+}
+
+
+#endif
@@ -0,0 +1,658 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier/daemon_server.cpp
+ * @brief       daemon_server class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#if defined(__linux__)
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "category_query.hpp"
+#include "daemon_server.hpp"
+
+
+namespace classifier {
+
+
+daemon_server::daemon_server(reclassify_handler reclassify_handlr)
+        : reclassify_handlr_(std::move(reclassify_handlr))
+        , socket_pth_()
+        , listen_fd_(-1)
+        , epoll_fd_(-1)
+        , wake_fd_(-1)
+        , snap_()
+        , stopped_(false)
+        , clients_()
+        , pending_reclassifications_()
+        , next_client_id_(0)
+        , requests_nbr_(0)
+        , batches_nbr_(0)
+{
+}
+
+
+daemon_server::~daemon_server()
+{
+    close();
+}
+
+
+bool daemon_server::open(const std::filesystem::path& socket_pth)
+{
+    sockaddr_un addr = {};
+    epoll_event evnt = {};
+    std::error_code err_code;
+    int fd;
+
+    close();
+
+    if (socket_pth.native().size() >= sizeof(addr.sun_path))
+    {
+        return false;
+    }
+
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socket_pth.c_str(), socket_pth.native().size());
+
+    // A socket that accepts connections belongs to a daemon still running.
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    ::close(fd);
+
+    if (std::filesystem::is_socket(socket_pth, err_code))
+    {
+        std::filesystem::remove(socket_pth, err_code);
+    }
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (listen_fd_ < 0 || epoll_fd_ < 0 || wake_fd_ < 0 ||
+        ::bind(listen_fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0)
+    {
+        goto error;
+    }
+
+    socket_pth_ = socket_pth;
+
+    if (::listen(listen_fd_, SOMAXCONN) < 0)
+    {
+        goto error;
+    }
+
+    evnt.events = EPOLLIN;
+    evnt.data.fd = listen_fd_;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &evnt) < 0)
+    {
+        goto error;
+    }
+
+    evnt.data.fd = wake_fd_;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &evnt) < 0)
+    {
+        goto error;
+    }
+
+    stopped_.store(false, std::memory_order_release);
+
+    return true;
+
+error:
+    close();
+    return false;
+}
+
+
+bool daemon_server::run()
+{
+    epoll_event evnts[MAX_EVENTS_NBR];
+    std::vector<int> ready_fds;
+    std::unordered_map<std::string, std::string> query_answrs;
+    std::shared_ptr<const daemon_snapshot> snap;
+    std::uint64_t wake_cnt;
+    [[maybe_unused]] ssize_t read_sz;
+    int evnts_nbr;
+    int fd;
+
+    if (!is_open())
+    {
+        return false;
+    }
+
+    while (!stopped_.load(std::memory_order_acquire))
+    {
+        evnts_nbr = ::epoll_wait(epoll_fd_, evnts, MAX_EVENTS_NBR, -1);
+        if (evnts_nbr < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        ready_fds.clear();
+
+        for (int i = 0; i < evnts_nbr; ++i)
+        {
+            fd = evnts[i].data.fd;
+
+            if (fd == listen_fd_)
+            {
+                accept_clients();
+                continue;
+            }
+
+            // The snapshot is loaded below in any case, only the wake up is consumed.
+            if (fd == wake_fd_)
+            {
+                read_sz = ::read(wake_fd_, &wake_cnt, sizeof(wake_cnt));
+                continue;
+            }
+
+            auto it = clients_.find(fd);
+            if (it == clients_.end())
+            {
+                continue;
+            }
+
+            // Nothing can be sent anymore to a client that hung up.
+            if (evnts[i].events & (EPOLLHUP | EPOLLERR))
+            {
+                close_client(fd);
+                continue;
+            }
+
+            if (evnts[i].events & EPOLLOUT)
+            {
+                ready_fds.push_back(fd);
+            }
+
+            if (evnts[i].events & EPOLLIN)
+            {
+                read_client(fd, it->second, &ready_fds);
+            }
+        }
+
+        // The whole batch is answered from the same snapshot, which an update can replace in the
+        // meantime without waiting for the requests that use it.
+        snap = snap_.load(std::memory_order_acquire);
+        answer_reclassifications(snap.get(), &ready_fds);
+
+        if (!ready_fds.empty())
+        {
+            ++batches_nbr_;
+        }
+
+        for (auto& x : ready_fds)
+        {
+            auto it = clients_.find(x);
+            if (it != clients_.end())
+            {
+                handle_requests(x, it->second, snap.get(), &query_answrs);
+            }
+        }
+
+        for (auto& x : ready_fds)
+        {
+            auto it = clients_.find(x);
+            if (it != clients_.end())
+            {
+                flush_client(x, it->second);
+            }
+        }
+
+        query_answrs.clear();
+        snap.reset();
+    }
+
+    return true;
+}
+
+
+void daemon_server::publish(std::shared_ptr<const daemon_snapshot> snap)
+{
+    std::uint64_t one = 1;
+
+    snap_.store(std::move(snap), std::memory_order_release);
+
+    if (wake_fd_ >= 0)
+    {
+        [[maybe_unused]] ssize_t write_sz = ::write(wake_fd_, &one, sizeof(one));
+    }
+}
+
+
+void daemon_server::stop()
+{
+    std::uint64_t one = 1;
+
+    stopped_.store(true, std::memory_order_release);
+
+    if (wake_fd_ >= 0)
+    {
+        [[maybe_unused]] ssize_t write_sz = ::write(wake_fd_, &one, sizeof(one));
+    }
+}
+
+
+void daemon_server::close() noexcept
+{
+    std::error_code err_code;
+
+    for (auto& x : clients_)
+    {
+        ::close(x.first);
+    }
+
+    clients_.clear();
+    pending_reclassifications_.clear();
+
+    if (listen_fd_ >= 0)
+    {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+    }
+
+    if (epoll_fd_ >= 0)
+    {
+        ::close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+
+    if (wake_fd_ >= 0)
+    {
+        ::close(wake_fd_);
+        wake_fd_ = -1;
+    }
+
+    if (!socket_pth_.empty())
+    {
+        std::filesystem::remove(socket_pth_, err_code);
+        socket_pth_.clear();
+    }
+}
+
+
+void daemon_server::accept_clients()
+{
+    epoll_event evnt = {};
+    int fd;
+
+    for (;;)
+    {
+        fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return;
+        }
+
+        evnt.events = EPOLLIN;
+        evnt.data.fd = fd;
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &evnt) < 0)
+        {
+            ::close(fd);
+            continue;
+        }
+
+        client& clnt = clients_[fd];
+        clnt.id = ++next_client_id_;
+        clnt.watched_evnts = EPOLLIN;
+    }
+}
+
+
+void daemon_server::read_client(int fd, client& clnt, std::vector<int>* ready_fds)
+{
+    char buf[16 * 1024];
+    ssize_t read_sz;
+
+    // A client sending faster than it is answered is read again at the next batch.
+    while (clnt.in_buf.size() <= MAX_REQUEST_SIZE)
+    {
+        read_sz = ::recv(fd, buf, sizeof(buf), 0);
+        if (read_sz > 0)
+        {
+            clnt.in_buf.append(buf, static_cast<std::size_t>(read_sz));
+            continue;
+        }
+
+        if (read_sz == 0)
+        {
+            clnt.read_closed = true;
+            break;
+        }
+
+        if (errno == EINTR)
+        {
+            continue;
+        }
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            break;
+        }
+
+        close_client(fd);
+        return;
+    }
+
+    ready_fds->push_back(fd);
+}
+
+
+void daemon_server::handle_requests(
+        int fd,
+        client& clnt,
+        const daemon_snapshot* snap,
+        std::unordered_map<std::string, std::string>* query_answrs
+)
+{
+    std::string_view in_buf = clnt.in_buf;
+    std::string_view lne;
+    std::string_view verb;
+    std::string_view arg;
+    std::size_t lne_begin = 0;
+    std::size_t lne_end;
+    std::size_t space_pos;
+
+    clnt.requests_left = false;
+
+    // The last request of a client that stopped sending does not need its line feed.
+    while (!clnt.reclassifying && lne_begin < in_buf.size())
+    {
+        // A client that does not read its answers is not answered further.
+        if (clnt.out_buf.size() - clnt.out_offst >= MAX_OUTPUT_SIZE)
+        {
+            clnt.requests_left = true;
+            break;
+        }
+
+        lne_end = in_buf.find('\n', lne_begin);
+        if (lne_end == std::string_view::npos)
+        {
+            if (!clnt.read_closed)
+            {
+                break;
+            }
+
+            lne_end = in_buf.size();
+        }
+
+        lne = in_buf.substr(lne_begin, lne_end - lne_begin);
+        lne_begin = lne_end + 1;
+
+        if (!lne.empty() && lne.back() == '\r')
+        {
+            lne.remove_suffix(1);
+        }
+
+        if (lne.empty())
+        {
+            continue;
+        }
+
+        ++requests_nbr_;
+
+        space_pos = lne.find(' ');
+        verb = lne.substr(0, space_pos);
+        arg = space_pos == std::string_view::npos ? std::string_view() :
+                                                    lne.substr(space_pos + 1);
+
+        if (verb == "QUERY")
+        {
+            auto [it, insertd] = query_answrs->try_emplace(std::string(arg));
+            if (insertd)
+            {
+                handle_query(arg, snap, &it->second);
+            }
+
+            clnt.out_buf += it->second;
+        }
+        else if (verb == "RECLASSIFY")
+        {
+            handle_reclassify(arg, fd, clnt);
+        }
+        else if (verb == "STATS")
+        {
+            handle_stats(snap, &clnt.out_buf);
+        }
+        else
+        {
+            clnt.out_buf += "ERROR Unknown request\n";
+        }
+    }
+
+    clnt.in_buf.erase(0, std::min(lne_begin, clnt.in_buf.size()));
+
+    if (!clnt.reclassifying && !clnt.requests_left && clnt.in_buf.size() > MAX_REQUEST_SIZE)
+    {
+        clnt.out_buf += "ERROR Request too long\n";
+        clnt.in_buf.clear();
+        clnt.read_closed = true;
+    }
+}
+
+
+void daemon_server::handle_query(
+        std::string_view expr,
+        const daemon_snapshot* snap,
+        std::string* answr
+)
+{
+    category_query qury;
+    roaring_bitmap entry_ids;
+
+    if (snap == nullptr)
+    {
+        *answr = "ERROR Index not available\n";
+        return;
+    }
+
+    if (!qury.parse(expr))
+    {
+        *answr = "ERROR Invalid query expression\n";
+        return;
+    }
+
+    entry_ids = qury.evaluate(snap->indx);
+
+    *answr = "OK ";
+    *answr += std::to_string(entry_ids.get_cardinality());
+    *answr += '\n';
+
+    entry_ids.for_each([&](std::uint32_t entry_id)
+    {
+        *answr += snap->indx.get_entry_path(entry_id);
+        *answr += '\n';
+    });
+}
+
+
+void daemon_server::handle_reclassify(std::string_view entry_pth, int fd, client& clnt)
+{
+    std::uint64_t posted_nbr;
+
+    if (entry_pth.empty() || !reclassify_handlr_(std::filesystem::path(entry_pth), &posted_nbr))
+    {
+        clnt.out_buf += "ERROR Not an entry of the source directory\n";
+        return;
+    }
+
+    pending_reclassifications_.push_back({fd, clnt.id, posted_nbr});
+    clnt.reclassifying = true;
+}
+
+
+void daemon_server::handle_stats(const daemon_snapshot* snap, std::string* answr) const
+{
+    auto append_counter = [&](const char* nme, std::uint64_t val)
+    {
+        *answr += nme;
+        *answr += ' ';
+        *answr += std::to_string(val);
+        *answr += '\n';
+    };
+
+    *answr += "OK 7\n";
+    append_counter("entries", snap != nullptr ? snap->indx.get_entries_number() : 0);
+    append_counter("categories", snap != nullptr ? snap->indx.get_categories_number() : 0);
+    append_counter("updates", snap != nullptr ? snap->updates_nbr : 0);
+    append_counter("update_duration_ms", snap != nullptr ? snap->update_duration_ms : 0);
+    append_counter("clients", clients_.size());
+    append_counter("requests", requests_nbr_);
+    append_counter("batches", batches_nbr_);
+}
+
+
+void daemon_server::answer_reclassifications(
+        const daemon_snapshot* snap,
+        std::vector<int>* ready_fds
+)
+{
+    if (snap == nullptr)
+    {
+        return;
+    }
+
+    // The client may have left, and its socket may have been given to another one since.
+    std::erase_if(pending_reclassifications_, [&](const pending_reclassification& pending)
+    {
+        if (pending.posted_nbr > snap->applied_nbr)
+        {
+            return false;
+        }
+
+        auto it = clients_.find(pending.fd);
+        if (it != clients_.end() && it->second.id == pending.client_id)
+        {
+            it->second.out_buf += "OK 0\n";
+            it->second.reclassifying = false;
+            ready_fds->push_back(pending.fd);
+        }
+
+        return true;
+    });
+}
+
+
+void daemon_server::flush_client(int fd, client& clnt)
+{
+    epoll_event evnt = {};
+    ssize_t sent_sz;
+
+    while (clnt.out_offst < clnt.out_buf.size())
+    {
+        sent_sz = ::send(fd, clnt.out_buf.data() + clnt.out_offst,
+                         clnt.out_buf.size() - clnt.out_offst, MSG_NOSIGNAL);
+        if (sent_sz >= 0)
+        {
+            clnt.out_offst += static_cast<std::size_t>(sent_sz);
+            continue;
+        }
+
+        if (errno == EINTR)
+        {
+            continue;
+        }
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            break;
+        }
+
+        close_client(fd);
+        return;
+    }
+
+    if (clnt.out_offst == clnt.out_buf.size())
+    {
+        clnt.out_buf.clear();
+        clnt.out_offst = 0;
+
+        if (clnt.read_closed && !clnt.reclassifying && !clnt.requests_left)
+        {
+            close_client(fd);
+            return;
+        }
+    }
+
+    // A client is not read while it waits for a reclassification, once it stopped sending, or
+    // while its answers are piling up. It is written again as soon as its socket has room, and
+    // its requests left are handled then.
+    evnt.events = (clnt.read_closed || clnt.reclassifying || clnt.requests_left ||
+                   clnt.out_buf.size() - clnt.out_offst >= MAX_OUTPUT_SIZE ?
+                           0u : std::uint32_t{EPOLLIN}) |
+                  (clnt.out_buf.empty() && !clnt.requests_left ? 0u : std::uint32_t{EPOLLOUT});
+    evnt.data.fd = fd;
+
+    if (evnt.events != clnt.watched_evnts)
+    {
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &evnt) < 0)
+        {
+            close_client(fd);
+            return;
+        }
+
+        clnt.watched_evnts = evnt.events;
+    }
+}
+
+
+void daemon_server::close_client(int fd)
+{
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    clients_.erase(fd);
+}
+
+
+}
+
+#endif
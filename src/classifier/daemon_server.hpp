@@ -0,0 +1,261 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier/daemon_server.hpp
+ * @brief       daemon_server class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_DAEMON_SERVER_HPP
+#define CLASSIFIER_DAEMON_SERVER_HPP
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "mapped_category_index.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       The index published by the daemon after an update. A snapshot is never modified
+ *              once published, it lives as long as a request still uses it.
+ */
+struct daemon_snapshot
+{
+    /** The index saved by the update. */
+    mapped_category_index indx;
+
+    /** The number of updates done since the daemon started. */
+    std::uint64_t updates_nbr = 0;
+
+    /** The number of reclassifications posted before the update, all of them are applied. */
+    std::uint64_t applied_nbr = 0;
+
+    /** The time spent by the update, in milliseconds. */
+    std::uint64_t update_duration_ms = 0;
+};
+
+
+/**
+ * @brief       Server of the daemon mode, listening on a Unix domain socket. The requests are
+ *              lines of text answered by a status line, `OK <lines-number>` followed by the lines
+ *              of the answer or `ERROR <message>`:
+ *              - `QUERY <expression>` prints the entries that match the expression.
+ *              - `RECLASSIFY <entry-path>` classifies an entry again, and is answered once the
+ *                update that applies it has been published.
+ *              - `STATS` prints the counters of the index and of the server.
+ *              A single thread serves every client with epoll. The requests received together are
+ *              handled as a batch against the same snapshot, and a query asked several times in a
+ *              batch is evaluated once. The snapshot is replaced with an atomic swap, so a request
+ *              never waits for an update in progress.
+ */
+class daemon_server
+{
+public:
+    /** The name of the socket in the destination directory. */
+    static constexpr const char* FILE_NAME = ".classifier.socket";
+
+    /** The longest request accepted, a longer one closes its connection. */
+    static constexpr std::size_t MAX_REQUEST_SIZE = 64 * 1024;
+
+    /** The most answers kept unsent for a client, its requests are neither handled nor read
+     *  beyond that until the answers have been sent. */
+    static constexpr std::size_t MAX_OUTPUT_SIZE = 1024 * 1024;
+
+    /**
+     * @brief       The function called with the path of an entry to classify again. It returns
+     *              false if the path is not an entry, otherwise true with the number of
+     *              reclassifications posted so far, this one included.
+     */
+    using reclassify_handler = std::function<bool(const std::filesystem::path& entry_pth,
+                                                  std::uint64_t* posted_nbr)>;
+
+    /**
+     * @brief       Constructor with parameters.
+     * @param       reclassify_handlr : The function that posts the reclassifications.
+     */
+    explicit daemon_server(reclassify_handler reclassify_handlr);
+
+    daemon_server(const daemon_server& rhs) = delete;
+
+    /**
+     * @brief       Destructor.
+     */
+    ~daemon_server();
+
+    daemon_server& operator =(const daemon_server& rhs) = delete;
+
+    /**
+     * @brief       Create the socket and start listening. A socket left by a daemon that is not
+     *              running anymore is replaced, the one of a running daemon is not.
+     * @param       socket_pth : The path of the socket.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool open(const std::filesystem::path& socket_pth);
+
+    /**
+     * @brief       Serve the clients until stop is called.
+     * @return      If the server has been stopped true is returned, if it failed false is
+     *              returned.
+     */
+    bool run();
+
+    /**
+     * @brief       Replace the snapshot used by the requests and answer the reclassifications it
+     *              applies. Can be called from any thread.
+     * @param       snap : The new snapshot.
+     */
+    void publish(std::shared_ptr<const daemon_snapshot> snap);
+
+    /**
+     * @brief       Make run return. Can be called from any thread.
+     */
+    void stop();
+
+    /**
+     * @brief       Check whether the socket is listening.
+     * @return      If the socket is listening true is returned, otherwise false is returned.
+     */
+    [[nodiscard]] bool is_open() const noexcept
+    {
+        return listen_fd_ >= 0;
+    }
+
+    /**
+     * @brief       Disconnect the clients and remove the socket.
+     */
+    void close() noexcept;
+
+private:
+    /**
+     * @brief       A connected client.
+     */
+    struct client
+    {
+        std::uint64_t id = 0;
+
+        /** The bytes received that do not form a whole request yet. */
+        std::string in_buf;
+
+        /** The answers not sent yet, from the offset already sent. */
+        std::string out_buf;
+
+        std::size_t out_offst = 0;
+
+        /** The epoll events watched for the client. */
+        std::uint32_t watched_evnts = 0;
+
+        /** Whether a reclassification of the client is not answered yet, its next requests wait
+         *  for the update so that they see it. */
+        bool reclassifying = false;
+
+        /** Whether the client will not send anything else. */
+        bool read_closed = false;
+
+        /** Whether requests received are left to handle once the answers have been sent. */
+        bool requests_left = false;
+    };
+
+    /**
+     * @brief       A reclassification waiting for the update that applies it.
+     */
+    struct pending_reclassification
+    {
+        int fd;
+        std::uint64_t client_id;
+        std::uint64_t posted_nbr;
+    };
+
+    /** The number of events taken at once from epoll. */
+    static constexpr int MAX_EVENTS_NBR = 64;
+
+    void accept_clients();
+
+    void read_client(int fd, client& clnt, std::vector<int>* ready_fds);
+
+    void handle_requests(
+            int fd,
+            client& clnt,
+            const daemon_snapshot* snap,
+            std::unordered_map<std::string, std::string>* query_answrs
+    );
+
+    static void handle_query(std::string_view expr, const daemon_snapshot* snap,
+                             std::string* answr);
+
+    void handle_reclassify(std::string_view entry_pth, int fd, client& clnt);
+
+    void handle_stats(const daemon_snapshot* snap, std::string* answr) const;
+
+    void answer_reclassifications(const daemon_snapshot* snap, std::vector<int>* ready_fds);
+
+    void flush_client(int fd, client& clnt);
+
+    void close_client(int fd);
+
+private:
+    reclassify_handler reclassify_handlr_;
+
+    std::filesystem::path socket_pth_;
+
+    int listen_fd_;
+
+    int epoll_fd_;
+
+    /** The event file that wakes the server when a snapshot is published or when it is stopped. */
+    int wake_fd_;
+
+    /** The current snapshot, swapped atomically by the updates. */
+    std::atomic<std::shared_ptr<const daemon_snapshot>> snap_;
+
+    std::atomic<bool> stopped_;
+
+    /** The connected clients by socket. */
+    std::unordered_map<int, client> clients_;
+
+    std::vector<pending_reclassification> pending_reclassifications_;
+
+    std::uint64_t next_client_id_;
+
+    std::uint64_t requests_nbr_;
+
+    std::uint64_t batches_nbr_;
+};
+
+
+}
+
+#endif
+
+
+#endif
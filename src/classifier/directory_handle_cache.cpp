@@ -0,0 +1,183 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/directory_handle_cache.cpp
+ * @brief       directory_handle_cache class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#if !defined(_WIN32)
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "directory_handle_cache.hpp"
+
+#if !defined(O_PATH)
+#define O_PATH O_RDONLY
+#endif
+
+
+namespace classifier {
+
+
+directory_handle_cache::directory_handle_cache(std::size_t capacity)
+        : capacity_(capacity > 0 ? capacity : 1)
+        , root_pth_()
+        , lru_lst_()
+        , handles_()
+        , held_fds_()
+        , held_(false)
+{
+}
+
+
+directory_handle_cache::~directory_handle_cache()
+{
+    clear();
+    release_handles();
+}
+
+
+void directory_handle_cache::set_root(const std::filesystem::path& root_pth)
+{
+    clear();
+    root_pth_ = root_pth.native();
+
+    while (root_pth_.size() > 1 && root_pth_.back() == std::filesystem::path::preferred_separator)
+    {
+        root_pth_.pop_back();
+    }
+}
+
+
+int directory_handle_cache::get_handle(const std::filesystem::path& directory_pth)
+{
+    const string_type& directory_str = directory_pth.native();
+    std::filesystem::path parent_pth;
+    int parent_fd;
+    int directory_fd;
+
+    auto it = handles_.find(directory_str);
+    if (it != handles_.end())
+    {
+        lru_lst_.splice(lru_lst_.begin(), lru_lst_, it->second);
+        return it->second->second;
+    }
+
+    // Inside the root, a directory is opened from its parent handle: one component to resolve.
+    if (directory_str.size() > root_pth_.size() && !root_pth_.empty() &&
+        directory_str.compare(0, root_pth_.size(), root_pth_) == 0 &&
+        directory_str[root_pth_.size()] == std::filesystem::path::preferred_separator)
+    {
+        parent_pth = directory_pth.parent_path();
+        parent_fd = get_handle(parent_pth);
+        if (parent_fd < 0)
+        {
+            return -1;
+        }
+
+        directory_fd = ::openat(parent_fd, directory_pth.filename().c_str(),
+                                O_PATH | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    }
+    else
+    {
+        directory_fd = ::open(directory_str.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC);
+    }
+
+    if (directory_fd < 0)
+    {
+        return -1;
+    }
+
+    if (lru_lst_.size() >= capacity_)
+    {
+        close_handle(lru_lst_.back().second);
+        handles_.erase(lru_lst_.back().first);
+        lru_lst_.pop_back();
+    }
+
+    lru_lst_.emplace_front(directory_str, directory_fd);
+    handles_.emplace(directory_str, lru_lst_.begin());
+
+    return directory_fd;
+}
+
+
+void directory_handle_cache::forget(const std::filesystem::path& directory_pth)
+{
+    auto it = handles_.find(directory_pth.native());
+
+    if (it != handles_.end())
+    {
+        close_handle(it->second->second);
+        lru_lst_.erase(it->second);
+        handles_.erase(it);
+    }
+}
+
+
+void directory_handle_cache::hold_handles() noexcept
+{
+    held_ = true;
+}
+
+
+void directory_handle_cache::release_handles() noexcept
+{
+    for (auto& x : held_fds_)
+    {
+        ::close(x);
+    }
+
+    held_fds_.clear();
+    held_ = false;
+}
+
+
+void directory_handle_cache::clear() noexcept
+{
+    for (auto& x : lru_lst_)
+    {
+        ::close(x.second);
+    }
+
+    lru_lst_.clear();
+    handles_.clear();
+}
+
+
+void directory_handle_cache::close_handle(int fd)
+{
+    if (held_)
+    {
+        held_fds_.push_back(fd);
+    }
+    else
+    {
+        ::close(fd);
+    }
+}
+
+
+}
+
+#endif
@@ -0,0 +1,132 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/directory_handle_cache.hpp
+ * @brief       directory_handle_cache class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_DIRECTORY_HANDLE_CACHE_HPP
+#define CLASSIFIER_DIRECTORY_HANDLE_CACHE_HPP
+
+#include <filesystem>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Least recently used cache of open directory file descriptors, meant to be used with
+ *              the *at system calls so that an operation in a directory only resolves the last
+ *              component of a path. A missing directory is opened relative to the handle of its
+ *              parent, so the kernel never walks more than one component per call. Only available
+ *              on POSIX systems.
+ */
+class directory_handle_cache
+{
+public:
+    using string_type = std::filesystem::path::string_type;
+
+    /**
+     * @brief       Constructor with parameters.
+     * @param       capacity : The maximum number of directories kept open.
+     */
+    explicit directory_handle_cache(std::size_t capacity);
+
+    directory_handle_cache(const directory_handle_cache& rhs) = delete;
+
+    /**
+     * @brief       Destructor.
+     */
+    ~directory_handle_cache();
+
+    directory_handle_cache& operator =(const directory_handle_cache& rhs) = delete;
+
+    /**
+     * @brief       Set the directory under which handles are opened relative to their parent.
+     *              The directories outside it are opened with their full path.
+     * @param       root_pth : The root directory.
+     */
+    void set_root(const std::filesystem::path& root_pth);
+
+    /**
+     * @brief       Get a handle to a directory, opening it if needed. The handle belongs to the
+     *              cache and stays valid until the next call to any other method.
+     * @param       directory_pth : The path of the directory.
+     * @return      The directory file descriptor, or -1 if the directory could not be opened.
+     */
+    int get_handle(const std::filesystem::path& directory_pth);
+
+    /**
+     * @brief       Close the handle of a directory that has been removed or replaced.
+     * @param       directory_pth : The path of the directory.
+     */
+    void forget(const std::filesystem::path& directory_pth);
+
+    /**
+     * @brief       Keep the evicted and forgotten handles open until release_handles is called, so
+     *              that the operations still in flight can use them.
+     */
+    void hold_handles() noexcept;
+
+    /**
+     * @brief       Close the handles kept open since the call to hold_handles.
+     */
+    void release_handles() noexcept;
+
+    /**
+     * @brief       Close all the handles.
+     */
+    void clear() noexcept;
+
+private:
+    using lru_list_type = std::list<std::pair<string_type, int>>;
+
+    std::size_t capacity_;
+
+    string_type root_pth_;
+
+    /** The handles, the most recently used first. */
+    lru_list_type lru_lst_;
+
+    std::unordered_map<string_type, lru_list_type::iterator> handles_;
+
+    /** The handles that are no longer cached but still open because they are held. */
+    std::vector<int> held_fds_;
+
+    bool held_;
+
+    /**
+     * @brief       Close a handle, or keep it open if the handles are held.
+     * @param       fd : The handle to close.
+     */
+    void close_handle(int fd);
+};
+
+
+}
+
+
+#endif
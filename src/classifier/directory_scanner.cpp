@@ -0,0 +1,248 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/directory_scanner.cpp
+ * @brief       directory_scanner class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "cpu_quota.hpp"
+#include "directory_scanner.hpp"
+
+
+namespace classifier {
+
+
+directory_scanner::directory_scanner(
+        std::filesystem::path root_pth,
+        std::string file_nme,
+        std::size_t jobs_nbr
+)
+        : root_pth_(std::move(root_pth))
+        , file_nme_(std::filesystem::path(std::move(file_nme)).native())
+        , jobs_nbr_(jobs_nbr > 0 ? jobs_nbr : get_cpu_quota())
+        , workrs_()
+        , pending_directories_nbr_(0)
+        , canonical_root_pth_()
+        , linked_dirs_mtx_()
+        , linked_dirs_()
+{
+    workrs_.reserve(jobs_nbr_);
+    for (std::size_t i = 0; i < jobs_nbr_; ++i)
+    {
+        workrs_.push_back(std::make_unique<worker>());
+    }
+}
+
+
+void directory_scanner::scan(const callback_type& callback)
+{
+    std::vector<std::thread> thrds;
+    std::error_code err_code;
+
+    if (root_pth_.empty())
+    {
+        return;
+    }
+
+    canonical_root_pth_ = (std::filesystem::weakly_canonical(root_pth_, err_code) / "").native();
+    linked_dirs_.clear();
+    linked_dirs_.insert(get_file_id(root_pth_));
+
+    push_directory(0, std::filesystem::path(root_pth_));
+
+    thrds.reserve(jobs_nbr_ - 1);
+    for (std::size_t i = 1; i < jobs_nbr_; ++i)
+    {
+        thrds.emplace_back(&directory_scanner::run_worker, this, i, std::cref(callback));
+    }
+
+    run_worker(0, callback);
+
+    for (auto& x : thrds)
+    {
+        x.join();
+    }
+}
+
+
+void directory_scanner::run_worker(std::size_t worker_idx, const callback_type& callback)
+{
+    std::filesystem::path directory_pth;
+    std::size_t idle_nbr = 0;
+
+    for (;;)
+    {
+        if (pop_directory(worker_idx, directory_pth))
+        {
+            idle_nbr = 0;
+            scan_directory(worker_idx, directory_pth, callback);
+            pending_directories_nbr_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        else if (pending_directories_nbr_.load(std::memory_order_acquire) == 0)
+        {
+            return;
+        }
+        else if (++idle_nbr < 64)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+}
+
+
+bool directory_scanner::pop_directory(std::size_t worker_idx, std::filesystem::path& directory_pth)
+{
+    {
+        worker& own_workr = *workrs_[worker_idx];
+        std::lock_guard<std::mutex> lock(own_workr.mtx);
+
+        if (!own_workr.directories.empty())
+        {
+            directory_pth = std::move(own_workr.directories.back());
+            own_workr.directories.pop_back();
+            return true;
+        }
+    }
+
+    for (std::size_t i = 1; i < jobs_nbr_; ++i)
+    {
+        worker& victim_workr = *workrs_[(worker_idx + i) % jobs_nbr_];
+        std::lock_guard<std::mutex> lock(victim_workr.mtx);
+
+        if (!victim_workr.directories.empty())
+        {
+            directory_pth = std::move(victim_workr.directories.front());
+            victim_workr.directories.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void directory_scanner::push_directory(
+        std::size_t worker_idx,
+        std::filesystem::path&& directory_pth
+)
+{
+    worker& own_workr = *workrs_[worker_idx];
+
+    pending_directories_nbr_.fetch_add(1, std::memory_order_acq_rel);
+
+    std::lock_guard<std::mutex> lock(own_workr.mtx);
+    own_workr.directories.push_back(std::move(directory_pth));
+}
+
+
+void directory_scanner::scan_directory(
+        std::size_t worker_idx,
+        const std::filesystem::path& directory_pth,
+        const callback_type& callback
+)
+{
+    std::vector<std::filesystem::path>& subdir_pths = workrs_[worker_idx]->subdirectories;
+    std::error_code err_code;
+    std::filesystem::directory_iterator it(
+            directory_pth, std::filesystem::directory_options::skip_permission_denied, err_code);
+
+    for (; !err_code && it != std::filesystem::directory_iterator(); it.increment(err_code))
+    {
+        const std::filesystem::directory_entry& entry = *it;
+
+        if (entry.is_directory(err_code))
+        {
+            if (!entry.is_symlink(err_code) || enter_linked_directory(entry.path()))
+            {
+                subdir_pths.push_back(entry.path());
+            }
+        }
+        else if (has_file_name(entry.path()) && entry.is_regular_file(err_code))
+        {
+            callback(std::filesystem::path(entry.path()));
+        }
+
+        err_code.clear();
+    }
+
+    // The directories are popped from the back, the first one by name is pushed last.
+    std::sort(subdir_pths.begin(), subdir_pths.end(),
+              [](const std::filesystem::path& lhs, const std::filesystem::path& rhs)
+    {
+        return lhs.native() > rhs.native();
+    });
+
+    for (auto& x : subdir_pths)
+    {
+        push_directory(worker_idx, std::move(x));
+    }
+
+    subdir_pths.clear();
+}
+
+
+bool directory_scanner::has_file_name(const std::filesystem::path& pth) const noexcept
+{
+    const std::filesystem::path::string_type& pth_str = pth.native();
+    std::size_t separator_pos = pth_str.size() - file_nme_.size() - 1;
+
+    // The name is compared in place, every entry of the tree goes through here.
+    return pth_str.size() > file_nme_.size() && pth_str.ends_with(file_nme_) &&
+           pth_str[separator_pos] == std::filesystem::path::preferred_separator;
+}
+
+
+bool directory_scanner::enter_linked_directory(const std::filesystem::path& lnk_pth)
+{
+    std::error_code err_code;
+    std::filesystem::path target_pth = std::filesystem::canonical(lnk_pth, err_code);
+    std::filesystem::path::string_type target_prefx;
+
+    if (err_code)
+    {
+        return false;
+    }
+
+    // A target inside the tree is scanned through its own path, and a target holding the tree
+    // would scan it again.
+    target_prefx = (target_pth / "").native();
+    if (target_prefx.starts_with(canonical_root_pth_) ||
+        canonical_root_pth_.starts_with(target_prefx))
+    {
+        return false;
+    }
+
+    // Every target is entered once, a link back to a directory being scanned is not followed.
+    std::lock_guard<std::mutex> lock(linked_dirs_mtx_);
+    return linked_dirs_.insert(get_file_id(target_pth)).second;
+}
+
+
+}
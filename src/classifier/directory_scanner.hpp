@@ -0,0 +1,137 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/directory_scanner.hpp
+ * @brief       directory_scanner class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_DIRECTORY_SCANNER_HPP
+#define CLASSIFIER_DIRECTORY_SCANNER_HPP
+
+#include <atomic>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "file_id.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Multi-threaded recursive search of the regular files that have a given name. Every
+ *              worker owns a deque of directories to visit: it pushes and pops subdirectories at
+ *              the back of its own deque and, when it runs out of work, steals directories from the
+ *              front of the other workers deques. The subdirectories of a directory are visited
+ *              in name order, so that a single worker always finds the files in the same order.
+ *              Symbolic links to directories are followed,
+ *              unless their target is inside the scanned tree or has already been visited through
+ *              another link, which also prevents cycles.
+ */
+class directory_scanner
+{
+public:
+    using callback_type = std::function<void(std::filesystem::path&&)>;
+
+    /**
+     * @brief       Constructor with parameters.
+     * @param       root_pth : The directory in which the search starts.
+     * @param       file_nme : The name of the files to find.
+     * @param       jobs_nbr : The number of threads to use, zero to use the CPU quota.
+     */
+    directory_scanner(std::filesystem::path root_pth, std::string file_nme, std::size_t jobs_nbr);
+
+    /**
+     * @brief       Scan the directory tree. The callback is called concurrently from the worker
+     *              threads for every file found, so it has to be thread safe.
+     * @param       callback : The function to call with the path of every file found.
+     */
+    void scan(const callback_type& callback);
+
+    /**
+     * @brief       Get the number of threads used to scan.
+     * @return      The number of threads used to scan.
+     */
+    [[nodiscard]] std::size_t get_jobs_number() const noexcept
+    {
+        return jobs_nbr_;
+    }
+
+private:
+    struct worker
+    {
+        std::mutex mtx;
+        std::deque<std::filesystem::path> directories;
+
+        /** The subdirectories of the directory being scanned, only used by the worker itself. */
+        std::vector<std::filesystem::path> subdirectories;
+    };
+
+    void run_worker(std::size_t worker_idx, const callback_type& callback);
+
+    bool pop_directory(std::size_t worker_idx, std::filesystem::path& directory_pth);
+
+    void push_directory(std::size_t worker_idx, std::filesystem::path&& directory_pth);
+
+    void scan_directory(
+            std::size_t worker_idx,
+            const std::filesystem::path& directory_pth,
+            const callback_type& callback
+    );
+
+    [[nodiscard]] bool has_file_name(const std::filesystem::path& pth) const noexcept;
+
+    bool enter_linked_directory(const std::filesystem::path& lnk_pth);
+
+private:
+    std::filesystem::path root_pth_;
+
+    /** The name of the files to find, compared with the end of the native paths. */
+    std::filesystem::path::string_type file_nme_;
+
+    std::size_t jobs_nbr_;
+
+    std::vector<std::unique_ptr<worker>> workrs_;
+
+    /** The number of directories pushed that have not been completely scanned yet. */
+    std::atomic<std::size_t> pending_directories_nbr_;
+
+    /** The canonical root path followed by a separator, to recognize the links into the tree. */
+    std::filesystem::path::string_type canonical_root_pth_;
+
+    std::mutex linked_dirs_mtx_;
+
+    /** The directories entered through a symbolic link, and the root directory. */
+    std::unordered_set<file_id, file_id_hash> linked_dirs_;
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,189 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/directory_walker.cpp
+ * @brief       directory_walker class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <cstring>
+#include <memory>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "directory_walker.hpp"
+
+
+namespace classifier {
+
+
+#if defined(__linux__)
+namespace {
+
+
+/** The record layout returned by the getdents64 system call. */
+struct linux_dirent64
+{
+    std::uint64_t d_ino;
+    std::int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+
+constexpr std::size_t DIRENTS_BUFFER_SIZE = 32 * 1024;
+
+
+}
+
+
+void directory_walker::walk(const std::filesystem::path& root_pth, const callback_type& callback)
+{
+    std::filesystem::path directory_pth = root_pth;
+    int directory_fd;
+
+    if (root_pth.empty())
+    {
+        return;
+    }
+
+    directory_fd = ::open(root_pth.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (directory_fd < 0)
+    {
+        return;
+    }
+
+    walk_directory(directory_fd, directory_pth, callback);
+    ::close(directory_fd);
+}
+
+
+void directory_walker::walk_directory(
+        int directory_fd,
+        std::filesystem::path& directory_pth,
+        const callback_type& callback
+)
+{
+    auto dirents_buf = std::make_unique<char[]>(DIRENTS_BUFFER_SIZE);
+    struct stat file_stat;
+    std::uint64_t dev;
+    long bytes_nbr;
+    linux_dirent64* dirent;
+    file_id id;
+    bool is_dir;
+    int child_fd;
+
+    // All the entries of a directory share its device.
+    if (::fstat(directory_fd, &file_stat) != 0)
+    {
+        return;
+    }
+    dev = static_cast<std::uint64_t>(file_stat.st_dev);
+
+    // The path of each entry replaces the file name of the previous one in place, only the return
+    // to the parent directory builds a new path.
+    directory_pth /= "";
+
+    while ((bytes_nbr = ::syscall(SYS_getdents64, directory_fd, dirents_buf.get(),
+                                  DIRENTS_BUFFER_SIZE)) > 0)
+    {
+        for (long offset = 0; offset < bytes_nbr; offset += dirent->d_reclen)
+        {
+            dirent = reinterpret_cast<linux_dirent64*>(dirents_buf.get() + offset);
+
+            if (std::strcmp(dirent->d_name, ".") == 0 || std::strcmp(dirent->d_name, "..") == 0)
+            {
+                continue;
+            }
+
+            if (dirent->d_type == DT_UNKNOWN)
+            {
+                if (::fstatat(directory_fd, dirent->d_name, &file_stat, AT_SYMLINK_NOFOLLOW) != 0)
+                {
+                    continue;
+                }
+
+                id = {static_cast<std::uint64_t>(file_stat.st_dev),
+                      static_cast<std::uint64_t>(file_stat.st_ino)};
+                is_dir = S_ISDIR(file_stat.st_mode);
+            }
+            else
+            {
+                id = {dev, dirent->d_ino};
+                is_dir = dirent->d_type == DT_DIR;
+            }
+
+            directory_pth.replace_filename(dirent->d_name);
+            callback(directory_pth, id, is_dir);
+
+            if (is_dir)
+            {
+                child_fd = ::openat(directory_fd, dirent->d_name,
+                                    O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+                if (child_fd >= 0)
+                {
+                    walk_directory(child_fd, directory_pth, callback);
+                    ::close(child_fd);
+                }
+            }
+        }
+    }
+
+    directory_pth.remove_filename();
+    directory_pth = directory_pth.parent_path();
+}
+
+#else
+
+void directory_walker::walk(const std::filesystem::path& root_pth, const callback_type& callback)
+{
+    std::error_code err_code;
+    std::filesystem::recursive_directory_iterator it;
+    bool is_dir;
+
+    if (root_pth.empty())
+    {
+        return;
+    }
+
+    it = std::filesystem::recursive_directory_iterator(
+            root_pth, std::filesystem::directory_options::skip_permission_denied, err_code);
+
+    for (; !err_code && it != std::filesystem::recursive_directory_iterator();
+         it.increment(err_code))
+    {
+        is_dir = it->is_directory(err_code) && !it->is_symlink(err_code);
+        callback(it->path(), get_file_id(it->path()), is_dir);
+        err_code.clear();
+    }
+}
+
+#endif
+
+
+}
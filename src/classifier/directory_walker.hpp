@@ -0,0 +1,76 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/directory_walker.hpp
+ * @brief       directory_walker class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_DIRECTORY_WALKER_HPP
+#define CLASSIFIER_DIRECTORY_WALKER_HPP
+
+#include <filesystem>
+#include <functional>
+
+#include "file_id.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Recursive walk of a directory tree that reports, for every file, its identifier and
+ *              whether it is a directory, without following symbolic links. Every directory is
+ *              reported before its content. On Linux the directories are read with getdents64 and
+ *              the identifier and the type come from the directory entries themselves, so a file
+ *              costs no system call unless its file system does not fill the entry type.
+ */
+class directory_walker
+{
+public:
+    using callback_type = std::function<void(
+            const std::filesystem::path& file_pth,
+            const file_id& id,
+            bool is_directory
+    )>;
+
+    /**
+     * @brief       Walk a directory tree.
+     * @param       root_pth : The directory to walk, it is not reported itself.
+     * @param       callback : The function to call for every file found.
+     */
+    static void walk(const std::filesystem::path& root_pth, const callback_type& callback);
+
+private:
+#if defined(__linux__)
+    static void walk_directory(
+            int directory_fd,
+            std::filesystem::path& directory_pth,
+            const callback_type& callback
+    );
+#endif
+};
+
+
+}
+
+
+#endif
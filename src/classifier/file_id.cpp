@@ -0,0 +1,117 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/file_id.cpp
+ * @brief       file_id struct implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <limits.h>
+#include <sys/stat.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#include "file_id.hpp"
+
+
+namespace classifier {
+
+
+file_id get_file_id(const std::filesystem::path& file_pth)
+{
+    file_id id;
+
+#if defined(_WIN32)
+    BY_HANDLE_FILE_INFORMATION file_inf;
+    HANDLE file_hndl = CreateFileW(file_pth.c_str(), 0,
+                                   FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                   OPEN_EXISTING,
+                                   FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OPEN_REPARSE_POINT,
+                                   nullptr);
+
+    if (file_hndl == INVALID_HANDLE_VALUE)
+    {
+        return id;
+    }
+
+    if (GetFileInformationByHandle(file_hndl, &file_inf) != 0)
+    {
+        id.dev = file_inf.dwVolumeSerialNumber;
+        id.ino = (static_cast<std::uint64_t>(file_inf.nFileIndexHigh) << 32) |
+                 file_inf.nFileIndexLow;
+    }
+
+    CloseHandle(file_hndl);
+
+#else
+    struct stat file_stat;
+
+    if (::lstat(file_pth.c_str(), &file_stat) == 0)
+    {
+        id.dev = static_cast<std::uint64_t>(file_stat.st_dev);
+        id.ino = static_cast<std::uint64_t>(file_stat.st_ino);
+    }
+#endif
+
+    return id;
+}
+
+
+file_id get_parent_file_id(const std::filesystem::path& file_pth)
+{
+#if defined(_WIN32)
+    return get_file_id(file_pth.parent_path());
+
+#else
+    const std::string& pth_str = file_pth.native();
+    std::size_t separator_pos = pth_str.find_last_of('/');
+    char parent_pth[PATH_MAX];
+    struct stat file_stat;
+    file_id id;
+
+    // The parent path is copied on the stack, a path object would allocate its components.
+    if (separator_pos == std::string::npos || separator_pos + 1 >= sizeof(parent_pth))
+    {
+        return get_file_id(file_pth.parent_path());
+    }
+
+    // The root directory keeps its separator.
+    separator_pos = std::max<std::size_t>(separator_pos, 1);
+    std::memcpy(parent_pth, pth_str.data(), separator_pos);
+    parent_pth[separator_pos] = '\0';
+
+    if (::lstat(parent_pth, &file_stat) == 0)
+    {
+        id.dev = static_cast<std::uint64_t>(file_stat.st_dev);
+        id.ino = static_cast<std::uint64_t>(file_stat.st_ino);
+    }
+
+    return id;
+#endif
+}
+
+
+}
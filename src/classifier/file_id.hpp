@@ -0,0 +1,88 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/file_id.hpp
+ * @brief       file_id struct header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_FILE_ID_HPP
+#define CLASSIFIER_FILE_ID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Identifies a file across all the mounted file systems: the device that holds it and
+ *              its inode number (the volume serial number and the file index on Windows).
+ */
+struct file_id
+{
+    std::uint64_t dev = 0;
+    std::uint64_t ino = 0;
+
+    bool operator ==(const file_id& rhs) const noexcept = default;
+};
+
+
+/**
+ * @brief       Hash of a file identifier, a splitmix64 finalizer over both of its halves.
+ */
+struct file_id_hash
+{
+    std::size_t operator ()(const file_id& id) const noexcept
+    {
+        std::uint64_t x = id.ino ^ (id.dev * 0x9e3779b97f4a7c15ULL);
+
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+
+        return static_cast<std::size_t>(x);
+    }
+};
+
+
+/**
+ * @brief       Get the identifier of a file. Symbolic links are not followed.
+ * @param       file_pth : The path of the file.
+ * @return      The identifier of the file, or a zeroed identifier if it could not be read.
+ */
+file_id get_file_id(const std::filesystem::path& file_pth);
+
+
+/**
+ * @brief       Get the identifier of the directory that holds a file, without building its path.
+ * @param       file_pth : The path of the file.
+ * @return      The identifier of the directory, or a zeroed identifier if it could not be read.
+ */
+file_id get_parent_file_id(const std::filesystem::path& file_pth);
+
+
+}
+
+
+#endif
@@ -0,0 +1,206 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/file_id_set.hpp
+ * @brief       file_id_set class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_FILE_ID_SET_HPP
+#define CLASSIFIER_FILE_ID_SET_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "file_id.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Set of file identifiers stored in a flat open-addressing table with linear probing.
+ *              The zero identifier, which no file can have, marks the empty slots, so a lookup
+ *              touches a single contiguous run of slots and never follows a pointer.
+ */
+class file_id_set
+{
+public:
+    /**
+     * @brief       Default constructor.
+     */
+    file_id_set()
+            : slots_()
+            , mask_(0)
+            , sz_(0)
+            , contains_zero_(false)
+    {
+    }
+
+    /**
+     * @brief       Insert an identifier.
+     * @param       id : The identifier to insert.
+     * @return      If the identifier was not in the set true is returned, otherwise false is
+     *              returned.
+     */
+    bool insert(const file_id& id)
+    {
+        std::size_t idx;
+
+        if (id == file_id())
+        {
+            bool insertd = !contains_zero_;
+            contains_zero_ = true;
+            return insertd;
+        }
+
+        if ((sz_ + 1) * 4 > slots_.size() * 3)
+        {
+            rehash(slots_.empty() ? MIN_SLOTS_NBR : slots_.size() * 2);
+        }
+
+        for (idx = hash(id) & mask_; !(slots_[idx] == file_id()); idx = (idx + 1) & mask_)
+        {
+            if (slots_[idx] == id)
+            {
+                return false;
+            }
+        }
+
+        slots_[idx] = id;
+        ++sz_;
+
+        return true;
+    }
+
+    /**
+     * @brief       Check whether an identifier is in the set.
+     * @param       id : The identifier to look for.
+     * @return      If the identifier is in the set true is returned, otherwise false is returned.
+     */
+    [[nodiscard]] bool contains(const file_id& id) const noexcept
+    {
+        if (id == file_id())
+        {
+            return contains_zero_;
+        }
+
+        if (slots_.empty())
+        {
+            return false;
+        }
+
+        for (std::size_t idx = hash(id) & mask_; !(slots_[idx] == file_id());
+             idx = (idx + 1) & mask_)
+        {
+            if (slots_[idx] == id)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief       Allocate the slots for a number of identifiers so that no rehash happens until
+     *              it is reached.
+     * @param       elems_nbr : The number of identifiers expected.
+     */
+    void reserve(std::size_t elems_nbr)
+    {
+        std::size_t slots_nbr = MIN_SLOTS_NBR;
+
+        while (slots_nbr * 3 < elems_nbr * 4)
+        {
+            slots_nbr <<= 1;
+        }
+
+        if (slots_nbr > slots_.size())
+        {
+            rehash(slots_nbr);
+        }
+    }
+
+    /**
+     * @brief       Remove all the identifiers, keeping the allocated slots.
+     */
+    void clear() noexcept
+    {
+        std::fill(slots_.begin(), slots_.end(), file_id());
+        sz_ = 0;
+        contains_zero_ = false;
+    }
+
+    /**
+     * @brief       Get the number of identifiers in the set.
+     * @return      The number of identifiers in the set.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return sz_ + (contains_zero_ ? 1 : 0);
+    }
+
+private:
+    static constexpr std::size_t MIN_SLOTS_NBR = 16;
+
+    static std::size_t hash(const file_id& id) noexcept
+    {
+        return file_id_hash()(id);
+    }
+
+    void rehash(std::size_t slots_nbr)
+    {
+        std::vector<file_id> old_slots(slots_nbr);
+        std::size_t idx;
+
+        old_slots.swap(slots_);
+        mask_ = slots_nbr - 1;
+
+        for (auto& x : old_slots)
+        {
+            if (!(x == file_id()))
+            {
+                for (idx = hash(x) & mask_; !(slots_[idx] == file_id()); idx = (idx + 1) & mask_)
+                {
+                }
+
+                slots_[idx] = x;
+            }
+        }
+    }
+
+private:
+    std::vector<file_id> slots_;
+
+    std::size_t mask_;
+
+    std::size_t sz_;
+
+    bool contains_zero_;
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,75 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/file_operation.hpp
+ * @brief       file_operation struct header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_FILE_OPERATION_HPP
+#define CLASSIFIER_FILE_OPERATION_HPP
+
+#include <cstdint>
+#include <filesystem>
+
+
+namespace classifier {
+
+
+/**
+ * @brief       The kinds of mutation the destination directory can receive.
+ */
+enum class file_operation_types : std::uint8_t
+{
+    MKDIR,
+    SYMLINK,
+    RELINK,
+    UNLINK,
+    RMDIR,
+};
+
+
+/**
+ * @brief       A mutation of the destination directory planned from the difference between the
+ *              desired state and the actual state.
+ */
+struct file_operation
+{
+    file_operation_types op_type;
+
+    /** The path to create or to remove. For a link it has no shortcut extension. */
+    std::filesystem::path pth;
+
+    /** The target of a link. */
+    std::filesystem::path target_pth;
+
+    /** The categories file that requires the link, empty for the other operations. */
+    std::filesystem::path::string_type categories_file_pth;
+
+    /** The link, in the same directory, that a moved link replaces. It has a shortcut extension. */
+    std::filesystem::path previous_pth;
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,468 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/file_operation_ring.cpp
+ * @brief       file_operation_ring class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include "file_operation_ring.hpp"
+
+
+namespace classifier {
+
+
+file_operation_ring::file_operation_ring(directory_handle_cache* dir_handle_cche)
+        : dir_handle_cche_(dir_handle_cche)
+        , ring_fd_(-1)
+        , sq_rng_(nullptr)
+        , sq_rng_sz_(0)
+        , cq_rng_(nullptr)
+        , cq_rng_sz_(0)
+        , sqes_(nullptr)
+        , sqes_sz_(0)
+        , sq_hd_(nullptr)
+        , sq_tl_(nullptr)
+        , sq_msk_(nullptr)
+        , sq_arr_(nullptr)
+        , sq_entries_nbr_(0)
+        , cq_hd_(nullptr)
+        , cq_tl_(nullptr)
+        , cq_msk_(nullptr)
+        , cqes_(nullptr)
+        , sqe_tl_(0)
+        , queued_sqes_nbr_(0)
+        , pending_ops_()
+        , batch_pths_()
+        , batch_parent_pths_()
+{
+}
+
+
+file_operation_ring::~file_operation_ring()
+{
+    close();
+}
+
+
+bool file_operation_ring::open(unsigned queue_depth)
+{
+    io_uring_params params;
+    std::size_t probe_sz = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+    std::unique_ptr<unsigned char[]> probe_buf;
+    io_uring_probe* probe;
+    unsigned char* sq_rng_bytes;
+    unsigned char* cq_rng_bytes;
+
+    if (is_open())
+    {
+        return true;
+    }
+
+    std::memset(&params, 0, sizeof(params));
+    ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, queue_depth, &params));
+    if (ring_fd_ < 0)
+    {
+        ring_fd_ = -1;
+        return false;
+    }
+
+    sq_rng_sz_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_rng_sz_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        sq_rng_sz_ = cq_rng_sz_ = std::max(sq_rng_sz_, cq_rng_sz_);
+    }
+
+    sq_rng_ = ::mmap(nullptr, sq_rng_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_rng_ == MAP_FAILED)
+    {
+        sq_rng_ = nullptr;
+        close();
+        return false;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        cq_rng_ = sq_rng_;
+    }
+    else
+    {
+        cq_rng_ = ::mmap(nullptr, cq_rng_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_rng_ == MAP_FAILED)
+        {
+            cq_rng_ = nullptr;
+            close();
+            return false;
+        }
+    }
+
+    sqes_sz_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(::mmap(nullptr, sqes_sz_, PROT_READ | PROT_WRITE,
+                                              MAP_SHARED | MAP_POPULATE, ring_fd_,
+                                              IORING_OFF_SQES));
+    if (sqes_ == MAP_FAILED)
+    {
+        sqes_ = nullptr;
+        close();
+        return false;
+    }
+
+    sq_rng_bytes = static_cast<unsigned char*>(sq_rng_);
+    cq_rng_bytes = static_cast<unsigned char*>(cq_rng_);
+    sq_hd_ = reinterpret_cast<unsigned*>(sq_rng_bytes + params.sq_off.head);
+    sq_tl_ = reinterpret_cast<unsigned*>(sq_rng_bytes + params.sq_off.tail);
+    sq_msk_ = reinterpret_cast<unsigned*>(sq_rng_bytes + params.sq_off.ring_mask);
+    sq_arr_ = reinterpret_cast<unsigned*>(sq_rng_bytes + params.sq_off.array);
+    sq_entries_nbr_ = params.sq_entries;
+    cq_hd_ = reinterpret_cast<unsigned*>(cq_rng_bytes + params.cq_off.head);
+    cq_tl_ = reinterpret_cast<unsigned*>(cq_rng_bytes + params.cq_off.tail);
+    cq_msk_ = reinterpret_cast<unsigned*>(cq_rng_bytes + params.cq_off.ring_mask);
+    cqes_ = cq_rng_bytes + params.cq_off.cqes;
+    sqe_tl_ = *sq_tl_;
+
+    // The operations on paths need a 5.15 kernel, an older one gives a usable but useless ring.
+    probe_buf = std::make_unique<unsigned char[]>(probe_sz);
+    std::memset(probe_buf.get(), 0, probe_sz);
+    probe = reinterpret_cast<io_uring_probe*>(probe_buf.get());
+
+    if (::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_PROBE, probe, 256) < 0 ||
+        sq_entries_nbr_ < MAX_OPERATION_SQES_NBR)
+    {
+        close();
+        return false;
+    }
+
+    for (auto op : {IORING_OP_MKDIRAT, IORING_OP_SYMLINKAT, IORING_OP_UNLINKAT, IORING_OP_STATX})
+    {
+        if (probe->last_op < op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+        {
+            close();
+            return false;
+        }
+    }
+
+    pending_ops_.reserve(sq_entries_nbr_);
+
+    return true;
+}
+
+
+bool file_operation_ring::has_room_for(
+        const std::filesystem::path& pth,
+        const std::filesystem::path& previous_pth
+) const
+{
+    if (pending_ops_.empty())
+    {
+        return true;
+    }
+
+    if (pending_ops_.size() >= sq_entries_nbr_ ||
+        queued_sqes_nbr_ + MAX_OPERATION_SQES_NBR > sq_entries_nbr_)
+    {
+        return false;
+    }
+
+    // The operation must not run before the creation or the removal of its path or its parent,
+    // and a directory must not be removed before its content.
+    return !batch_pths_.contains(pth.native()) &&
+           !batch_pths_.contains(pth.parent_path().native()) &&
+           !batch_parent_pths_.contains(pth.native()) &&
+           (previous_pth.empty() || !batch_pths_.contains(previous_pth.native()));
+}
+
+
+void file_operation_ring::queue(
+        file_operation_types op_type,
+        const std::filesystem::path& pth,
+        const std::filesystem::path& target_pth,
+        const std::filesystem::path& previous_pth,
+        std::size_t tag
+)
+{
+    std::filesystem::path parent_pth = pth.parent_path();
+    std::uint64_t idx = pending_ops_.size();
+    io_uring_sqe* sqe;
+
+    if (pending_ops_.empty())
+    {
+        dir_handle_cche_->hold_handles();
+    }
+
+    pending_operation& op = pending_ops_.emplace_back();
+    op.tag = tag;
+    op.op_type = op_type;
+    op.parent_fd = dir_handle_cche_->get_handle(parent_pth);
+    op.nme = pth.filename();
+    op.target_pth = target_pth;
+    op.previous_nme = previous_pth.filename();
+    op.op_res = -ECANCELED;
+    op.stx_res = -ECANCELED;
+    op.previous_res = 0;
+    op.id = file_id();
+    op.succss = false;
+
+    batch_pths_.insert(pth.native());
+    batch_parent_pths_.insert(parent_pth.native());
+
+    if (!previous_pth.empty())
+    {
+        batch_pths_.insert(previous_pth.native());
+    }
+
+    if (op.parent_fd < 0 || !is_open())
+    {
+        op.op_res = -ENOENT;
+        return;
+    }
+
+    // The link replaced is removed first, the chain goes on even if it was already gone.
+    if (op_type == file_operation_types::RELINK)
+    {
+        sqe = get_sqe();
+        sqe->opcode = IORING_OP_UNLINKAT;
+        sqe->fd = op.parent_fd;
+        sqe->addr = reinterpret_cast<std::uintptr_t>(op.previous_nme.c_str());
+        sqe->flags |= IOSQE_IO_HARDLINK;
+        sqe->user_data = (idx << 2) | 2;
+    }
+
+    sqe = get_sqe();
+    sqe->fd = op.parent_fd;
+    sqe->user_data = idx << 2;
+
+    switch (op_type)
+    {
+        case file_operation_types::MKDIR:
+            sqe->opcode = IORING_OP_MKDIRAT;
+            sqe->addr = reinterpret_cast<std::uintptr_t>(op.nme.c_str());
+            sqe->len = 0777;
+            break;
+
+        case file_operation_types::SYMLINK:
+        case file_operation_types::RELINK:
+            sqe->opcode = IORING_OP_SYMLINKAT;
+            sqe->addr = reinterpret_cast<std::uintptr_t>(op.target_pth.c_str());
+            sqe->addr2 = reinterpret_cast<std::uintptr_t>(op.nme.c_str());
+            break;
+
+        case file_operation_types::UNLINK:
+        case file_operation_types::RMDIR:
+            sqe->opcode = IORING_OP_UNLINKAT;
+            sqe->addr = reinterpret_cast<std::uintptr_t>(op.nme.c_str());
+            sqe->unlink_flags = op_type == file_operation_types::RMDIR ? AT_REMOVEDIR : 0;
+
+            if (op_type == file_operation_types::RMDIR)
+            {
+                dir_handle_cche_->forget(pth);
+            }
+
+            return;
+    }
+
+    // The statx only runs if the creation succeeded.
+    sqe->flags |= IOSQE_IO_LINK;
+
+    sqe = get_sqe();
+    sqe->opcode = IORING_OP_STATX;
+    sqe->fd = op.parent_fd;
+    sqe->addr = reinterpret_cast<std::uintptr_t>(op.nme.c_str());
+    sqe->len = STATX_TYPE | STATX_INO;
+    sqe->off = reinterpret_cast<std::uintptr_t>(&op.stx);
+    sqe->statx_flags = AT_SYMLINK_NOFOLLOW;
+    sqe->user_data = (idx << 2) | 1;
+}
+
+
+io_uring_sqe* file_operation_ring::get_sqe()
+{
+    unsigned idx = sqe_tl_ & *sq_msk_;
+    io_uring_sqe* sqe = &sqes_[idx];
+
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    sq_arr_[idx] = idx;
+    ++sqe_tl_;
+    ++queued_sqes_nbr_;
+
+    return sqe;
+}
+
+
+void file_operation_ring::submit_and_wait()
+{
+    auto* cqes = static_cast<io_uring_cqe*>(cqes_);
+    unsigned to_submit = queued_sqes_nbr_;
+    unsigned completed_nbr = 0;
+    unsigned cq_hd;
+    long res;
+    struct stat st;
+
+    std::atomic_ref<unsigned>(*sq_tl_).store(sqe_tl_, std::memory_order_release);
+
+    while (completed_nbr < queued_sqes_nbr_)
+    {
+        res = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit, 1, IORING_ENTER_GETEVENTS,
+                        nullptr, 0);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            // The ring is unusable, the operations not completed stay failed and the next
+            // batches use plain system calls.
+            close();
+            break;
+        }
+
+        to_submit -= static_cast<unsigned>(res);
+        cq_hd = *cq_hd_;
+
+        while (cq_hd != std::atomic_ref<unsigned>(*cq_tl_).load(std::memory_order_acquire))
+        {
+            io_uring_cqe& cqe = cqes[cq_hd & *cq_msk_];
+            pending_operation& op = pending_ops_[cqe.user_data >> 2];
+
+            switch (cqe.user_data & 3)
+            {
+                case 0:
+                    op.op_res = cqe.res;
+                    break;
+
+                case 1:
+                    op.stx_res = cqe.res;
+                    break;
+
+                default:
+                    op.previous_res = cqe.res;
+                    break;
+            }
+
+            ++cq_hd;
+            ++completed_nbr;
+        }
+
+        std::atomic_ref<unsigned>(*cq_hd_).store(cq_hd, std::memory_order_release);
+    }
+
+    for (auto& op : pending_ops_)
+    {
+        switch (op.op_type)
+        {
+            case file_operation_types::MKDIR:
+                if (op.op_res == 0 && op.stx_res == 0)
+                {
+                    op.succss = S_ISDIR(op.stx.stx_mode);
+                    op.id = {makedev(op.stx.stx_dev_major, op.stx.stx_dev_minor),
+                             op.stx.stx_ino};
+                }
+                else if (op.op_res == -EEXIST &&
+                         ::fstatat(op.parent_fd, op.nme.c_str(), &st, AT_SYMLINK_NOFOLLOW) == 0)
+                {
+                    op.succss = S_ISDIR(st.st_mode);
+                    op.id = {static_cast<std::uint64_t>(st.st_dev),
+                             static_cast<std::uint64_t>(st.st_ino)};
+                }
+                break;
+
+            // A moved link fails if the link it replaces is still there.
+            case file_operation_types::SYMLINK:
+            case file_operation_types::RELINK:
+                if (op.op_res == 0 && op.stx_res == 0 &&
+                    (op.previous_res == 0 || op.previous_res == -ENOENT))
+                {
+                    op.succss = true;
+                    op.id = {makedev(op.stx.stx_dev_major, op.stx.stx_dev_minor),
+                             op.stx.stx_ino};
+                }
+                break;
+
+            case file_operation_types::UNLINK:
+            case file_operation_types::RMDIR:
+                op.succss = op.op_res == 0;
+                break;
+        }
+    }
+}
+
+
+void file_operation_ring::reset()
+{
+    pending_ops_.clear();
+    batch_pths_.clear();
+    batch_parent_pths_.clear();
+    queued_sqes_nbr_ = 0;
+    dir_handle_cche_->release_handles();
+}
+
+
+void file_operation_ring::close() noexcept
+{
+    if (sqes_ != nullptr)
+    {
+        ::munmap(sqes_, sqes_sz_);
+        sqes_ = nullptr;
+    }
+
+    if (cq_rng_ != nullptr && cq_rng_ != sq_rng_)
+    {
+        ::munmap(cq_rng_, cq_rng_sz_);
+    }
+
+    cq_rng_ = nullptr;
+
+    if (sq_rng_ != nullptr)
+    {
+        ::munmap(sq_rng_, sq_rng_sz_);
+        sq_rng_ = nullptr;
+    }
+
+    if (ring_fd_ >= 0)
+    {
+        ::close(ring_fd_);
+        ring_fd_ = -1;
+    }
+}
+
+
+}
+
+#endif
@@ -0,0 +1,243 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/file_operation_ring.hpp
+ * @brief       file_operation_ring class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_FILE_OPERATION_RING_HPP
+#define CLASSIFIER_FILE_OPERATION_RING_HPP
+
+#if defined(__linux__)
+
+#include <sys/stat.h>
+
+#include <filesystem>
+#include <unordered_set>
+#include <vector>
+
+#include "directory_handle_cache.hpp"
+#include "file_id.hpp"
+#include "file_operation.hpp"
+
+struct io_uring_sqe;
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Batched execution of the destination directory operations with io_uring. The
+ *              operations are queued relative to the handles of their parent directories and
+ *              submitted together, a created file being followed by a linked statx that gives its
+ *              identifier. An operation that depends on another one of the batch, like a link in a
+ *              directory created by the batch, first submits the batch. A moved link removes the
+ *              link it replaces before being created, in the same chain. The completions are
+ *              reported in the order in which the operations have been pushed.
+ */
+class file_operation_ring
+{
+public:
+    using string_type = std::filesystem::path::string_type;
+
+    /**
+     * @brief       Constructor with parameters.
+     * @param       dir_handle_cche : The cache providing the parent directory handles.
+     */
+    explicit file_operation_ring(directory_handle_cache* dir_handle_cche);
+
+    file_operation_ring(const file_operation_ring& rhs) = delete;
+
+    /**
+     * @brief       Destructor.
+     */
+    ~file_operation_ring();
+
+    file_operation_ring& operator =(const file_operation_ring& rhs) = delete;
+
+    /**
+     * @brief       Set up the ring. It fails if io_uring is not available or if the kernel does not
+     *              support all the operations needed, in which case plain system calls must be used.
+     * @param       queue_depth : The number of submission queue entries.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool open(unsigned queue_depth);
+
+    /**
+     * @brief       Check whether the ring is set up.
+     * @return      If the ring is set up true is returned, otherwise false is returned.
+     */
+    [[nodiscard]] bool is_open() const noexcept
+    {
+        return ring_fd_ >= 0;
+    }
+
+    /**
+     * @brief       Queue an operation, submitting the batch first if it is full or if the operation
+     *              depends on it.
+     * @param       op_type : The operation type.
+     * @param       pth : The file to create or to remove.
+     * @param       target_pth : The target of the link to create.
+     * @param       previous_pth : The link replaced by a moved link, in the same directory.
+     * @param       tag : The value given back to the completion callback.
+     * @param       completion_callback : The function called as callback(tag, succss, id) for every
+     *              operation of the batch submitted, if any.
+     */
+    template<typename CompletionCallbackT>
+    void push(
+            file_operation_types op_type,
+            const std::filesystem::path& pth,
+            const std::filesystem::path& target_pth,
+            const std::filesystem::path& previous_pth,
+            std::size_t tag,
+            CompletionCallbackT&& completion_callback
+    )
+    {
+        if (!has_room_for(pth, previous_pth))
+        {
+            flush(completion_callback);
+        }
+
+        queue(op_type, pth, target_pth, previous_pth, tag);
+    }
+
+    /**
+     * @brief       Submit the queued operations and wait for them to complete.
+     * @param       completion_callback : The function called as callback(tag, succss, id) for every
+     *              operation.
+     */
+    template<typename CompletionCallbackT>
+    void flush(CompletionCallbackT&& completion_callback)
+    {
+        submit_and_wait();
+
+        for (auto& x : pending_ops_)
+        {
+            completion_callback(x.tag, x.succss, x.id);
+        }
+
+        reset();
+    }
+
+private:
+    /**
+     * @brief       An operation queued in the current batch.
+     */
+    struct pending_operation
+    {
+        std::size_t tag;
+        file_operation_types op_type;
+        int parent_fd;
+        std::filesystem::path nme;
+        std::filesystem::path target_pth;
+        std::filesystem::path previous_nme;
+        struct statx stx;
+        int op_res;
+        int stx_res;
+
+        /** The result of the removal of the link replaced by a moved link. */
+        int previous_res;
+        file_id id;
+        bool succss;
+    };
+
+    /** The most entries an operation takes: a moved link is a removal, a creation and a statx. */
+    static constexpr unsigned MAX_OPERATION_SQES_NBR = 3;
+
+    bool has_room_for(
+            const std::filesystem::path& pth,
+            const std::filesystem::path& previous_pth
+    ) const;
+
+    void queue(
+            file_operation_types op_type,
+            const std::filesystem::path& pth,
+            const std::filesystem::path& target_pth,
+            const std::filesystem::path& previous_pth,
+            std::size_t tag
+    );
+
+    io_uring_sqe* get_sqe();
+
+    void submit_and_wait();
+
+    void reset();
+
+    void close() noexcept;
+
+    directory_handle_cache* dir_handle_cche_;
+
+    int ring_fd_;
+
+    void* sq_rng_;
+
+    std::size_t sq_rng_sz_;
+
+    void* cq_rng_;
+
+    std::size_t cq_rng_sz_;
+
+    io_uring_sqe* sqes_;
+
+    std::size_t sqes_sz_;
+
+    unsigned* sq_hd_;
+
+    unsigned* sq_tl_;
+
+    unsigned* sq_msk_;
+
+    unsigned* sq_arr_;
+
+    unsigned sq_entries_nbr_;
+
+    unsigned* cq_hd_;
+
+    unsigned* cq_tl_;
+
+    unsigned* cq_msk_;
+
+    void* cqes_;
+
+    /** The submission queue tail not yet published to the kernel. */
+    unsigned sqe_tl_;
+
+    /** The number of entries queued in the current batch. */
+    unsigned queued_sqes_nbr_;
+
+    /** The operations of the current batch, reserved to the queue depth so they never move. */
+    std::vector<pending_operation> pending_ops_;
+
+    /** The paths created or removed by the current batch. */
+    std::unordered_set<string_type> batch_pths_;
+
+    /** The parent directories of the paths of the current batch. */
+    std::unordered_set<string_type> batch_parent_pths_;
+};
+
+
+}
+
+#endif
+
+
+#endif
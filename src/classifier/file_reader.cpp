@@ -0,0 +1,217 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/file_reader.cpp
+ * @brief       file_reader class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+
+#include "file_reader.hpp"
+
+
+namespace classifier {
+
+
+file_reader::file_reader() noexcept
+        : buf_()
+        , buf_cap_(0)
+        , mppd_(nullptr)
+        , mppd_sz_(0)
+        , contnt_(nullptr)
+        , contnt_sz_(0)
+{
+}
+
+
+file_reader::~file_reader()
+{
+    unmap();
+}
+
+
+bool file_reader::read(const std::filesystem::path& file_pth, std::size_t sz_hint)
+{
+    unmap();
+    contnt_ = nullptr;
+    contnt_sz_ = 0;
+
+#if defined(_WIN32)
+    std::ifstream ifstr(file_pth, std::ios::binary | std::ios::ate);
+    std::streamoff sz;
+
+    (void)sz_hint;
+
+    if (!ifstr.is_open() || (sz = ifstr.tellg()) < 0)
+    {
+        return false;
+    }
+
+    reserve(static_cast<std::size_t>(sz));
+    ifstr.seekg(0);
+    if (!ifstr.read(buf_.get(), sz))
+    {
+        return false;
+    }
+
+    contnt_ = buf_.get();
+    contnt_sz_ = static_cast<std::size_t>(sz);
+
+    return true;
+
+#else
+    int fd = ::open(file_pth.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat st;
+    ssize_t red_sz;
+    std::size_t sz = 0;
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (sz_hint >= MMAP_THRESHOLD)
+    {
+        // The size must be exact, touching a mapping past the end of the file is fatal.
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        sz = static_cast<std::size_t>(st.st_size);
+        if (sz >= MMAP_THRESHOLD)
+        {
+            mppd_ = ::mmap(nullptr, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+
+            if (mppd_ == MAP_FAILED)
+            {
+                mppd_ = nullptr;
+                return false;
+            }
+
+            ::madvise(mppd_, sz, MADV_SEQUENTIAL);
+            mppd_sz_ = sz;
+            contnt_ = static_cast<const char*>(mppd_);
+            contnt_sz_ = sz;
+
+            return true;
+        }
+
+        sz_hint = sz;
+        sz = 0;
+    }
+
+    // One byte more than expected, so that a file of the expected size fills the buffer in one
+    // call, the next one only sees its end.
+    reserve(sz_hint + 1);
+
+    for (;;)
+    {
+        if (sz == buf_cap_)
+        {
+            reserve(buf_cap_ * 2);
+        }
+
+        red_sz = ::read(fd, buf_.get() + sz, buf_cap_ - sz);
+        if (red_sz < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            ::close(fd);
+            return false;
+        }
+
+        if (red_sz == 0)
+        {
+            break;
+        }
+
+        sz += static_cast<std::size_t>(red_sz);
+    }
+
+    // The hint is the size of the file when it was signed, a different size is checked against
+    // the file itself, which is then being written if they do not match either.
+    if (sz != sz_hint && (::fstat(fd, &st) != 0 ||
+                          (S_ISREG(st.st_mode) && static_cast<std::size_t>(st.st_size) != sz)))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    ::close(fd);
+    contnt_ = buf_.get();
+    contnt_sz_ = sz;
+
+    return true;
+#endif
+}
+
+
+void file_reader::reserve(std::size_t sz)
+{
+    std::unique_ptr<char[]> new_buf;
+
+    if (sz <= buf_cap_)
+    {
+        return;
+    }
+
+    new_buf = std::make_unique_for_overwrite<char[]>(sz);
+    if (buf_cap_ > 0)
+    {
+        std::copy(buf_.get(), buf_.get() + buf_cap_, new_buf.get());
+    }
+
+    buf_ = std::move(new_buf);
+    buf_cap_ = sz;
+}
+
+
+void file_reader::unmap() noexcept
+{
+#if !defined(_WIN32)
+    if (mppd_ != nullptr)
+    {
+        ::munmap(mppd_, mppd_sz_);
+        mppd_ = nullptr;
+        mppd_sz_ = 0;
+    }
+#endif
+}
+
+
+}
@@ -0,0 +1,110 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/file_reader.hpp
+ * @brief       file_reader class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_FILE_READER_HPP
+#define CLASSIFIER_FILE_READER_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Reader of whole files meant to be reused for many files. A small file is read up to
+ *              its end into a buffer that grows but is never freed between files, a large file is
+ *              memory mapped. The content stays valid until the next read.
+ */
+class file_reader
+{
+public:
+    /** The size from which the files are memory mapped instead of read. */
+    static constexpr std::size_t MMAP_THRESHOLD = 256 * 1024;
+
+    /**
+     * @brief       Default constructor.
+     */
+    file_reader() noexcept;
+
+    file_reader(const file_reader& rhs) = delete;
+
+    /**
+     * @brief       Destructor.
+     */
+    ~file_reader();
+
+    file_reader& operator =(const file_reader& rhs) = delete;
+
+    /**
+     * @brief       Read a whole file.
+     * @param       file_pth : The path of the file to read.
+     * @param       sz_hint : The expected size of the file, it saves a stat call when it is right.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool read(const std::filesystem::path& file_pth, std::size_t sz_hint);
+
+    /**
+     * @brief       Get the content of the last file read.
+     * @return      The content of the last file read.
+     */
+    [[nodiscard]] std::string_view get_content() const noexcept
+    {
+        return {contnt_, contnt_sz_};
+    }
+
+private:
+    /**
+     * @brief       Ensure the buffer can hold a given number of bytes.
+     * @param       sz : The number of bytes.
+     */
+    void reserve(std::size_t sz);
+
+    /**
+     * @brief       Release the mapping of the last file read, if any.
+     */
+    void unmap() noexcept;
+
+    std::unique_ptr<char[]> buf_;
+
+    std::size_t buf_cap_;
+
+    void* mppd_;
+
+    std::size_t mppd_sz_;
+
+    const char* contnt_;
+
+    std::size_t contnt_sz_;
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,110 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/flat_json_parser.hpp
+ * @brief       flat_json_parser class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_FLAT_JSON_PARSER_HPP
+#define CLASSIFIER_FLAT_JSON_PARSER_HPP
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "category_list.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       The instruction sets the flat JSON parser can use to index a document.
+ */
+enum class simd_levels : std::uint8_t
+{
+    SCALAR,
+    SSE42,
+};
+
+
+/**
+ * @brief       Two stage parser specialised to the documents that category_list can hold: an
+ *              object whose values are strings, integers, booleans or arrays of them. The first
+ *              stage classifies the document 64 bytes at a time with SIMD instructions and builds
+ *              the index of its structural characters, strings and literals. The second stage walks
+ *              the index and appends the tokens. Anything outside that shape, as escape sequences,
+ *              floating point numbers, null or nested objects, is refused so that the generic
+ *              parser handles it, and so is an invalid document.
+ */
+class flat_json_parser
+{
+public:
+    /**
+     * @brief       Constructor with parameters.
+     * @param       simd_lvl : The instruction set to use, lowered to the best one the CPU supports.
+     */
+    explicit flat_json_parser(simd_levels simd_lvl = simd_levels::SSE42);
+
+    /**
+     * @brief       Parse a document, appending its tokens to a category list.
+     * @param       contnt : The document.
+     * @param       categories : The list to fill. It is left in an unspecified state on failure.
+     * @return      If the document has been parsed true is returned, otherwise false is returned.
+     */
+    bool parse(std::string_view contnt, category_list* categories);
+
+    /**
+     * @brief       Get the instruction set used by the parser.
+     * @return      The instruction set used by the parser.
+     */
+    [[nodiscard]] simd_levels get_simd_level() const noexcept
+    {
+        return simd_lvl_;
+    }
+
+    /**
+     * @brief       Get the best instruction set supported by the CPU.
+     * @return      The best instruction set supported by the CPU.
+     */
+    static simd_levels get_supported_simd_level() noexcept;
+
+private:
+    bool index_structurals(std::string_view contnt);
+
+    bool parse_value(std::string_view contnt, std::size_t* idx, category_list* categories);
+
+    simd_levels simd_lvl_;
+
+    /** The positions of the structural characters, of the quotes and of the literal starts, the
+     *  storage being kept between documents so it is not filled again each time. */
+    std::vector<std::uint32_t> structurals_;
+
+    /** The number of positions stored in the structurals vector for the current document. */
+    std::size_t structurals_nbr_;
+};
+
+
+}
+
+
+#endif
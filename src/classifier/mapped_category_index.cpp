@@ -0,0 +1,265 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier/mapped_category_index.cpp
+ * @brief       mapped_category_index class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <cstring>
+
+#include "mapped_category_index.hpp"
+
+
+namespace classifier {
+
+
+namespace {
+
+
+template<typename T>
+bool read_value(std::string_view contnt, std::size_t* offst, T* val)
+{
+    if (*offst > contnt.size() || contnt.size() - *offst < sizeof(T))
+    {
+        return false;
+    }
+
+    std::memcpy(val, contnt.data() + *offst, sizeof(T));
+    *offst += sizeof(T);
+
+    return true;
+}
+
+
+}
+
+
+bool mapped_category_index::open(const std::filesystem::path& index_file_pth)
+{
+    std::size_t offst = sizeof(category_index::FILE_MAGIC);
+    std::uint32_t versn;
+    std::uint64_t footer_offst;
+    std::size_t tables_sz;
+
+    close();
+
+    // The hint makes large indexes memory mapped right away.
+    if (!readr_.read(index_file_pth, file_reader::MMAP_THRESHOLD))
+    {
+        return false;
+    }
+
+    contnt_ = readr_.get_content();
+    if (contnt_.size() < sizeof(category_index::FILE_MAGIC) + sizeof(footer_offst) ||
+        std::memcmp(contnt_.data(), category_index::FILE_MAGIC,
+                    sizeof(category_index::FILE_MAGIC)) != 0 ||
+        !read_value(contnt_, &offst, &versn) || versn != category_index::FILE_VERSION)
+    {
+        goto error;
+    }
+
+    offst = contnt_.size() - sizeof(footer_offst);
+    read_value(contnt_, &offst, &footer_offst);
+    if (footer_offst > contnt_.size() - sizeof(footer_offst))
+    {
+        goto error;
+    }
+
+    offst = static_cast<std::size_t>(footer_offst);
+    if (!read_value(contnt_, &offst, &nmes_nbr_) || !read_value(contnt_, &offst, &ctgries_nbr_) ||
+        !read_value(contnt_, &offst, &entries_nbr_))
+    {
+        goto error;
+    }
+
+    tables_sz = (std::size_t(nmes_nbr_) + ctgries_nbr_ + entries_nbr_) * sizeof(std::uint64_t) +
+                ctgries_nbr_ * sizeof(std::uint32_t);
+    if (contnt_.size() - sizeof(footer_offst) - offst != tables_sz)
+    {
+        goto error;
+    }
+
+    nme_offsts_pos_ = offst;
+    ctgry_offsts_pos_ = nme_offsts_pos_ + nmes_nbr_ * sizeof(std::uint64_t);
+    entry_offsts_pos_ = ctgry_offsts_pos_ + ctgries_nbr_ * sizeof(std::uint64_t);
+    sorted_ctgry_ids_pos_ = entry_offsts_pos_ + entries_nbr_ * sizeof(std::uint64_t);
+
+    return true;
+
+error:
+    close();
+    return false;
+}
+
+
+std::uint32_t mapped_category_index::find_category(
+        std::uint32_t key_ctgry_id,
+        std::string_view nme
+) const
+{
+    std::uint32_t lo = 0;
+    std::uint32_t hi = ctgries_nbr_;
+    std::uint32_t mid;
+    std::uint32_t ctgry_id;
+    std::uint32_t mid_key_ctgry_id;
+    std::string_view mid_nme;
+
+    // The categories are sorted by key category and then by name, as save writes them.
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        ctgry_id = get_sorted_category(mid);
+        mid_key_ctgry_id = get_key_category(ctgry_id);
+        mid_nme = get_category_name(ctgry_id);
+
+        if (mid_key_ctgry_id == key_ctgry_id && mid_nme == nme)
+        {
+            return ctgry_id;
+        }
+
+        if (mid_key_ctgry_id < key_ctgry_id || (mid_key_ctgry_id == key_ctgry_id && mid_nme < nme))
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return NPOS;
+}
+
+
+std::string_view mapped_category_index::get_entry_path(std::uint32_t entry_id) const noexcept
+{
+    return entry_id < entries_nbr_ ? get_string(get_offset(entry_offsts_pos_, entry_id)) :
+                                     std::string_view();
+}
+
+
+std::uint32_t mapped_category_index::get_key_category(std::uint32_t ctgry_id) const noexcept
+{
+    std::size_t offst;
+    std::uint32_t key_ctgry_id = NPOS;
+
+    if (ctgry_id < ctgries_nbr_)
+    {
+        offst = static_cast<std::size_t>(get_offset(ctgry_offsts_pos_, ctgry_id));
+        read_value(contnt_, &offst, &key_ctgry_id);
+    }
+
+    return key_ctgry_id;
+}
+
+
+std::string_view mapped_category_index::get_category_name(std::uint32_t ctgry_id) const noexcept
+{
+    std::size_t offst;
+    std::uint32_t nme_id = NPOS;
+
+    if (ctgry_id >= ctgries_nbr_)
+    {
+        return {};
+    }
+
+    offst = static_cast<std::size_t>(get_offset(ctgry_offsts_pos_, ctgry_id)) +
+            sizeof(std::uint32_t);
+    if (!read_value(contnt_, &offst, &nme_id) || nme_id >= nmes_nbr_)
+    {
+        return {};
+    }
+
+    return get_string(get_offset(nme_offsts_pos_, nme_id));
+}
+
+
+roaring_bitmap mapped_category_index::get_category_entries(std::uint32_t ctgry_id) const
+{
+    roaring_bitmap entries;
+    std::size_t offst;
+
+    if (ctgry_id < ctgries_nbr_)
+    {
+        offst = static_cast<std::size_t>(get_offset(ctgry_offsts_pos_, ctgry_id)) +
+                2 * sizeof(std::uint32_t);
+        entries.deserialize(contnt_, &offst);
+    }
+
+    return entries;
+}
+
+
+void mapped_category_index::close() noexcept
+{
+    contnt_ = {};
+    nmes_nbr_ = 0;
+    ctgries_nbr_ = 0;
+    entries_nbr_ = 0;
+    nme_offsts_pos_ = 0;
+    ctgry_offsts_pos_ = 0;
+    entry_offsts_pos_ = 0;
+    sorted_ctgry_ids_pos_ = 0;
+}
+
+
+std::uint64_t mapped_category_index::get_offset(
+        std::size_t offsts_pos,
+        std::uint32_t idx
+) const noexcept
+{
+    std::size_t offst = offsts_pos + idx * sizeof(std::uint64_t);
+    std::uint64_t val = 0;
+
+    read_value(contnt_, &offst, &val);
+
+    return val;
+}
+
+
+std::uint32_t mapped_category_index::get_sorted_category(std::uint32_t idx) const noexcept
+{
+    std::size_t offst = sorted_ctgry_ids_pos_ + idx * sizeof(std::uint32_t);
+    std::uint32_t ctgry_id = NPOS;
+
+    read_value(contnt_, &offst, &ctgry_id);
+
+    return ctgry_id;
+}
+
+
+std::string_view mapped_category_index::get_string(std::uint64_t offst) const noexcept
+{
+    auto pos = static_cast<std::size_t>(offst);
+    std::uint32_t str_len;
+
+    if (!read_value(contnt_, &pos, &str_len) || contnt_.size() - pos < str_len)
+    {
+        return {};
+    }
+
+    return contnt_.substr(pos, str_len);
+}
+
+
+}
@@ -0,0 +1,166 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier/mapped_category_index.hpp
+ * @brief       mapped_category_index class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_MAPPED_CATEGORY_INDEX_HPP
+#define CLASSIFIER_MAPPED_CATEGORY_INDEX_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+#include "category_index.hpp"
+#include "file_reader.hpp"
+#include "roaring_bitmap.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Read only view of an index file saved by category_index. The file is memory mapped
+ *              and only the records reached by a lookup are decoded, through the offsets kept at
+ *              the end of the file, so that a query is answered without loading the whole index.
+ *              It offers the accessors of category_index that category_query relies on.
+ */
+class mapped_category_index
+{
+public:
+    /** The value returned when an entry or a category is not in the index. */
+    static constexpr std::uint32_t NPOS = category_index::NPOS;
+
+    /**
+     * @brief       Default constructor.
+     */
+    mapped_category_index() = default;
+
+    mapped_category_index(const mapped_category_index& rhs) = delete;
+
+    mapped_category_index& operator =(const mapped_category_index& rhs) = delete;
+
+    /**
+     * @brief       Open an index file, replacing the current one. Only the header and the footer
+     *              of the file are checked, a damaged record reads as empty.
+     * @param       index_file_pth : The path of the index file.
+     * @return      If function was successful true is returned, otherwise false is returned and
+     *              the index is left empty.
+     */
+    bool open(const std::filesystem::path& index_file_pth);
+
+    /**
+     * @brief       Get the identifier of a category, by binary search over the sorted categories.
+     * @param       key_ctgry_id : The category of the key for a value, NPOS for a key.
+     * @param       nme : The name of the key or of the value.
+     * @return      The identifier of the category if found, otherwise NPOS.
+     */
+    [[nodiscard]] std::uint32_t find_category(std::uint32_t key_ctgry_id,
+                                              std::string_view nme) const;
+
+    /**
+     * @brief       Get the path of an entry.
+     * @param       entry_id : The identifier of the entry.
+     * @return      The path of the entry directory.
+     */
+    [[nodiscard]] std::string_view get_entry_path(std::uint32_t entry_id) const noexcept;
+
+    /**
+     * @brief       Get the category of the key of a category.
+     * @param       ctgry_id : The identifier of the category.
+     * @return      The identifier of the category of the key for a value, NPOS for a key.
+     */
+    [[nodiscard]] std::uint32_t get_key_category(std::uint32_t ctgry_id) const noexcept;
+
+    /**
+     * @brief       Get the name of a category.
+     * @param       ctgry_id : The identifier of the category.
+     * @return      The name of the key or of the value.
+     */
+    [[nodiscard]] std::string_view get_category_name(std::uint32_t ctgry_id) const noexcept;
+
+    /**
+     * @brief       Decode the entries of a category.
+     * @param       ctgry_id : The identifier of the category.
+     * @return      The identifiers of the entries linked in the directory of the category.
+     */
+    [[nodiscard]] roaring_bitmap get_category_entries(std::uint32_t ctgry_id) const;
+
+    /**
+     * @brief       Get the number of entries.
+     * @return      The number of entries.
+     */
+    [[nodiscard]] std::size_t get_entries_number() const noexcept
+    {
+        return entries_nbr_;
+    }
+
+    /**
+     * @brief       Get the number of categories.
+     * @return      The number of categories.
+     */
+    [[nodiscard]] std::size_t get_categories_number() const noexcept
+    {
+        return ctgries_nbr_;
+    }
+
+    /**
+     * @brief       Release the file and empty the index.
+     */
+    void close() noexcept;
+
+private:
+    [[nodiscard]] std::uint64_t get_offset(std::size_t offsts_pos, std::uint32_t idx) const noexcept;
+
+    [[nodiscard]] std::uint32_t get_sorted_category(std::uint32_t idx) const noexcept;
+
+    [[nodiscard]] std::string_view get_string(std::uint64_t offst) const noexcept;
+
+private:
+    /** The reader holding the content of the file. */
+    file_reader readr_;
+
+    std::string_view contnt_;
+
+    std::uint32_t nmes_nbr_ = 0;
+
+    std::uint32_t ctgries_nbr_ = 0;
+
+    std::uint32_t entries_nbr_ = 0;
+
+    /** The positions of the offset tables and of the sorted categories in the footer. */
+    std::size_t nme_offsts_pos_ = 0;
+
+    std::size_t ctgry_offsts_pos_ = 0;
+
+    std::size_t entry_offsts_pos_ = 0;
+
+    std::size_t sorted_ctgry_ids_pos_ = 0;
+};
+
+
+}
+
+
+#endif
@@ -24,9 +24,36 @@
  * @date        2024/10/15
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/sysmacros.h>
+#endif
 
+#include "catalog_reader.hpp"
+#include "cpu_quota.hpp"
+#include "directory_scanner.hpp"
+#include "directory_walker.hpp"
+#include "file_reader.hpp"
 #include "json.hpp"
+#include "mapped_category_index.hpp"
 #include "program.hpp"
 
 
@@ -35,42 +62,225 @@ namespace classifier {
 
 program::program(program_args&& prog_args)
         : prog_args_(std::move(prog_args))
-        , inode_st_()
-        , extra_files_fnd_(false)
+        , file_id_st_()
+        , previous_stte_()
+        , current_stte_()
+        , categories_cche_()
+        , recycled_categories_que_(QUEUE_CAPACITY)
+        , next_seq_nbr_(0)
+        , catalog_sig_()
+        , current_entry_pth_()
+        , current_entry_stte_()
+        , plan_()
+        , previous_indx_()
+        , indx_()
+        , previous_ctgry_ids_()
+        , category_dirs_()
+        , entry_nmes_()
+        , planned_shortcuts_()
+        , current_entry_nme_()
+        , current_entry_nme_id_(0)
+        , current_entry_lnk_nme_()
+        , current_entry_dirs_()
+        , current_entry_lnk_dirs_()
+        , current_entry_ctgries_()
+        , destination_prefix_len_(0)
+        , extra_fles_()
+        , state_file_pth_()
+        , cache_file_pth_()
+        , index_file_pth_()
+        , forced_pths_()
+        , retried_pths_()
+        , previous_entry_dirs_()
+        , previous_entry_dirs_built_(false)
+        , moved_entry_pths_()
+        , moved_entries_()
+#if !defined(_WIN32)
+        , dir_handle_cche_(DIRECTORY_HANDLES_CAPACITY)
+#endif
+#if defined(__linux__)
+        , file_op_rng_(&dir_handle_cche_)
+        , source_watchr_(prog_args_.source_dir, prog_args_.categories_file_nme)
+        , daemn_servr_([this](const std::filesystem::path& entry_pth, std::uint64_t* posted_nbr)
+        {
+            return post_reclassification(entry_pth, posted_nbr);
+        })
+#endif
 {
 }
 
 
 int program::execute()
 {
+    bool previous_stte_loadd = false;
+
 #if defined(_WIN32)
     SetConsoleOutputCP(CP_UTF8);
 #endif
-    escape_special_characters_in_regex_string(prog_args_.categories_file_nme);
+    if (!prog_args_.query_expr.empty())
+    {
+        return execute_query();
+    }
+
+    if (!prog_args_.destination_dir.empty())
+    {
+        state_file_pth_ = prog_args_.destination_dir / state_file::FILE_NAME;
+        cache_file_pth_ = prog_args_.destination_dir / categories_cache::FILE_NAME;
+        index_file_pth_ = prog_args_.destination_dir / category_index::FILE_NAME;
+        destination_prefix_len_ = (prog_args_.destination_dir / "").native().size();
+#if !defined(_WIN32)
+        dir_handle_cche_.set_root(prog_args_.destination_dir);
+#endif
+
+        if (!prog_args_.rebuild && previous_stte_.load(state_file_pth_))
+        {
+            previous_stte_loadd = true;
+            file_id_st_.reserve(previous_stte_.get_file_ids_number());
+            previous_indx_.load(index_file_pth_);
+            previous_ctgry_ids_.assign(previous_indx_.get_categories_number(),
+                                       category_index::NPOS);
+        }
+
+        // The cache only depends on the categories files, a rebuild uses it as well.
+        categories_cche_.load(cache_file_pth_);
+    }
+
+    if (!prog_args_.views_fle.empty() && !load_views())
+    {
+        std::cout << spd::ios::set_light_red_text
+                  << "Unable to read the views file: "
+                  << spd::ios::set_white_text
+                  << "\""
+                  << spd::cast::type_cast<std::string>(prog_args_.views_fle.c_str())
+                  << "\""
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
+
+        return 1;
+    }
+
+    // The daemon keeps the destination directory up to date like the watch mode.
+    if (prog_args_.daemon)
+    {
+        prog_args_.watch = true;
+    }
+
+    // The source directory is watched before it is scanned, the changes made during the first run
+    // are handled right after it.
+    if (prog_args_.watch)
+    {
+#if defined(__linux__)
+        if (!prog_args_.catalog_fle.empty() || prog_args_.dry_run)
+        {
+            std::cout << spd::ios::set_light_red_text
+                      << "The watch mode cannot be used with a catalog or a dry run"
+                      << spd::ios::set_default_text
+                      << spd::ios::newl;
+
+            return 1;
+        }
+
+        if (!source_watchr_.open())
+        {
+            std::cout << spd::ios::set_light_red_text
+                      << "Unable to watch the source directory: "
+                      << spd::ios::set_white_text
+                      << "\""
+                      << spd::cast::type_cast<std::string>(prog_args_.source_dir.c_str())
+                      << "\"";
+
+            if (source_watchr_.get_failure_reason() != nullptr)
+            {
+                std::cout << spd::ios::set_light_red_text
+                          << " ("
+                          << source_watchr_.get_failure_reason()
+                          << ")";
+            }
+
+            std::cout << spd::ios::set_default_text
+                      << spd::ios::newl;
+
+            return 1;
+        }
+#else
+        std::cout << spd::ios::set_light_red_text
+                  << "The watch mode is only available on Linux"
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
+
+        return 1;
+#endif
+    }
+
+    // Nothing is applied from a catalog read partially, its missing entries would be undone.
+    if (prog_args_.catalog_fle.empty())
+    {
+        classify_source_directory();
+    }
+    else if (!classify_catalog())
+    {
+        std::cout << spd::ios::set_light_red_text
+                  << "Unable to read the catalog file: "
+                  << spd::ios::set_white_text
+                  << "\""
+                  << spd::cast::type_cast<std::string>(prog_args_.catalog_fle.c_str())
+                  << "\""
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
+
+        return 1;
+    }
 
-    spd::fsys::directory_iteration source_dir_iteration(prog_args_.source_dir);
-    source_dir_iteration.regex_to_match(prog_args_.categories_file_nme)
-                        .file_types(spd::sys::fsys::file_types::REGULAR_FILE);
+    plan_views();
 
-    spd::fsys::directory_iteration destination_dir_iteration(prog_args_.destination_dir);
-    destination_dir_iteration.follow_symbolic_links(false)
-                             .access_modes(spd::sys::fsys::access_modes::WRITE |
-                                           spd::sys::fsys::access_modes::READ)
-                             .regex_to_match(R"(^([^\.]*|.*\.lnk|.*\.ini)$)");
+    // The links that the state records for the entries that changed or disappeared are found
+    // without reading the destination directory, unless the whole of it is audited.
+    if (previous_stte_loadd && !prog_args_.audit)
+    {
+        plan_stale_files();
+    }
 
-    for (auto& x : source_dir_iteration)
+    if (prog_args_.dry_run)
     {
-        parse_categories_file(x);
+        print_plan();
+        extra_fles_.clear();
     }
+    else
+    {
+        apply_plan();
+        configure_directory(prog_args_.destination_dir);
 
-    configure_directory(prog_args_.destination_dir);
+        for (auto& x : extra_fles_)
+        {
+            print_stale_file(x);
+        }
+    }
 
-    for (auto& x : destination_dir_iteration)
+    plan_.clear();
+    category_dirs_.clear();
+    entry_nmes_.clear();
+    planned_shortcuts_.clear();
+    previous_stte_.clear();
+    previous_indx_.clear();
+    previous_ctgry_ids_.clear();
+    previous_entry_dirs_.clear();
+    previous_entry_dirs_built_ = false;
+    moved_entry_pths_.clear();
+    moved_entries_.clear();
+
+    // Without a state to rely on, or when asked to, the whole destination directory is audited
+    // for the files that this run did not produce.
+    if (!previous_stte_loadd || prog_args_.audit)
     {
-        check_extra_file(x);
+        directory_walker::walk(prog_args_.destination_dir,
+                               [&](const std::filesystem::path& file_pth, const file_id& id,
+                                   bool is_directory)
+        {
+            check_extra_file(file_pth, id, is_directory);
+        });
     }
 
-    if (extra_files_fnd_)
+    if (!extra_fles_.empty() && !prog_args_.dry_run)
     {
         int inpt;
 
@@ -83,12 +293,11 @@ int program::execute()
         inpt = getc(stdin);
         spd::sys::term::flush_input_terminal(stdin);
 
+        // The directories are found before their content, so deleting in reverse order empties
+        // every extra directory before it is removed.
         if (inpt == 'y')
         {
-            for (auto& x : destination_dir_iteration)
-            {
-                delete_extra_file(x);
-            }
+            delete_extra_files();
         }
         else
         {
@@ -99,247 +308,1964 @@ int program::execute()
         }
     }
 
+    extra_fles_.clear();
+
+    // The state is saved once the deletions are done, the stale files left in place are reported
+    // again by the next run.
+    if (!prog_args_.dry_run)
+    {
+        save_run_files();
+    }
+
+    // The watch mode keeps the cache, the passes only append the categories files they parse.
+    if (!prog_args_.watch)
+    {
+        categories_cche_.clear();
+    }
+
+#if defined(__linux__)
+    if (prog_args_.watch)
+    {
+        current_stte_.track_changes();
+
+        return watch_source_directory();
+    }
+#endif
+
     return 0;
 }
 
 
-bool program::parse_categories_file(const std::filesystem::path& categories_file_pth)
+int program::execute_query()
 {
-    std::ifstream ifstr;
-    json json_parsr;
-
-    std::cout << spd::ios::set_light_cyan_text
-              << "Parsing categories file: "
-              << spd::ios::set_white_text
-              << "\""
-              << spd::cast::type_cast<std::string>(categories_file_pth.c_str())
-              << "\" "
-              << spd::ios::set_default_text
-              << std::flush;
+    std::filesystem::path index_file_pth = prog_args_.destination_dir / category_index::FILE_NAME;
+    mapped_category_index indx;
+    category_query qury;
+    roaring_bitmap entry_ids;
 
-    ifstr.open(categories_file_pth);
-    if (!ifstr.is_open())
+    if (!qury.parse(prog_args_.query_expr))
     {
-        goto error;
-    }
+        std::cout << spd::ios::set_light_red_text
+                  << "Invalid query expression: "
+                  << spd::ios::set_white_text
+                  << "\""
+                  << prog_args_.query_expr
+                  << "\""
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
 
-    json_parsr = json::parse(ifstr);
-    if (!parse_entries(json_parsr, categories_file_pth.parent_path()))
-    {
-        ifstr.close();
-        goto error;
+        return 1;
     }
 
-    std::cout << spd::ios::set_light_green_text << "[ok]"
-              << spd::ios::set_default_text << std::endl;
+    // Neither the categories files nor the destination tree are read, only the index saved by the
+    // last run, whose posting lists are decoded on demand.
+    if (!indx.open(index_file_pth))
+    {
+        std::cout << spd::ios::set_light_red_text
+                  << "Unable to read the index file: "
+                  << spd::ios::set_white_text
+                  << "\""
+                  << spd::cast::type_cast<std::string>(index_file_pth.c_str())
+                  << "\""
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
 
-    ifstr.close();
+        return 1;
+    }
 
-    return true;
+    entry_ids = qury.evaluate(indx);
+    entry_ids.for_each([&](std::uint32_t entry_id)
+    {
+        std::cout << indx.get_entry_path(entry_id) << '\n';
+    });
 
-error:
-    std::cout << spd::ios::set_light_red_text << "[fail]"
-              << spd::ios::set_default_text << std::endl;
+    std::cout << std::flush;
 
-    return false;
+    return 0;
 }
 
 
-bool program::parse_entries(json& json_parsr, const std::filesystem::path& current_source_dir)
+void program::save_run_files()
 {
-    std::filesystem::path current_destination_dir;
-    std::string key_str;
+    // Once the watch mode tracks the changes, only the entries and the categories files classified
+    // again are written. The index is still written in full, the queries map it as it is.
+    if (!state_file_pth_.empty() && !current_stte_.save_changes(state_file_pth_))
+    {
+        std::cout << spd::ios::set_light_red_text
+                  << "Unable to save the state file: "
+                  << spd::ios::set_white_text
+                  << "\""
+                  << spd::cast::type_cast<std::string>(state_file_pth_.c_str())
+                  << "\""
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
+    }
 
-    for (auto it = json_parsr.begin(); it != json_parsr.end(); ++it)
+    if (!cache_file_pth_.empty() && !categories_cche_.append(cache_file_pth_))
     {
-        key_str = it.key();
-        current_destination_dir = prog_args_.destination_dir;
+        std::cout << spd::ios::set_light_red_text
+                  << "Unable to save the cache file: "
+                  << spd::ios::set_white_text
+                  << "\""
+                  << spd::cast::type_cast<std::string>(cache_file_pth_.c_str())
+                  << "\""
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
+    }
 
-        if (key_str == "Icon")
-        {
-            if (!parse_icon(it.value(), current_source_dir, current_destination_dir))
-            {
-                std::cout << spd::ios::set_light_red_text
-                          << "[Icon fail] "
-                          << spd::ios::set_default_text;
-            }
-        }
-        else
-        {
-            current_destination_dir /= spd::cast::type_cast<string_type>(key_str);
-            if (!make_directory(current_destination_dir) ||
-                !parse_value(it.value(), current_source_dir, current_destination_dir))
-            {
-                return false;
-            }
-        }
+    if (!index_file_pth_.empty() && !indx_.save(index_file_pth_))
+    {
+        std::cout << spd::ios::set_light_red_text
+                  << "Unable to save the index file: "
+                  << spd::ios::set_white_text
+                  << "\""
+                  << spd::cast::type_cast<std::string>(index_file_pth_.c_str())
+                  << "\""
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
     }
+}
 
-    return true;
+
+void program::classify_source_directory()
+{
+    directory_scanner source_dir_scannr(prog_args_.source_dir, prog_args_.categories_file_nme,
+                                        prog_args_.jobs_nbr);
+
+    std::size_t seq_nbr = 0;
+    std::mutex seq_nbr_mtx;
+
+    // The files are handed to the loaders as soon as they are found, the queue holding back the
+    // scanner threads. The files are parsed in the order they are queued, which only depends on
+    // the names of the directories when a single thread scans.
+    classify_categories_files(source_dir_scannr.get_jobs_number(),
+                              [&](bounded_queue<queued_categories_file>& categories_file_que)
+    {
+        source_dir_scannr.scan([&](std::filesystem::path&& categories_file_pth)
+        {
+            std::lock_guard<std::mutex> lock(seq_nbr_mtx);
+            categories_file_que.push({std::move(categories_file_pth), seq_nbr++});
+        });
+    });
 }
 
 
-bool program::parse_value(
-        json::value_type& val,
-        const std::filesystem::path& current_source_dir,
-        const std::filesystem::path& current_destination_dir
+void program::classify_categories_files(
+        std::size_t loaders_nbr,
+        const std::function<void(bounded_queue<queued_categories_file>&)>& feedr
 )
 {
-    std::filesystem::path shortcut_pth = current_destination_dir;
+    bounded_queue<queued_categories_file> categories_file_que(QUEUE_CAPACITY);
+    bounded_queue<loaded_categories_file> loaded_file_que(QUEUE_CAPACITY);
+    std::atomic<std::size_t> running_loaders_nbr(loaders_nbr);
+    std::vector<std::thread> loader_thrds;
+    std::thread feeder_thrd;
+    std::exception_ptr excep;
+
+    next_seq_nbr_.store(0, std::memory_order_relaxed);
+
+    // Feeder stage: feeds the paths of the categories files found.
+    feeder_thrd = std::thread([&]()
+    {
+        feedr(categories_file_que);
+        categories_file_que.close();
+    });
 
-    if (val.is_boolean())
+    // Parser stage: reads and parses the categories files, the last worker closes the queue.
+    for (std::size_t i = 0; i < loaders_nbr; ++i)
     {
-        if (!val)
+        loader_thrds.emplace_back([&]()
         {
-            return true;
-        }
+            load_categories_files(categories_file_que, loaded_file_que);
+
+            if (running_loaders_nbr.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                loaded_file_que.close();
+            }
+        });
     }
-    else if (val.is_number())
+
+    // Applier stage: plans the directories and the links.
+    parse_loaded_files(loaded_file_que, excep);
+
+    feeder_thrd.join();
+    for (auto& x : loader_thrds)
     {
-        shortcut_pth /= to_string(val);
-        if (!make_directory(shortcut_pth))
-        {
-            return false;
-        }
+        x.join();
     }
-    else if (val.is_string())
+
+    if (excep)
     {
-        shortcut_pth /= spd::cast::type_cast<string_type>(std::string(val));
-        if (!make_directory(shortcut_pth))
-        {
-            return false;
-        }
+        std::rethrow_exception(excep);
+    }
+}
+
+
+bool program::classify_catalog()
+{
+    std::size_t jobs_nbr = prog_args_.jobs_nbr > 0 ? prog_args_.jobs_nbr : get_cpu_quota();
+    catalog_reader catalog_readr;
+    bounded_queue<catalog_line> catalog_line_que(QUEUE_CAPACITY);
+    bounded_queue<loaded_categories_file> loaded_file_que(QUEUE_CAPACITY);
+    std::atomic<std::size_t> running_loaders_nbr(jobs_nbr);
+    std::vector<std::thread> loader_thrds;
+    std::thread catalog_thrd;
+    std::exception_ptr excep;
+
+    if (!state_file::get_file_signature(prog_args_.catalog_fle, &catalog_sig_) ||
+        !catalog_readr.open(prog_args_.catalog_fle))
+    {
+        return false;
     }
-    else if (val.is_array())
+
+    next_seq_nbr_.store(0, std::memory_order_relaxed);
+
+    // Catalog stage: feeds the lines of the catalog, read sequentially.
+    catalog_thrd = std::thread([&]()
     {
-        for (auto& x : val)
+        std::string_view lne;
+        std::size_t seq_nbr = 0;
+
+        while (catalog_readr.read_line(&lne))
         {
-            if (!parse_value(x, current_source_dir, current_destination_dir))
+            if (!catalog_reader::is_blank_line(lne))
             {
-                return false;
+                catalog_line_que.push({std::string(lne), catalog_readr.get_line_number(),
+                                       seq_nbr++});
             }
         }
 
-        return true;
+        catalog_line_que.close();
+    });
+
+    // Parser stage: parses the categories of the entries, the last worker closes the queue.
+    for (std::size_t i = 0; i < jobs_nbr; ++i)
+    {
+        loader_thrds.emplace_back([&]()
+        {
+            load_catalog_lines(catalog_line_que, loaded_file_que);
+
+            if (running_loaders_nbr.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                loaded_file_que.close();
+            }
+        });
     }
-    else
+
+    // Applier stage: plans the directories and the links.
+    parse_loaded_files(loaded_file_que, excep);
+
+    catalog_thrd.join();
+    for (auto& x : loader_thrds)
     {
-        return false;
+        x.join();
     }
 
-    shortcut_pth /= current_source_dir.filename();
-    if (!make_shortcut(current_source_dir, shortcut_pth))
+    if (excep)
     {
-        return false;
+        std::rethrow_exception(excep);
     }
 
-    return true;
+    return !catalog_readr.has_failed();
 }
 
 
-bool program::parse_icon(
-        json::value_type& val,
-        const std::filesystem::path& current_source_dir,
-        const std::filesystem::path& current_destination_dir
-)
+#if defined(__linux__)
+int program::watch_source_directory()
 {
-    if (val.is_array())
+    std::filesystem::path socket_pth = prog_args_.destination_dir / daemon_server::FILE_NAME;
+    source_changes chnges;
+    std::thread server_thrd;
+    std::chrono::steady_clock::time_point update_begin;
+    std::uint64_t updates_nbr = 0;
+    std::uint64_t update_duration_ms;
+
+    // The requests are served by their own thread from the published snapshots, the updates are
+    // done by this one.
+    if (prog_args_.daemon)
     {
-        for (auto& x : val)
+        if (!daemn_servr_.open(socket_pth))
         {
-            if (!parse_icon(x, current_source_dir, current_destination_dir))
-            {
-                return false;
-            }
+            std::cout << spd::ios::set_light_red_text
+                      << "Unable to listen on the socket: "
+                      << spd::ios::set_white_text
+                      << "\""
+                      << spd::cast::type_cast<std::string>(socket_pth.c_str())
+                      << "\""
+                      << spd::ios::set_default_text
+                      << spd::ios::newl;
+
+            return 1;
         }
 
-        return true;
+        publish_snapshot(0, 0, 0);
+        server_thrd = std::thread([&]()
+        {
+            daemn_servr_.run();
+        });
+
+        std::cout << spd::ios::set_light_cyan_text
+                  << "Listening on the socket: "
+                  << spd::ios::set_white_text
+                  << "\""
+                  << spd::cast::type_cast<std::string>(socket_pth.c_str())
+                  << "\""
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
     }
 
-    std::filesystem::path new_destination_pth = current_destination_dir;
-    if (val.is_number())
+    std::cout << spd::ios::set_light_cyan_text
+              << "Watching the source directory: "
+              << spd::ios::set_white_text
+              << "\""
+              << spd::cast::type_cast<std::string>(prog_args_.source_dir.c_str())
+              << "\""
+              << spd::ios::set_default_text
+              << std::endl;
+
+    while (source_watchr_.wait(&chnges))
     {
-        new_destination_pth /= to_string(val);
+        if (chnges.is_empty())
+        {
+            continue;
+        }
+
+        update_begin = std::chrono::steady_clock::now();
+        classify_changes(chnges);
+        ++updates_nbr;
+
+        if (prog_args_.daemon)
+        {
+            update_duration_ms = static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now() - update_begin).count());
+            publish_snapshot(updates_nbr, chnges.posted_nbr, update_duration_ms);
+        }
     }
-    else if (val.is_string())
+
+    std::cout << spd::ios::set_light_red_text
+              << "Unable to watch the source directory: "
+              << spd::ios::set_white_text
+              << "\""
+              << spd::cast::type_cast<std::string>(prog_args_.source_dir.c_str())
+              << "\"";
+
+    if (source_watchr_.get_failure_reason() != nullptr)
     {
-        new_destination_pth /= spd::cast::type_cast<string_type>(std::string(val));
+        std::cout << spd::ios::set_light_red_text
+                  << " ("
+                  << source_watchr_.get_failure_reason()
+                  << ")";
     }
-    else
+
+    std::cout << spd::ios::set_default_text
+              << spd::ios::newl;
+
+    if (server_thrd.joinable())
     {
-        return false;
+        daemn_servr_.stop();
+        server_thrd.join();
+        daemn_servr_.close();
     }
 
-    spd::sys::fsys::mkdir_recursively(new_destination_pth.c_str());
-    return set_icon(current_source_dir, new_destination_pth);
+    return 1;
 }
 
 
-bool program::set_icon(
-        const std::filesystem::path& current_source_dir,
-        const std::filesystem::path& current_destination_dir)
+void program::classify_changes(const source_changes& chnges)
 {
-#if defined(__GNU_LIBRARY__) || defined(__CYGWIN__)
-    // TODO: Implement the icon set for linux.
-    return false;
+    std::unordered_set<string_type> changed_pths;
+    std::vector<std::filesystem::path> categories_file_pths;
+    std::size_t jobs_nbr = prog_args_.jobs_nbr > 0 ? prog_args_.jobs_nbr : get_cpu_quota();
+    std::size_t loaders_nbr;
+    std::error_code err_code;
 
-#elif defined(_WIN32)
-    try
+    file_id_st_.clear();
+
+    for (auto& x : chnges.forced_pths)
     {
-        std::filesystem::path source_icon_pth = current_source_dir / ".icon.ico";
-        std::filesystem::path destination_icon_pth = current_destination_dir / ".icon.ico";
-        spd::sys::tm::system_time source_modification_tme;
-        spd::sys::tm::system_time destination_modification_tme;
-        bool need_cpy = true;
-        
-        if (!spd::sys::fsys::file_exists(source_icon_pth.c_str()))
+        forced_pths_.insert(x.native());
+    }
+
+    // Events have been lost, every categories file is checked against its signature. The state
+    // and the index of the last pass become the previous ones without reading the destination
+    // directory.
+    if (chnges.overflowed)
+    {
+        previous_stte_ = std::move(current_stte_);
+        current_stte_.clear();
+        previous_indx_ = std::move(indx_);
+        indx_.clear();
+        previous_ctgry_ids_.assign(previous_indx_.get_categories_number(), category_index::NPOS);
+        categories_cche_.load(cache_file_pth_);
+        classify_source_directory();
+    }
+    else
+    {
+        for (auto& x : chnges.categories_file_pths)
         {
-            return false;
+            changed_pths.insert(x.native());
         }
 
-        if (spd::sys::fsys::file_exists(destination_icon_pth.c_str()))
+        for (auto& x : chnges.forced_pths)
         {
-            spd::sys::fsys::get_modification_time(source_icon_pth.c_str(),
-                                                  &source_modification_tme);
-            spd::sys::fsys::get_modification_time(destination_icon_pth.c_str(),
-                                                  &destination_modification_tme);
-            
-            if (destination_modification_tme >= source_modification_tme)
+            changed_pths.insert(x.native());
+        }
+
+        for (auto& x : chnges.removed_dirs)
+        {
+            current_stte_.for_each_entry_under(x.native(), [&](auto categories_file_pth)
             {
-                inode_st_.insert(spd::sys::fsys::get_file_inode(destination_icon_pth.c_str()));
-                return true;
-            }
-            
-            SetFileAttributesW(destination_icon_pth.c_str(), 0x80);
+                changed_pths.emplace(categories_file_pth);
+            });
+        }
+
+        changed_pths.merge(retried_pths_);
+        retried_pths_.clear();
+
+        // Only the entries affected by the changes leave the state and the index of the last
+        // pass, the other ones stay as they are. The views are planned again.
+        for (auto& x : changed_pths)
+        {
+            release_entry(x);
+        }
+
+        for (auto& x : views_)
+        {
+            release_entry((prog_args_.destination_dir /
+                           spd::cast::type_cast<string_type>(x.nme)).native());
+        }
+
+        previous_ctgry_ids_.assign(previous_indx_.get_categories_number(), category_index::NPOS);
+
+        // A categories file that does not exist anymore leaves its entry out of the state.
+        categories_file_pths.reserve(changed_pths.size());
+        for (auto& x : changed_pths)
+        {
+            if (std::filesystem::is_regular_file(x, err_code))
+            {
+                categories_file_pths.emplace_back(x);
+            }
+        }
+
+        std::sort(categories_file_pths.begin(), categories_file_pths.end());
+        loaders_nbr = std::clamp<std::size_t>(categories_file_pths.size(), 1, jobs_nbr);
+        classify_categories_files(loaders_nbr,
+                                  [&](bounded_queue<queued_categories_file>& categories_file_que)
+        {
+            for (std::size_t i = 0; i < categories_file_pths.size(); ++i)
+            {
+                categories_file_que.push({std::move(categories_file_pths[i]), i});
+            }
+        });
+    }
+
+    plan_views();
+    plan_stale_files();
+
+    delete_extra_files();
+    extra_fles_.clear();
+    apply_plan();
+
+    plan_.clear();
+    category_dirs_.clear();
+    entry_nmes_.clear();
+    planned_shortcuts_.clear();
+
+    save_run_files();
+
+    if (!current_stte_.is_tracking_changes())
+    {
+        current_stte_.track_changes();
+    }
+
+    previous_stte_.clear();
+    previous_indx_.clear();
+    previous_ctgry_ids_.clear();
+    forced_pths_.clear();
+    previous_entry_dirs_.clear();
+    previous_entry_dirs_built_ = false;
+    moved_entry_pths_.clear();
+    moved_entries_.clear();
+
+    std::cout << std::flush;
+}
+
+
+void program::release_entry(const string_type& categories_file_pth)
+{
+    const entry_state* entry_stte = current_stte_.find_entry(categories_file_pth);
+    std::string entry_ky = get_entry_key(categories_file_pth);
+    std::uint32_t entry_id = indx_.find_entry(entry_ky);
+
+    // The entry is moved to the previous state and index, from which it is kept, moved or
+    // removed like in a whole run.
+    if (entry_stte != nullptr && entry_id != category_index::NPOS)
+    {
+        current_entry_ctgries_.clear();
+        for (auto& x : indx_.get_entry_categories(entry_id))
+        {
+            current_entry_ctgries_.push_back(add_released_category(x));
+        }
+
+        previous_indx_.add_entry(entry_ky, current_entry_ctgries_);
+    }
+
+    if (entry_stte != nullptr)
+    {
+        previous_stte_.add_entry(categories_file_pth, *entry_stte);
+        current_stte_.remove_entry(categories_file_pth);
+    }
+
+    if (entry_id != category_index::NPOS)
+    {
+        indx_.remove_entry(entry_ky);
+    }
+}
+
+
+std::uint32_t program::add_released_category(std::uint32_t ctgry_id)
+{
+    std::uint32_t key_ctgry_id = indx_.get_key_category(ctgry_id);
+
+    return previous_indx_.add_category(
+            key_ctgry_id == category_index::NPOS ?
+                    category_index::NPOS : add_released_category(key_ctgry_id),
+            indx_.get_category_name(ctgry_id));
+}
+
+
+bool program::post_reclassification(
+        const std::filesystem::path& entry_pth,
+        std::uint64_t* posted_nbr
+)
+{
+    const string_type& entry_pth_str = entry_pth.native();
+    const string_type& source_dir_str = prog_args_.source_dir.native();
+
+    // Only the entries of the source directory can be classified again, written as the queries
+    // print them.
+    if (entry_pth_str.size() <= source_dir_str.size() ||
+        !entry_pth_str.starts_with(source_dir_str) ||
+        entry_pth_str[source_dir_str.size()] != std::filesystem::path::preferred_separator ||
+        std::any_of(entry_pth.begin(), entry_pth.end(), [](const std::filesystem::path& x)
+    {
+        return x == "..";
+    }))
+    {
+        return false;
+    }
+
+    *posted_nbr = source_watchr_.post(entry_pth / prog_args_.categories_file_nme);
+
+    return true;
+}
+
+
+void program::publish_snapshot(
+        std::uint64_t updates_nbr,
+        std::uint64_t applied_nbr,
+        std::uint64_t update_duration_ms
+)
+{
+    auto snap = std::make_shared<daemon_snapshot>();
+
+    // The index file is replaced by a rename, so the snapshots still in use keep reading the
+    // previous one. An index that cannot be read answers every query with no entry.
+    snap->indx.open(index_file_pth_);
+    snap->updates_nbr = updates_nbr;
+    snap->applied_nbr = applied_nbr;
+    snap->update_duration_ms = update_duration_ms;
+
+    daemn_servr_.publish(std::move(snap));
+}
+#endif
+
+
+void program::load_categories_files(
+        bounded_queue<queued_categories_file>& categories_file_que,
+        bounded_queue<loaded_categories_file>& loaded_file_que
+)
+{
+    queued_categories_file categories_fle;
+    file_reader file_readr;
+
+    while (categories_file_que.pop(categories_fle))
+    {
+        loaded_categories_file loaded_fle;
+        loaded_fle.categories_file_pth = std::move(categories_fle.pth);
+        loaded_fle.seq_nbr = categories_fle.seq_nbr;
+
+        try
+        {
+            if (!state_file::get_file_signature(loaded_fle.categories_file_pth,
+                                                &loaded_fle.entry_stte.categories_file_sig))
+            {
+                loaded_fle.fail_reasn = "unreadable file";
+                push_loaded_file(loaded_file_que, std::move(loaded_fle));
+                continue;
+            }
+
+            // A file whose signature has not changed since the previous run is not even read,
+            // and a file whose content has not changed is not parsed.
+            loaded_fle.previous_entry_stte = find_previous_entry(loaded_fle.categories_file_pth);
+
+            // A file to classify again is planned as if it was new, which recreates the links
+            // removed by hand.
+            if (forced_pths_.contains(loaded_fle.categories_file_pth.native()))
+            {
+                loaded_fle.previous_entry_stte = nullptr;
+            }
+
+            if (loaded_fle.previous_entry_stte != nullptr &&
+                loaded_fle.previous_entry_stte->categories_file_sig ==
+                        loaded_fle.entry_stte.categories_file_sig)
+            {
+                loaded_fle.unchanged = true;
+            }
+            else if (!load_cached_categories(loaded_fle))
+            {
+                if (file_readr.read(loaded_fle.categories_file_pth,
+                                    loaded_fle.entry_stte.categories_file_sig.sz))
+                {
+                    load_categories(loaded_fle, file_readr.get_content());
+                }
+                else
+                {
+                    loaded_fle.fail_reasn = "unreadable file";
+                }
+            }
+
+            // A renamed entry is found again by its directory, which is only identified once its
+            // categories have changed.
+            if (!loaded_fle.unchanged)
+            {
+                loaded_fle.entry_stte.entry_dir_id = get_parent_file_id(
+                        loaded_fle.categories_file_pth);
+            }
+        }
+        catch (...)
+        {
+            loaded_fle.excep = std::current_exception();
+        }
+
+        push_loaded_file(loaded_file_que, std::move(loaded_fle));
+    }
+}
+
+
+void program::load_catalog_lines(
+        bounded_queue<catalog_line>& catalog_line_que,
+        bounded_queue<loaded_categories_file>& loaded_file_que
+)
+{
+    catalog_line lne;
+    std::string entry_pth;
+    std::string_view contnt;
+
+    while (catalog_line_que.pop(lne))
+    {
+        loaded_categories_file loaded_fle;
+        loaded_fle.seq_nbr = lne.seq_nbr;
+
+        try
+        {
+            if (!catalog_reader::parse_line(lne.txt, &entry_pth, &contnt))
+            {
+                loaded_fle.fail_reasn = "invalid catalog line";
+            }
+            // An entry path leading out of the source directory would get links to whatever it
+            // points at, the line is reported like a malformed one.
+            else if (!catalog_reader::is_inner_entry_path(entry_pth))
+            {
+                loaded_fle.fail_reasn = "entry path outside the source directory";
+            }
+
+            if (loaded_fle.fail_reasn != nullptr)
+            {
+                loaded_fle.catalog_entry_pth = prog_args_.catalog_fle;
+                loaded_fle.catalog_entry_pth += ":";
+                loaded_fle.catalog_entry_pth += std::to_string(lne.nbr);
+                push_loaded_file(loaded_file_que, std::move(loaded_fle));
+                continue;
+            }
+
+            // The entries are recorded in the state as if their categories were in files, which
+            // keeps the state valid when switching between the catalog and the categories files.
+            loaded_fle.catalog_entry_pth = prog_args_.source_dir /
+                                           spd::cast::type_cast<string_type>(entry_pth);
+            loaded_fle.categories_file_pth = loaded_fle.catalog_entry_pth /
+                                             prog_args_.categories_file_nme;
+            loaded_fle.entry_stte.categories_file_sig = catalog_sig_;
+            loaded_fle.previous_entry_stte = find_previous_entry(loaded_fle.categories_file_pth);
+
+            // An unchanged catalog holds unchanged entries, otherwise the content of each entry
+            // tells whether it has changed.
+            if (loaded_fle.previous_entry_stte != nullptr &&
+                loaded_fle.previous_entry_stte->categories_file_sig == catalog_sig_)
+            {
+                loaded_fle.unchanged = true;
+            }
+            else if (!load_cached_categories(loaded_fle))
+            {
+                load_categories(loaded_fle, contnt);
+            }
+        }
+        catch (...)
+        {
+            loaded_fle.excep = std::current_exception();
+        }
+
+        push_loaded_file(loaded_file_que, std::move(loaded_fle));
+    }
+}
+
+
+void program::push_loaded_file(
+        bounded_queue<loaded_categories_file>& loaded_file_que,
+        loaded_categories_file&& loaded_fle
+)
+{
+    std::size_t next_seq_nbr = next_seq_nbr_.load(std::memory_order_acquire);
+
+    // The files are handed over in order by the queue, the file that the applier waits for never
+    // waits here, so at most a window of files waits for their turn in the applier.
+    while (loaded_fle.seq_nbr >= next_seq_nbr + REORDER_WINDOW)
+    {
+        next_seq_nbr_.wait(next_seq_nbr, std::memory_order_acquire);
+        next_seq_nbr = next_seq_nbr_.load(std::memory_order_acquire);
+    }
+
+    loaded_file_que.push(std::move(loaded_fle));
+}
+
+
+bool program::load_cached_categories(loaded_categories_file& loaded_fle)
+{
+    // The categories are written over a list released by the applier, whose storage has already
+    // grown to the size of the previous files.
+    recycled_categories_que_.try_pop(loaded_fle.categories);
+
+    // A file whose signature is in the cache is neither read nor parsed.
+    if (!categories_cche_.find(loaded_fle.categories_file_pth.native(),
+                               loaded_fle.entry_stte.categories_file_sig,
+                               &loaded_fle.entry_stte.content_hsh, &loaded_fle.categories))
+    {
+        return false;
+    }
+
+    if (loaded_fle.previous_entry_stte != nullptr &&
+        loaded_fle.previous_entry_stte->content_hsh == loaded_fle.entry_stte.content_hsh)
+    {
+        loaded_fle.unchanged = true;
+    }
+    else
+    {
+        loaded_fle.loaded = true;
+    }
+
+    return true;
+}
+
+
+void program::load_categories(loaded_categories_file& loaded_fle, std::string_view contnt)
+{
+    loaded_fle.entry_stte.content_hsh = state_file::hash_content(contnt.data(), contnt.size());
+
+    if (loaded_fle.previous_entry_stte != nullptr &&
+        loaded_fle.previous_entry_stte->content_hsh == loaded_fle.entry_stte.content_hsh)
+    {
+        loaded_fle.unchanged = true;
+    }
+    // A content already parsed under another path or signature is taken from the cache, and a
+    // malformed file is reported on its own instead of stopping the run.
+    else if (categories_cche_.find(loaded_fle.entry_stte.content_hsh, &loaded_fle.categories) ||
+             loaded_fle.categories.parse(contnt))
+    {
+        loaded_fle.loaded = true;
+    }
+    else
+    {
+        loaded_fle.fail_reasn = "invalid JSON";
+    }
+}
+
+
+void program::parse_loaded_files(
+        bounded_queue<loaded_categories_file>& loaded_file_que,
+        std::exception_ptr& excep
+)
+{
+    loaded_categories_file loaded_fle;
+    std::map<std::size_t, loaded_categories_file> waiting_fles;
+    std::size_t next_seq_nbr = 0;
+
+    // The loaders finish the files in any order, a file that arrives before its turn waits until
+    // the files before it have been parsed. The loaders are released as the window moves.
+    while (loaded_file_que.pop(loaded_fle))
+    {
+        if (loaded_fle.seq_nbr != next_seq_nbr)
+        {
+            waiting_fles.emplace(loaded_fle.seq_nbr, std::move(loaded_fle));
+            continue;
+        }
+
+        parse_loaded_file(loaded_fle, excep);
+        ++next_seq_nbr;
+
+        for (auto it = waiting_fles.begin();
+             it != waiting_fles.end() && it->first == next_seq_nbr;
+             it = waiting_fles.erase(it))
+        {
+            parse_loaded_file(it->second, excep);
+            ++next_seq_nbr;
+        }
+
+        next_seq_nbr_.store(next_seq_nbr, std::memory_order_release);
+        next_seq_nbr_.notify_all();
+    }
+}
+
+
+void program::parse_loaded_file(loaded_categories_file& loaded_fle, std::exception_ptr& excep)
+{
+    // Once an error happened the files are skipped, the queue is still drained so that the other
+    // stages can finish.
+    if (excep)
+    {
+        return;
+    }
+
+    if (loaded_fle.excep)
+    {
+        excep = std::move(loaded_fle.excep);
+        return;
+    }
+
+    try
+    {
+        parse_categories_file(loaded_fle);
+    }
+    catch (...)
+    {
+        excep = std::current_exception();
+    }
+
+    loaded_fle.categories.clear();
+    recycled_categories_que_.try_push(std::move(loaded_fle.categories));
+}
+
+
+bool program::parse_categories_file(loaded_categories_file& loaded_fle)
+{
+    std::size_t plan_sz;
+
+    if (loaded_fle.unchanged)
+    {
+        categories_cche_.keep(loaded_fle.categories_file_pth.native(),
+                              loaded_fle.entry_stte.categories_file_sig);
+        keep_unchanged_entry(loaded_fle);
+        return true;
+    }
+
+    if (loaded_fle.loaded && loaded_fle.previous_entry_stte == nullptr &&
+        move_renamed_entry(loaded_fle))
+    {
+        return true;
+    }
+
+    current_entry_pth_ = loaded_fle.categories_file_pth.native();
+    current_entry_stte_ = std::move(loaded_fle.entry_stte);
+    current_entry_stte_.lnks.clear();
+    current_entry_stte_.dirs.clear();
+
+    std::cout << spd::ios::set_light_cyan_text
+              << (loaded_fle.catalog_entry_pth.empty() ? "Parsing categories file: " :
+                                                         "Parsing catalog entry: ")
+              << spd::ios::set_white_text
+              << "\""
+              << spd::cast::type_cast<std::string>(loaded_fle.catalog_entry_pth.empty() ?
+                                                   loaded_fle.categories_file_pth.c_str() :
+                                                   loaded_fle.catalog_entry_pth.c_str())
+              << "\" "
+              << spd::ios::set_default_text
+              << std::flush;
+
+    if (!loaded_fle.loaded)
+    {
+        std::cout << spd::ios::set_light_red_text << "[fail: " << loaded_fle.fail_reasn << "]"
+                  << spd::ios::set_default_text << std::endl;
+
+        return false;
+    }
+
+    categories_cche_.add(current_entry_pth_, current_entry_stte_.categories_file_sig,
+                         current_entry_stte_.content_hsh, loaded_fle.categories);
+
+    plan_sz = plan_.size();
+    if (!parse_entries(loaded_fle.categories, loaded_fle.categories_file_pth.parent_path()))
+    {
+        discard_entry_operations(plan_sz);
+
+        std::cout << spd::ios::set_light_red_text << "[fail]"
+                  << spd::ios::set_default_text << std::endl;
+
+        return false;
+    }
+
+    keep_entry_links();
+
+    indx_.add_entry(get_entry_key(loaded_fle.categories_file_pth), current_entry_ctgries_);
+
+    // Only the directories that will not be kept through the links have to be remembered, a
+    // link keeps its directory and the key directory above it.
+    for (auto* dir : current_entry_dirs_)
+    {
+        if (std::none_of(current_entry_lnk_dirs_.begin(), current_entry_lnk_dirs_.end(),
+                         [&](const category_directory* lnk_dir)
+        {
+            return lnk_dir == dir || lnk_dir->key_dir == dir;
+        }))
+        {
+            current_entry_stte_.dirs.push_back(dir->relative_pth);
+        }
+    }
+
+    current_stte_.add_entry(current_entry_pth_, std::move(current_entry_stte_));
+
+    std::cout << spd::ios::set_light_green_text << "[ok]"
+              << spd::ios::set_default_text << std::endl;
+
+    return true;
+}
+
+
+void program::discard_entry_operations(std::size_t plan_sz)
+{
+    // The links of an entry that failed are neither created nor recorded, the directories are
+    // still created since the entries planned later may rely on them.
+    plan_.erase(std::remove_if(plan_.begin() + static_cast<std::ptrdiff_t>(plan_sz), plan_.end(),
+                               [](const file_operation& op)
+    {
+        return op.op_type != file_operation_types::MKDIR;
+    }), plan_.end());
+
+    for (auto* dir : current_entry_lnk_dirs_)
+    {
+        planned_shortcuts_.erase((static_cast<std::uint64_t>(dir->id) << 32) |
+                                 current_entry_nme_id_);
+    }
+}
+
+
+void program::keep_entry_links()
+{
+    // The links already up to date are only counted as produced once the whole entry is planned.
+    for (auto& x : current_entry_stte_.lnks)
+    {
+        if (!(x.id == file_id()))
+        {
+            file_id_st_.insert(x.id);
+        }
+    }
+}
+
+
+void program::keep_unchanged_entry(loaded_categories_file& loaded_fle)
+{
+    entry_state entry_stte = *loaded_fle.previous_entry_stte;
+    std::string entry_ky = get_entry_key(loaded_fle.categories_file_pth);
+    std::size_t separator_pos;
+
+    // The loaders only report as unchanged the entries found in the previous index.
+    current_entry_ctgries_.clear();
+    for (auto& x : previous_indx_.get_entry_categories(previous_indx_.find_entry(entry_ky)))
+    {
+        current_entry_ctgries_.push_back(add_previous_category(x));
+    }
+
+    indx_.add_entry(entry_ky, current_entry_ctgries_);
+
+    entry_stte.categories_file_sig = loaded_fle.entry_stte.categories_file_sig;
+
+    for (auto& x : entry_stte.lnks)
+    {
+        file_id_st_.insert(x.id);
+
+        separator_pos = x.pth.find_last_of(std::filesystem::path::preferred_separator);
+        if (separator_pos != string_type::npos)
+        {
+            keep_previous_directory(x.pth.substr(0, separator_pos));
+        }
+    }
+
+    for (auto& x : entry_stte.dirs)
+    {
+        keep_previous_directory(x);
+    }
+
+    current_stte_.add_entry(loaded_fle.categories_file_pth.native(), std::move(entry_stte));
+}
+
+
+bool program::move_renamed_entry(loaded_categories_file& loaded_fle)
+{
+    const file_id& entry_dir_id = loaded_fle.entry_stte.entry_dir_id;
+    std::filesystem::path entry_dir_pth;
+    std::filesystem::path previous_pth;
+    string_type previous_lnk_nme;
+    const entry_state* previous_entry_stte;
+    std::error_code err_code;
+    std::size_t separator_pos;
+
+    if (!loaded_fle.catalog_entry_pth.empty() || entry_dir_id == file_id() ||
+        previous_stte_.get_entries_number() == 0)
+    {
+        return false;
+    }
+
+    if (!previous_entry_dirs_built_)
+    {
+        previous_stte_.for_each_entry([&](const string_type& categories_file_pth,
+                                          const entry_state& entry_stte)
+        {
+            if (!(entry_stte.entry_dir_id == file_id()))
+            {
+                previous_entry_dirs_.emplace(entry_stte.entry_dir_id, categories_file_pth);
+            }
+        });
+
+        previous_entry_dirs_built_ = true;
+    }
+
+    auto it = previous_entry_dirs_.find(entry_dir_id);
+    if (it == previous_entry_dirs_.end() || moved_entry_pths_.contains(it->second) ||
+        current_stte_.find_entry(it->second) != nullptr)
+    {
+        return false;
+    }
+
+    // The entry directory must have left its previous path with the same categories, otherwise
+    // the entry is planned as a new one.
+    previous_pth = it->second;
+    previous_entry_stte = find_previous_entry(previous_pth);
+    if (previous_entry_stte == nullptr ||
+        previous_entry_stte->content_hsh != loaded_fle.entry_stte.content_hsh ||
+        std::filesystem::exists(previous_pth.parent_path(), err_code))
+    {
+        return false;
+    }
+
+    entry_state entry_stte = *previous_entry_stte;
+    entry_stte.categories_file_sig = loaded_fle.entry_stte.categories_file_sig;
+    entry_dir_pth = loaded_fle.categories_file_pth.parent_path();
+    previous_lnk_nme = get_shortcut_actual_path(previous_pth.parent_path().filename()).native();
+    moved_entry_pths_.insert(previous_pth.native());
+    moved_entries_.emplace(loaded_fle.categories_file_pth.native(), previous_pth.native());
+
+    current_entry_pth_ = loaded_fle.categories_file_pth.native();
+    set_current_entry_name(entry_dir_pth);
+    categories_cche_.add(current_entry_pth_, entry_stte.categories_file_sig,
+                         entry_stte.content_hsh, loaded_fle.categories);
+
+    std::cout << spd::ios::set_light_cyan_text
+              << "Moving entry: "
+              << spd::ios::set_white_text
+              << "\""
+              << spd::cast::type_cast<std::string>(previous_pth.parent_path().c_str())
+              << "\" to \""
+              << spd::cast::type_cast<std::string>(entry_dir_pth.c_str())
+              << "\" "
+              << spd::ios::set_default_text;
+
+    current_entry_ctgries_.clear();
+    for (auto& x : previous_indx_.get_entry_categories(
+            previous_indx_.find_entry(get_entry_key(previous_pth))))
+    {
+        current_entry_ctgries_.push_back(add_previous_category(x));
+    }
+
+    indx_.add_entry(get_entry_key(loaded_fle.categories_file_pth), current_entry_ctgries_);
+
+    // The links named after the entry are moved in their directories, the other files produced
+    // are kept as they are.
+    for (auto& x : entry_stte.lnks)
+    {
+        separator_pos = x.pth.find_last_of(std::filesystem::path::preferred_separator);
+        if (separator_pos == string_type::npos)
+        {
+            file_id_st_.insert(x.id);
+            continue;
+        }
+
+        keep_previous_directory(x.pth.substr(0, separator_pos));
+
+        if (x.pth.compare(separator_pos + 1, string_type::npos, previous_lnk_nme) != 0)
+        {
+            file_id_st_.insert(x.id);
+            continue;
+        }
+
+        plan_.push_back({file_operation_types::RELINK,
+                         prog_args_.destination_dir / x.pth.substr(0, separator_pos) /
+                                 current_entry_nme_,
+                         entry_dir_pth, current_entry_pth_, prog_args_.destination_dir / x.pth});
+
+        x.pth.resize(separator_pos + 1);
+        x.pth += current_entry_lnk_nme_;
+        x.id = file_id();
+    }
+
+    for (auto& x : entry_stte.dirs)
+    {
+        keep_previous_directory(x);
+    }
+
+    current_stte_.add_entry(current_entry_pth_, std::move(entry_stte));
+
+    std::cout << spd::ios::set_light_green_text << "[ok]"
+              << spd::ios::set_default_text << std::endl;
+
+    return true;
+}
+
+
+void program::keep_previous_directory(string_type directory_pth)
+{
+    std::size_t separator_pos;
+
+    // Keep the directory and its parents, up to the first one already kept.
+    for (;;)
+    {
+        if (current_stte_.find_directory(directory_pth) != nullptr)
+        {
+            return;
+        }
+
+        if (auto* ids = previous_stte_.find_directory(directory_pth))
+        {
+            for (auto& id : *ids)
+            {
+                file_id_st_.insert(id);
+                current_stte_.add_directory_id(directory_pth, id);
+            }
+        }
+
+        separator_pos = directory_pth.find_last_of(std::filesystem::path::preferred_separator);
+        if (separator_pos == string_type::npos)
+        {
+            return;
+        }
+
+        directory_pth.resize(separator_pos);
+    }
+}
+
+
+const entry_state* program::find_previous_entry(
+        const std::filesystem::path& categories_file_pth
+) const
+{
+    // An entry missing from the previous index is planned again, so that the index is complete.
+    if (previous_indx_.find_entry(get_entry_key(categories_file_pth)) == category_index::NPOS)
+    {
+        return nullptr;
+    }
+
+    return previous_stte_.find_entry(categories_file_pth.native());
+}
+
+
+std::uint32_t program::add_previous_category(std::uint32_t previous_ctgry_id)
+{
+    std::uint32_t& ctgry_id = previous_ctgry_ids_[previous_ctgry_id];
+    std::uint32_t previous_key_ctgry_id;
+
+    if (ctgry_id == category_index::NPOS)
+    {
+        previous_key_ctgry_id = previous_indx_.get_key_category(previous_ctgry_id);
+        ctgry_id = indx_.add_category(
+                previous_key_ctgry_id == category_index::NPOS ?
+                        category_index::NPOS : add_previous_category(previous_key_ctgry_id),
+                previous_indx_.get_category_name(previous_ctgry_id));
+    }
+
+    return ctgry_id;
+}
+
+
+std::string program::get_entry_key(const std::filesystem::path& categories_file_pth)
+{
+#if defined(_WIN32)
+    return spd::cast::type_cast<std::string>(categories_file_pth.parent_path().c_str());
+
+#else
+    // The key is taken from the native path, which is already the parent path plus a file name.
+    const string_type& pth_str = categories_file_pth.native();
+    std::size_t separator_pos = pth_str.find_last_of(std::filesystem::path::preferred_separator);
+
+    return separator_pos != string_type::npos ? pth_str.substr(0, separator_pos) : string_type();
+#endif
+}
+
+
+void program::set_current_entry_name(const std::filesystem::path& source_dir)
+{
+    // The links of the entry are identified by their directory and the entry name.
+    current_entry_nme_ = source_dir.filename();
+    current_entry_nme_id_ = entry_nmes_.intern(
+            spd::cast::type_cast<std::string>(current_entry_nme_.c_str()));
+    current_entry_lnk_nme_ = get_shortcut_actual_path(current_entry_nme_).native();
+}
+
+
+bool program::parse_entries(
+        const category_list& categories,
+        const std::filesystem::path& current_source_dir
+)
+{
+    const std::vector<category_list::token>& tokns = categories.get_tokens();
+    const category_directory* key_dir = nullptr;
+    bool icon_key = false;
+    bool icon_faild = false;
+
+    set_current_entry_name(current_source_dir);
+    current_entry_dirs_.clear();
+    current_entry_lnk_dirs_.clear();
+    current_entry_ctgries_.clear();
+    current_entry_stte_.lnks.reserve(tokns.size());
+
+    for (auto& x : tokns)
+    {
+        if (x.tokn_type == category_token_types::KEY)
+        {
+            icon_key = categories.get_text(x) == "Icon";
+            icon_faild = false;
+
+            if (!icon_key)
+            {
+                key_dir = plan_category_directory(nullptr, categories.get_text(x));
+                if (key_dir == nullptr)
+                {
+                    return false;
+                }
+            }
+        }
+        else if (icon_key)
+        {
+            if (!prog_args_.dry_run && !icon_faild &&
+                !parse_icon(categories, x, current_source_dir, prog_args_.destination_dir))
+            {
+                icon_faild = true;
+                std::cout << spd::ios::set_light_red_text
+                          << "[Icon fail] "
+                          << spd::ios::set_default_text;
+            }
+        }
+        else if (!parse_value(categories, x, current_source_dir, *key_dir))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool program::parse_value(
+        const category_list& categories,
+        const category_list::token& tokn,
+        const std::filesystem::path& current_source_dir,
+        const category_directory& key_dir
+)
+{
+    const category_directory* value_dir = &key_dir;
+
+    switch (tokn.tokn_type)
+    {
+        case category_token_types::FALSE_VALUE:
+            return true;
+
+        case category_token_types::TRUE_VALUE:
+            break;
+
+        case category_token_types::NAME:
+            value_dir = plan_category_directory(&key_dir, categories.get_text(tokn));
+            if (value_dir == nullptr)
+            {
+                return false;
+            }
+            break;
+
+        default:
+            return false;
+    }
+
+    current_entry_ctgries_.push_back(value_dir->id);
+
+    return plan_shortcut(current_source_dir, *value_dir);
+}
+
+
+bool program::parse_icon(
+        const category_list& categories,
+        const category_list::token& tokn,
+        const std::filesystem::path& current_source_dir,
+        const std::filesystem::path& current_destination_dir
+)
+{
+    if (tokn.tokn_type != category_token_types::NAME)
+    {
+        return false;
+    }
+
+    std::filesystem::path new_destination_pth = current_destination_dir /
+            spd::cast::type_cast<string_type>(std::string(categories.get_text(tokn)));
+
+    spd::sys::fsys::mkdir_recursively(new_destination_pth.c_str());
+    return set_icon(current_source_dir, new_destination_pth);
+}
+
+
+bool program::set_icon(
+        const std::filesystem::path& current_source_dir,
+        const std::filesystem::path& current_destination_dir)
+{
+#if defined(__GNU_LIBRARY__) || defined(__CYGWIN__)
+    // TODO: Implement the icon set for linux.
+    return false;
+
+#elif defined(_WIN32)
+    try
+    {
+        std::filesystem::path source_icon_pth = current_source_dir / ".icon.ico";
+        std::filesystem::path destination_icon_pth = current_destination_dir / ".icon.ico";
+        spd::sys::tm::system_time source_modification_tme;
+        spd::sys::tm::system_time destination_modification_tme;
+        bool need_cpy = true;
+        
+        if (!spd::sys::fsys::file_exists(source_icon_pth.c_str()))
+        {
+            return false;
+        }
+
+        if (spd::sys::fsys::file_exists(destination_icon_pth.c_str()))
+        {
+            spd::sys::fsys::get_modification_time(source_icon_pth.c_str(),
+                                                  &source_modification_tme);
+            spd::sys::fsys::get_modification_time(destination_icon_pth.c_str(),
+                                                  &destination_modification_tme);
+            
+            if (destination_modification_tme >= source_modification_tme)
+            {
+                keep_produced_file(destination_icon_pth, get_file_id(destination_icon_pth));
+                return true;
+            }
+            
+            SetFileAttributesW(destination_icon_pth.c_str(), 0x80);
         }
         
         std::filesystem::copy(source_icon_pth, current_destination_dir,
                               std::filesystem::copy_options::overwrite_existing);
         SetFileAttributesW(destination_icon_pth.c_str(), 0x22);
         
-        inode_st_.insert(spd::sys::fsys::get_file_inode(destination_icon_pth.c_str()));
+        keep_produced_file(destination_icon_pth, get_file_id(destination_icon_pth));
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+#endif
+}
+
+
+const program::category_directory* program::plan_category_directory(
+        const category_directory* key_dir,
+        std::string_view nme
+)
+{
+    std::uint32_t ctgry_id = indx_.add_category(
+            key_dir != nullptr ? key_dir->id : category_index::NPOS, nme);
+
+    // The categories carried from the previous index have no directory until an entry is planned
+    // in them.
+    if (ctgry_id >= category_dirs_.size())
+    {
+        category_dirs_.resize(ctgry_id + 1);
+    }
+
+    // A directory shared by many entries is only built and checked on its first visit.
+    category_directory& dir = category_dirs_[ctgry_id];
+    if (!dir.built)
+    {
+        dir.id = ctgry_id;
+        dir.key_dir = key_dir;
+        dir.pth = (key_dir != nullptr ? key_dir->pth : prog_args_.destination_dir) /
+                  spd::cast::type_cast<string_type>(std::string(nme));
+        dir.relative_pth = get_destination_relative_path(dir.pth);
+        dir.planned = plan_directory(dir.pth, dir.relative_pth);
+        dir.built = true;
+    }
+
+    if (!dir.planned)
+    {
+        return nullptr;
+    }
+
+    add_entry_directory(dir);
+
+    return &dir;
+}
+
+
+bool program::plan_directory(
+        const std::filesystem::path& directory_pth,
+        const string_type& relative_pth
+)
+{
+    destination_file_status file_stat;
+
+    // The directory has already been planned or kept during this run.
+    if (current_stte_.find_directory(relative_pth) != nullptr)
+    {
         return true;
     }
-    catch (...)
+
+    if (get_destination_file_status(directory_pth, &file_stat))
+    {
+        if (!file_stat.is_directory)
+        {
+            return false;
+        }
+
+        current_stte_.add_directory(relative_pth);
+        keep_directory_id(directory_pth, file_stat.id);
+
+        if (!prog_args_.dry_run)
+        {
+            configure_directory(directory_pth);
+        }
+
+        return true;
+    }
+
+    current_stte_.add_directory(relative_pth);
+    plan_.push_back({file_operation_types::MKDIR, directory_pth, {}, {}, {}});
+
+    return true;
+}
+
+
+void program::add_entry_directory(const category_directory& dir)
+{
+    if (std::find(current_entry_dirs_.begin(), current_entry_dirs_.end(), &dir) ==
+            current_entry_dirs_.end())
+    {
+        current_entry_dirs_.push_back(&dir);
+    }
+}
+
+
+bool program::plan_shortcut(const std::filesystem::path& target_pth, const category_directory& dir)
+{
+    std::uint64_t shortcut_ky = (static_cast<std::uint64_t>(dir.id) << 32) | current_entry_nme_id_;
+    string_type relative_pth;
+    destination_file_status file_stat;
+
+    // The link is already going to be created during this run, no path has to be built.
+    if (planned_shortcuts_.contains(shortcut_ky))
+    {
+        return true;
+    }
+
+    // Only the relative path kept in the state is built for a link already up to date, the full
+    // paths are built for the operations.
+    relative_pth.reserve(dir.relative_pth.size() + 1 + current_entry_lnk_nme_.size());
+    relative_pth += dir.relative_pth;
+    relative_pth += std::filesystem::path::preferred_separator;
+    relative_pth += current_entry_lnk_nme_;
+    current_entry_lnk_dirs_.push_back(&dir);
+
+    // The categories file has been stat once by its loader, the link is stat once here.
+    if (get_destination_file_status(dir.pth, current_entry_lnk_nme_, &file_stat))
+    {
+        if (file_stat.mtime_ns >= current_entry_stte_.categories_file_sig.mtime_ns)
+        {
+            current_entry_stte_.lnks.push_back({std::move(relative_pth), file_stat.id});
+            return true;
+        }
+
+        // In a dry run the outdated link stays, it must not be reported as an extra file.
+        if (prog_args_.dry_run)
+        {
+            file_id_st_.insert(file_stat.id);
+        }
+
+        plan_.push_back({file_operation_types::UNLINK, dir.pth / current_entry_lnk_nme_, {}, {},
+                         {}});
+    }
+
+    current_entry_stte_.lnks.push_back({std::move(relative_pth), file_id()});
+    planned_shortcuts_.insert(shortcut_ky);
+    plan_.push_back({file_operation_types::SYMLINK, dir.pth / current_entry_nme_, target_pth,
+                     current_entry_pth_, {}});
+
+    return true;
+}
+
+
+bool program::load_views()
+{
+    file_reader readr;
+    json views_json;
+
+    if (!readr.read(prog_args_.views_fle, 0))
+    {
+        return false;
+    }
+
+    views_json = json::parse(readr.get_content(), nullptr, false);
+    if (!views_json.is_object())
+    {
+        return false;
+    }
+
+    // A view whose expression is invalid keeps an empty query and fails when it is planned.
+    views_.clear();
+    for (auto& [nme, expr] : views_json.items())
+    {
+        view& vew = views_.emplace_back();
+        vew.nme = nme;
+
+        if (expr.is_string())
+        {
+            vew.qury.parse(expr.get_ref<const std::string&>());
+        }
+    }
+
+    return true;
+}
+
+
+void program::plan_views()
+{
+    // The view directories take the identifiers that follow the categories, every category being
+    // known once all the entries are planned.
+    auto dir_id = static_cast<std::uint32_t>(indx_.get_categories_number());
+
+    for (auto& x : views_)
+    {
+        plan_view(x, dir_id++);
+    }
+}
+
+
+bool program::plan_view(const view& vew, std::uint32_t dir_id)
+{
+    category_directory dir;
+    std::unordered_map<std::basic_string_view<char_type>, file_id> previous_lnks;
+    roaring_bitmap entry_ids;
+    std::filesystem::path entry_pth;
+    string_type relative_pth;
+    const char* fail_reasn = nullptr;
+
+    std::cout << spd::ios::set_light_cyan_text
+              << "Building view: "
+              << spd::ios::set_white_text
+              << "\""
+              << vew.nme
+              << "\" "
+              << spd::ios::set_default_text
+              << std::flush;
+
+    if (vew.qury.is_empty())
+    {
+        fail_reasn = "invalid expression";
+    }
+    else if (vew.nme.empty() || vew.nme == "." || vew.nme == ".." ||
+             vew.nme.find_first_of("/\\") != std::string::npos)
+    {
+        fail_reasn = "invalid name";
+    }
+    else if (indx_.find_category(category_index::NPOS, vew.nme) != category_index::NPOS)
+    {
+        fail_reasn = "name of a category";
+    }
+    else
+    {
+        dir.id = dir_id;
+        dir.pth = prog_args_.destination_dir / spd::cast::type_cast<string_type>(vew.nme);
+        dir.relative_pth = get_destination_relative_path(dir.pth);
+        dir.planned = plan_directory(dir.pth, dir.relative_pth);
+        dir.built = true;
+
+        if (!dir.planned)
+        {
+            fail_reasn = "not a directory";
+        }
+    }
+
+    if (fail_reasn != nullptr)
+    {
+        std::cout << spd::ios::set_light_red_text << "[fail: " << fail_reasn << "]"
+                  << spd::ios::set_default_text << std::endl;
+
+        return false;
+    }
+
+    // A view is recorded in the state like an entry, under the path of its directory, so that
+    // its links kept from the previous run are not checked again.
+    current_entry_pth_ = dir.pth.native();
+    current_entry_stte_ = entry_state();
+    current_entry_lnk_dirs_.clear();
+
+    if (auto* previous_entry_stte = previous_stte_.find_entry(current_entry_pth_))
+    {
+        previous_lnks.reserve(previous_entry_stte->lnks.size());
+        for (auto& x : previous_entry_stte->lnks)
+        {
+            previous_lnks.emplace(x.pth, x.id);
+        }
+    }
+
+    entry_ids = vew.qury.evaluate(indx_);
+    current_entry_stte_.lnks.reserve(entry_ids.get_cardinality());
+
+    entry_ids.for_each([&](std::uint32_t entry_id)
+    {
+        entry_pth = spd::cast::type_cast<string_type>(std::string(indx_.get_entry_path(entry_id)));
+        set_current_entry_name(entry_pth);
+
+        relative_pth.clear();
+        relative_pth += dir.relative_pth;
+        relative_pth += std::filesystem::path::preferred_separator;
+        relative_pth += current_entry_lnk_nme_;
+
+        auto it = previous_lnks.find(relative_pth);
+        if (it != previous_lnks.end())
+        {
+            file_id_st_.insert(it->second);
+            current_entry_stte_.lnks.push_back({relative_pth, it->second});
+            return;
+        }
+
+        plan_shortcut(entry_pth, dir);
+    });
+
+    keep_entry_links();
+
+    // A view without links keeps its directory through its record.
+    if (current_entry_stte_.lnks.empty())
+    {
+        current_entry_stte_.dirs.push_back(dir.relative_pth);
+    }
+
+    current_entry_lnk_dirs_.clear();
+    current_stte_.add_entry(current_entry_pth_, std::move(current_entry_stte_));
+
+    std::cout << spd::ios::set_light_green_text << "[ok]"
+              << spd::ios::set_default_text << std::endl;
+
+    return true;
+}
+
+
+void program::apply_plan()
+{
+    std::error_code err_code;
+    file_id id;
+    bool succss = false;
+
+#if defined(__linux__)
+    if (prog_args_.queue_depth > 0 && file_op_rng_.open(get_ring_queue_depth()))
+    {
+        auto complete_operation = [&](std::size_t idx, bool succss, const file_id& id)
+        {
+            complete_planned_operation(plan_[idx], succss, id);
+        };
+
+        for (std::size_t i = 0; i < plan_.size(); ++i)
+        {
+            file_op_rng_.push(plan_[i].op_type,
+                              plan_[i].op_type == file_operation_types::SYMLINK ||
+                              plan_[i].op_type == file_operation_types::RELINK ?
+                                      get_shortcut_actual_path(plan_[i].pth) : plan_[i].pth,
+                              plan_[i].target_pth, plan_[i].previous_pth, i, complete_operation);
+        }
+
+        file_op_rng_.flush(complete_operation);
+        return;
+    }
+#endif
+
+    for (auto& x : plan_)
+    {
+        id = file_id();
+
+        switch (x.op_type)
+        {
+            case file_operation_types::MKDIR:
+                succss = make_directory(x.pth, &id);
+                break;
+
+            case file_operation_types::SYMLINK:
+                succss = make_shortcut(x.target_pth, x.pth, &id);
+                break;
+
+            // The link replaced may already be gone, but not still be there.
+            case file_operation_types::RELINK:
+                succss = (remove_file(x.previous_pth, false) ||
+                          !std::filesystem::exists(
+                                  std::filesystem::symlink_status(x.previous_pth, err_code))) &&
+                         make_shortcut(x.target_pth, x.pth, &id);
+                break;
+
+            case file_operation_types::UNLINK:
+                succss = remove_file(x.pth, false);
+                break;
+
+            case file_operation_types::RMDIR:
+                succss = remove_file(x.pth, true);
+                break;
+        }
+
+        complete_planned_operation(x, succss, id);
+    }
+}
+
+
+void program::complete_planned_operation(
+        const file_operation& op,
+        bool succss,
+        const file_id& id
+)
+{
+    file_id lnk_id = id;
+
+    // A link that could not be moved is removed and created again with plain calls.
+    if (!succss && op.op_type == file_operation_types::RELINK)
+    {
+        succss = recreate_moved_link(op, &lnk_id);
+    }
+
+    if (succss)
+    {
+        if (op.op_type == file_operation_types::MKDIR)
+        {
+            keep_directory_id(op.pth, id);
+            configure_directory(op.pth);
+        }
+        else if (op.op_type == file_operation_types::SYMLINK ||
+                 op.op_type == file_operation_types::RELINK)
+        {
+            file_id_st_.insert(lnk_id);
+            current_stte_.set_link_id(op.categories_file_pth,
+                                      get_destination_relative_path(get_shortcut_actual_path(op.pth)),
+                                      lnk_id);
+        }
+
+        return;
+    }
+
+    std::cout << spd::ios::set_light_red_text
+              << (op.op_type == file_operation_types::MKDIR ? "Unable to create directory: " :
+                  op.op_type == file_operation_types::SYMLINK ? "Unable to create link: " :
+                  op.op_type == file_operation_types::RELINK ? "Unable to move link: " :
+                  op.op_type == file_operation_types::UNLINK ? "Unable to remove link: " :
+                                                               "Unable to remove directory: ")
+              << spd::ios::set_white_text
+              << "\""
+              << spd::cast::type_cast<std::string>(op.pth.c_str())
+              << "\""
+              << spd::ios::set_default_text
+              << spd::ios::newl;
+
+    // The categories file will be processed again during the next run, or the next pass of the
+    // watch mode.
+    if (!op.categories_file_pth.empty())
+    {
+        current_stte_.remove_entry(op.categories_file_pth);
+        indx_.remove_entry(get_entry_key(op.categories_file_pth));
+        retried_pths_.insert(op.categories_file_pth);
+    }
+}
+
+
+bool program::recreate_moved_link(const file_operation& op, file_id* id)
+{
+    std::filesystem::path lnk_pth = get_shortcut_actual_path(op.pth);
+    std::error_code err_code;
+
+    // The previous link is left to the next run if it cannot be removed.
+    if (!remove_file(op.previous_pth, false) &&
+        std::filesystem::exists(std::filesystem::symlink_status(op.previous_pth, err_code)))
+    {
+        std::cout << spd::ios::set_light_red_text
+                  << "Unable to remove link: "
+                  << spd::ios::set_white_text
+                  << "\""
+                  << spd::cast::type_cast<std::string>(op.previous_pth.c_str())
+                  << "\""
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
+
+        keep_unmoved_link(op);
+    }
+
+    // The new link may have been created before the removal failed.
+    if (std::filesystem::is_symlink(std::filesystem::symlink_status(lnk_pth, err_code)) &&
+        std::filesystem::read_symlink(lnk_pth, err_code) == op.target_pth)
+    {
+        *id = get_file_id(lnk_pth);
+        return true;
+    }
+
+    return make_shortcut(op.target_pth, op.pth, id);
+}
+
+
+void program::keep_unmoved_link(const file_operation& op)
+{
+    auto it = moved_entries_.find(op.categories_file_pth);
+    const entry_state* previous_entry_stte;
+    const entry_state* kept_entry_stte;
+    string_type lnk_pth;
+    entry_state entry_stte;
+
+    if (it == moved_entries_.end() ||
+        (previous_entry_stte = find_previous_entry(it->second)) == nullptr)
+    {
+        return;
+    }
+
+    // The link stays recorded under the previous categories file, which no longer exists, so the
+    // next run removes it as stale.
+    moved_entry_pths_.erase(it->second);
+    lnk_pth = get_destination_relative_path(op.previous_pth);
+
+    if ((kept_entry_stte = current_stte_.find_entry(it->second)) != nullptr)
+    {
+        entry_stte = *kept_entry_stte;
+    }
+    else
+    {
+        entry_stte.categories_file_sig = previous_entry_stte->categories_file_sig;
+        entry_stte.content_hsh = previous_entry_stte->content_hsh;
+    }
+
+    for (auto& x : previous_entry_stte->lnks)
+    {
+        if (x.pth == lnk_pth)
+        {
+            entry_stte.lnks.push_back(x);
+        }
+    }
+
+    current_stte_.add_entry(it->second, std::move(entry_stte));
+    retried_pths_.insert(it->second);
+}
+
+
+void program::print_plan() const
+{
+    for (auto& x : plan_)
+    {
+        switch (x.op_type)
+        {
+            case file_operation_types::MKDIR:
+                std::cout << spd::ios::set_light_cyan_text << "Would create directory: ";
+                break;
+
+            case file_operation_types::SYMLINK:
+                std::cout << spd::ios::set_light_cyan_text << "Would create link: ";
+                break;
+
+            case file_operation_types::RELINK:
+                std::cout << spd::ios::set_light_cyan_text
+                          << "Would move link: "
+                          << spd::ios::set_white_text
+                          << "\""
+                          << spd::cast::type_cast<std::string>(x.previous_pth.c_str())
+                          << "\" to ";
+                break;
+
+            case file_operation_types::UNLINK:
+                std::cout << spd::ios::set_yellow_text << "Would remove outdated link: ";
+                break;
+
+            case file_operation_types::RMDIR:
+                std::cout << spd::ios::set_yellow_text << "Would remove directory: ";
+                break;
+        }
+
+        std::cout << spd::ios::set_white_text
+                  << "\""
+                  << spd::cast::type_cast<std::string>(x.pth.c_str())
+                  << "\"";
+
+        if (x.op_type == file_operation_types::SYMLINK ||
+            x.op_type == file_operation_types::RELINK)
+        {
+            std::cout << " -> \""
+                      << spd::cast::type_cast<std::string>(x.target_pth.c_str())
+                      << "\"";
+        }
+
+        std::cout << spd::ios::set_default_text << spd::ios::newl;
+    }
+
+    for (auto it = extra_fles_.rbegin(); it != extra_fles_.rend(); ++it)
+    {
+        std::cout << spd::ios::set_yellow_text
+                  << (it->op_type == file_operation_types::RMDIR ?
+                              "Would remove stale directory: " : "Would remove stale link: ")
+                  << spd::ios::set_white_text
+                  << "\""
+                  << spd::cast::type_cast<std::string>(it->pth.c_str())
+                  << "\""
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
+    }
+}
+
+
+bool program::make_directory(const std::filesystem::path& directory_pth, file_id* id)
+{
+#if defined(_WIN32)
+    destination_file_status file_stat;
+
+    spd::sys::fsys::mkdir(directory_pth.c_str());
+    if (!get_destination_file_status(directory_pth, &file_stat) || !file_stat.is_directory)
+    {
+        return false;
+    }
+
+    *id = file_stat.id;
+
+    return true;
+
+#else
+    int parent_fd = dir_handle_cche_.get_handle(directory_pth.parent_path());
+    std::filesystem::path directory_nme = directory_pth.filename();
+    struct stat st;
+
+    if (parent_fd < 0)
     {
         return false;
     }
-#endif
-}
 
-
-bool program::make_directory(const std::filesystem::path& directory_pth)
-{
-    spd::sys::fsys::mkdir(directory_pth.c_str());
-    if (!spd::sys::fsys::is_directory(directory_pth.c_str()))
+    ::mkdirat(parent_fd, directory_nme.c_str(), 0777);
+    if (::fstatat(parent_fd, directory_nme.c_str(), &st, AT_SYMLINK_NOFOLLOW) != 0 ||
+        !S_ISDIR(st.st_mode))
     {
         return false;
     }
 
-    inode_st_.insert(spd::sys::fsys::get_file_inode(directory_pth.c_str()));
-    configure_directory(directory_pth);
+    *id = {static_cast<std::uint64_t>(st.st_dev), static_cast<std::uint64_t>(st.st_ino)};
 
     return true;
+#endif
 }
 
 
@@ -374,7 +2300,7 @@ bool program::configure_directory(const std::filesystem::path& directory_pth)
 
     SetFileAttributesW(desktop_ini_pth.c_str(), 0x26);
     SetFileAttributesW(directory_pth.c_str(), 0x11);
-    inode_st_.insert(spd::sys::fsys::get_file_inode(desktop_ini_pth.c_str()));
+    keep_directory_id(directory_pth, get_file_id(desktop_ini_pth));
 
     return true;
 #endif
@@ -383,150 +2309,515 @@ bool program::configure_directory(const std::filesystem::path& directory_pth)
 
 bool program::make_shortcut(
         const std::filesystem::path& target_pth,
-        const std::filesystem::path& shortcut_pth
+        const std::filesystem::path& shortcut_pth,
+        file_id* id
 )
 {
-    string_type shortcut_actual_pth = shortcut_pth;
-    spd::sys::tm::system_time target_modification_tme;
-    spd::sys::tm::system_time shortcut_modification_tme;
-    std::filesystem::path target_json_pth = target_pth / prog_args_.categories_file_nme;
+#if defined(_WIN32)
+    if (!spd::sys::fsys::shortcut(target_pth.c_str(), shortcut_pth.c_str()))
+    {
+        return false;
+    }
 
-    shortcut_actual_pth += spd::type_casting::type_cast<string_type>(
-            SPEED_SYSTEM_FILESYSTEM_SHORTCUT_EXTENSION_CSTR);
-    
-    if (spd::sys::fsys::file_exists(shortcut_actual_pth.c_str()))
+    *id = get_file_id(get_shortcut_actual_path(shortcut_pth));
+
+    return true;
+
+#else
+    std::filesystem::path shortcut_actual_pth = get_shortcut_actual_path(shortcut_pth);
+    int parent_fd = dir_handle_cche_.get_handle(shortcut_actual_pth.parent_path());
+    std::filesystem::path shortcut_nme = shortcut_actual_pth.filename();
+    struct stat st;
+
+    if (parent_fd < 0 || ::symlinkat(target_pth.c_str(), parent_fd, shortcut_nme.c_str()) != 0 ||
+        ::fstatat(parent_fd, shortcut_nme.c_str(), &st, AT_SYMLINK_NOFOLLOW) != 0)
     {
-        spd::sys::fsys::get_modification_time(target_json_pth.c_str(),
-                                              &target_modification_tme);
-        spd::sys::fsys::get_modification_time(shortcut_actual_pth.c_str(),
-                                              &shortcut_modification_tme);
-        
-        if (shortcut_modification_tme >= target_modification_tme)
-        {
-            inode_st_.insert(spd::sys::fsys::get_file_inode(shortcut_actual_pth.c_str()));
-            return true;
-        }
-        
-        spd::sys::fsys::unlink(shortcut_actual_pth.c_str());
+        return false;
     }
 
-    if (!spd::sys::fsys::shortcut(target_pth.c_str(), shortcut_pth.c_str()))
+    *id = {static_cast<std::uint64_t>(st.st_dev), static_cast<std::uint64_t>(st.st_ino)};
+
+    return true;
+#endif
+}
+
+
+bool program::remove_file(const std::filesystem::path& file_pth, bool is_directory)
+{
+#if defined(_WIN32)
+    return is_directory ? spd::sys::fsys::rmdir(file_pth.c_str()) :
+                          spd::sys::fsys::unlink(file_pth.c_str());
+
+#else
+    int parent_fd = dir_handle_cche_.get_handle(file_pth.parent_path());
+
+    if (parent_fd < 0)
+    {
+        return false;
+    }
+
+    if (is_directory)
+    {
+        dir_handle_cche_.forget(file_pth);
+    }
+
+    return ::unlinkat(parent_fd, file_pth.filename().c_str(),
+                      is_directory ? AT_REMOVEDIR : 0) == 0;
+#endif
+}
+
+
+bool program::get_destination_file_status(
+        const std::filesystem::path& file_pth,
+        destination_file_status* file_stat
+)
+{
+    return get_destination_file_status(file_pth.parent_path(), file_pth.filename().native(),
+                                       file_stat);
+}
+
+
+bool program::get_destination_file_status(
+        const std::filesystem::path& directory_pth,
+        const string_type& file_nme,
+        destination_file_status* file_stat
+)
+{
+#if defined(_WIN32)
+    std::filesystem::path file_pth = directory_pth / file_nme;
+    std::error_code err_code;
+    auto file_stus = std::filesystem::symlink_status(file_pth, err_code);
+
+    if (err_code || !std::filesystem::exists(file_stus))
+    {
+        return false;
+    }
+
+    auto last_write_tme = std::filesystem::last_write_time(file_pth, err_code);
+    file_stat->mtime_ns = err_code ? 0 : std::chrono::duration_cast<std::chrono::nanoseconds>(
+            last_write_tme.time_since_epoch()).count();
+    file_stat->is_directory = std::filesystem::is_directory(file_stus);
+    file_stat->id = get_file_id(file_pth);
+
+    return true;
+
+#elif defined(__linux__)
+    int parent_fd = dir_handle_cche_.get_handle(directory_pth);
+    struct statx stx;
+
+    // One call gives the type, the identifier and the modification time, without following links.
+    if (parent_fd < 0 ||
+        ::statx(parent_fd, file_nme.c_str(), AT_SYMLINK_NOFOLLOW,
+                STATX_TYPE | STATX_INO | STATX_MTIME, &stx) != 0)
+    {
+        return false;
+    }
+
+    file_stat->id = {makedev(stx.stx_dev_major, stx.stx_dev_minor), stx.stx_ino};
+    file_stat->mtime_ns = static_cast<std::int64_t>(stx.stx_mtime.tv_sec) * 1000000000 +
+                          stx.stx_mtime.tv_nsec;
+    file_stat->is_directory = S_ISDIR(stx.stx_mode);
+
+    return true;
+
+#else
+    int parent_fd = dir_handle_cche_.get_handle(directory_pth);
+    struct stat st;
+
+    if (parent_fd < 0 ||
+        ::fstatat(parent_fd, file_nme.c_str(), &st, AT_SYMLINK_NOFOLLOW) != 0)
     {
         return false;
     }
 
-    inode_st_.insert(spd::sys::fsys::get_file_inode(shortcut_actual_pth.c_str()));
+    file_stat->id = {static_cast<std::uint64_t>(st.st_dev), static_cast<std::uint64_t>(st.st_ino)};
+#if defined(__APPLE__)
+    file_stat->mtime_ns = static_cast<std::int64_t>(st.st_mtimespec.tv_sec) * 1000000000 +
+                          st.st_mtimespec.tv_nsec;
+#else
+    file_stat->mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 +
+                          st.st_mtim.tv_nsec;
+#endif
+    file_stat->is_directory = S_ISDIR(st.st_mode);
+
     return true;
+#endif
 }
 
 
-void program::check_extra_file(const std::filesystem::path& extra_file_pth)
+void program::keep_directory_id(const std::filesystem::path& directory_pth, const file_id& id)
 {
-    if (!inode_st_.contains(spd::sys::fsys::get_file_inode(extra_file_pth.c_str())))
+    string_type relative_pth = get_destination_relative_path(directory_pth);
+
+    file_id_st_.insert(id);
+    if (!relative_pth.empty())
     {
-        if (spd::sys::fsys::is_directory(extra_file_pth.c_str()))
-        {
-            std::cout << spd::ios::set_yellow_text
-                      << "Found extra directory: "
-                      << spd::ios::set_white_text
-                      << "\""
-                      << spd::cast::type_cast<std::string>(extra_file_pth.c_str())
-                      << "\""
-                      << spd::ios::set_default_text
-                      << spd::ios::newl;
+        current_stte_.add_directory_id(relative_pth, id);
+    }
+}
 
-            extra_files_fnd_ = true;
-        }
-        else if (extra_file_pth.extension() == ".lnk" ||
-                 extra_file_pth.extension() == ".ini" ||
-                 extra_file_pth.extension().empty())
-        {
-            std::cout << spd::ios::set_yellow_text
-                      << "Found extra file: "
-                      << spd::ios::set_white_text
-                      << "\""
-                      << spd::cast::type_cast<std::string>(extra_file_pth.c_str())
-                      << "\""
-                      << spd::ios::set_default_text
-                      << spd::ios::newl;
 
-            extra_files_fnd_ = true;
-        }
+void program::keep_produced_file(const std::filesystem::path& file_pth, const file_id& id)
+{
+    file_id_st_.insert(id);
+    current_entry_stte_.lnks.push_back({get_destination_relative_path(file_pth), id});
+}
+
+
+std::filesystem::path program::get_shortcut_actual_path(const std::filesystem::path& shortcut_pth)
+{
+    string_type shortcut_actual_pth = shortcut_pth;
+
+    shortcut_actual_pth += spd::type_casting::type_cast<string_type>(
+            SPEED_SYSTEM_FILESYSTEM_SHORTCUT_EXTENSION_CSTR);
+
+    return shortcut_actual_pth;
+}
+
+
+program::string_type program::get_destination_relative_path(
+        const std::filesystem::path& pth
+) const
+{
+    const string_type& pth_str = pth.native();
+
+    if (pth_str.size() < destination_prefix_len_)
+    {
+        return {};
     }
+
+    return pth_str.substr(destination_prefix_len_);
 }
 
 
-void program::delete_extra_file(const std::filesystem::path& extra_file_pth) const
+void program::plan_stale_files()
 {
-    if (!inode_st_.contains(spd::sys::fsys::get_file_inode(extra_file_pth.c_str())))
+    std::unordered_map<string_type, file_id> stale_lnks;
+    std::vector<std::pair<string_type, file_id>> sorted_stale_lnks;
+    std::vector<string_type> stale_dir_pths;
+    std::unordered_set<string_type> candidate_dir_pths;
+    std::filesystem::path lnk_pth;
+
+    // The links of the entries that changed or disappeared are stale unless an entry of this pass
+    // produces them.
+    previous_stte_.for_each_entry([&](const string_type& categories_file_pth,
+                                      const entry_state& previous_entry_stte)
     {
-        if (spd::sys::fsys::is_directory(extra_file_pth.c_str()))
+        const entry_state* entry_stte = current_stte_.find_entry(categories_file_pth);
+
+        // The links of a renamed entry have been moved along with it.
+        if (moved_entry_pths_.contains(categories_file_pth))
         {
-            std::cout << spd::ios::set_light_red_text
-                      << "Deleting directory: "
-                      << spd::ios::set_white_text
-                      << "\""
-                      << spd::cast::type_cast<std::string>(extra_file_pth.c_str())
-                      << "\" ";
+            return;
+        }
+
+        if (entry_stte != nullptr &&
+            std::equal(entry_stte->lnks.begin(), entry_stte->lnks.end(),
+                       previous_entry_stte.lnks.begin(), previous_entry_stte.lnks.end(),
+                       [](const link_state& lhs, const link_state& rhs)
+        {
+            return lhs.pth == rhs.pth;
+        }))
+        {
+            return;
+        }
+
+        for (auto& x : previous_entry_stte.lnks)
+        {
+            stale_lnks.emplace(x.pth, x.id);
+        }
+    });
+
+    // The watch mode keeps the directories of the last pass in the state, only the ones that the
+    // entries classified again used can have been left empty.
+    if (current_stte_.is_tracking_changes())
+    {
+        std::erase_if(stale_lnks, [&](const auto& x)
+        {
+            return current_stte_.is_link_used(x.first);
+        });
+
+        previous_stte_.for_each_entry([&](const string_type&, const entry_state& entry_stte)
+        {
+            for (auto& x : entry_stte.lnks)
+            {
+                add_parent_directories(x.pth, &candidate_dir_pths);
+            }
 
-            if (spd::sys::fsys::rmdir(extra_file_pth.c_str()))
+            for (auto& x : entry_stte.dirs)
             {
-                std::cout << spd::ios::set_light_green_text
-                          << "[ok]"
-                          << spd::ios::set_default_text
-                          << spd::ios::newl;
+                add_parent_directories(x, &candidate_dir_pths);
+                candidate_dir_pths.insert(x);
             }
-            else
+        });
+
+        for (auto& x : candidate_dir_pths)
+        {
+            if (current_stte_.find_directory(x) != nullptr && !current_stte_.is_directory_used(x))
             {
-                std::cout << spd::ios::set_light_red_text
-                          << "[fail]"
-                          << spd::ios::set_default_text
-                          << spd::ios::newl;
+                stale_dir_pths.push_back(x);
             }
         }
-        else if (extra_file_pth.extension() == ".lnk" ||
-                 extra_file_pth.extension() == ".ini" ||
-                 extra_file_pth.extension().empty())
+    }
+    else
+    {
+        if (!stale_lnks.empty())
         {
-            std::cout << spd::ios::set_light_red_text
-                      << "Deleting file: "
-                      << spd::ios::set_white_text
-                      << "\""
-                      << spd::cast::type_cast<std::string>(extra_file_pth.c_str())
-                      << "\" ";
+            current_stte_.for_each_entry([&](const string_type&, const entry_state& entry_stte)
+            {
+                for (auto& x : entry_stte.lnks)
+                {
+                    stale_lnks.erase(x.pth);
+                }
+            });
+        }
 
-            if (spd::sys::fsys::unlink(extra_file_pth.c_str()))
+        previous_stte_.for_each_directory([&](const string_type& directory_pth)
+        {
+            if (current_stte_.find_directory(directory_pth) == nullptr)
             {
-                std::cout << spd::ios::set_light_green_text
-                          << "[ok]"
-                          << spd::ios::set_default_text
-                          << spd::ios::newl;
+                stale_dir_pths.push_back(directory_pth);
             }
-            else
+        });
+
+        // The stale directories stay in the state until they are deleted, so that a deletion
+        // declined or failed is reported again by the next run.
+        for (auto& x : stale_dir_pths)
+        {
+            for (auto& id : *previous_stte_.find_directory(x))
             {
-                std::cout << spd::ios::set_light_red_text
-                          << "[fail]"
-                          << spd::ios::set_default_text
-                          << spd::ios::newl;
+                current_stte_.add_directory_id(x, id);
+            }
+        }
+    }
+
+    // The removals are done in reverse order: the links first, then the directories from the
+    // deepest one.
+    std::sort(stale_dir_pths.begin(), stale_dir_pths.end());
+    for (auto& x : stale_dir_pths)
+    {
+        extra_fles_.push_back(
+                {file_operation_types::RMDIR, prog_args_.destination_dir / x, {}, {}, {}});
+    }
+
+    sorted_stale_lnks.assign(stale_lnks.begin(), stale_lnks.end());
+    std::sort(sorted_stale_lnks.begin(), sorted_stale_lnks.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    // A recorded path that no longer holds the link created there is not touched, whatever
+    // replaced it is only found by an audit. A stale link stays in the state, recorded under its
+    // own path, until it is deleted.
+    for (auto& x : sorted_stale_lnks)
+    {
+        lnk_pth = prog_args_.destination_dir / x.first;
+        if (is_recorded_link(lnk_pth, x.second))
+        {
+            entry_state entry_stte;
+            entry_stte.lnks.push_back({x.first, x.second});
+            current_stte_.add_entry(lnk_pth.native(), std::move(entry_stte));
+
+            extra_fles_.push_back({file_operation_types::UNLINK, std::move(lnk_pth), {}, {}, {}});
+        }
+    }
+}
+
+
+void program::add_parent_directories(
+        const string_type& pth,
+        std::unordered_set<string_type>* directory_pths
+)
+{
+    std::size_t separator_pos = pth.find_last_of(std::filesystem::path::preferred_separator);
+
+    // The parents of a directory already added have been added along with it.
+    while (separator_pos != string_type::npos &&
+           directory_pths->insert(pth.substr(0, separator_pos)).second)
+    {
+        separator_pos = pth.find_last_of(std::filesystem::path::preferred_separator,
+                                         separator_pos - 1);
+    }
+}
+
+
+bool program::is_recorded_link(const std::filesystem::path& lnk_pth, const file_id& id)
+{
+    if (id == file_id())
+    {
+        return false;
+    }
+
+#if defined(_WIN32)
+    std::error_code err_code;
+
+    return std::filesystem::is_regular_file(std::filesystem::symlink_status(lnk_pth, err_code)) &&
+           get_file_id(lnk_pth) == id;
+
+#else
+    int parent_fd = dir_handle_cche_.get_handle(lnk_pth.parent_path());
+    struct stat st;
+
+    return parent_fd >= 0 &&
+           ::fstatat(parent_fd, lnk_pth.filename().c_str(), &st, AT_SYMLINK_NOFOLLOW) == 0 &&
+           S_ISLNK(st.st_mode) &&
+           file_id{static_cast<std::uint64_t>(st.st_dev), static_cast<std::uint64_t>(st.st_ino)} ==
+                   id;
+#endif
+}
+
+
+void program::print_stale_file(const file_operation& stale_fle) const
+{
+    std::cout << spd::ios::set_yellow_text
+              << (stale_fle.op_type == file_operation_types::RMDIR ? "Found stale directory: " :
+                                                                     "Found stale link: ")
+              << spd::ios::set_white_text
+              << "\""
+              << spd::cast::type_cast<std::string>(stale_fle.pth.c_str())
+              << "\""
+              << spd::ios::set_default_text
+              << spd::ios::newl;
+}
+
+
+void program::check_extra_file(
+        const std::filesystem::path& extra_file_pth,
+        const file_id& id,
+        bool is_directory
+)
+{
+    if (file_id_st_.contains(id) || !is_audited_file_name(extra_file_pth.filename().native()))
+    {
+        return;
+    }
+
+    std::cout << spd::ios::set_yellow_text
+              << (is_directory ? "Found extra directory: " : "Found extra file: ")
+              << spd::ios::set_white_text
+              << "\""
+              << spd::cast::type_cast<std::string>(extra_file_pth.c_str())
+              << "\""
+              << spd::ios::set_default_text
+              << spd::ios::newl;
+
+    extra_fles_.push_back({is_directory ? file_operation_types::RMDIR :
+                                          file_operation_types::UNLINK,
+                           extra_file_pth, {}, {}, {}});
+}
+
+
+bool program::is_audited_file_name(const string_type& file_nme)
+{
+    // Equivalent to the regex ^([^\.]*|.*\.lnk|.*\.ini)$, the names that classifier can produce.
+    auto ends_with = [&](const char* suffx)
+    {
+        std::size_t suffx_len = std::strlen(suffx);
+
+        if (file_nme.size() < suffx_len)
+        {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < suffx_len; ++i)
+        {
+            if (file_nme[file_nme.size() - suffx_len + i] != static_cast<char_type>(suffx[i]))
+            {
+                return false;
             }
         }
+
+        return true;
+    };
+
+    return file_nme.find(static_cast<char_type>('.')) == string_type::npos ||
+           ends_with(".lnk") || ends_with(".ini");
+}
+
+
+void program::delete_extra_files()
+{
+#if defined(__linux__)
+    if (prog_args_.queue_depth > 0 && file_op_rng_.open(get_ring_queue_depth()))
+    {
+        auto complete_deletion = [&](std::size_t idx, bool succss, const file_id&)
+        {
+            complete_extra_file_deletion(extra_fles_[idx], succss);
+        };
+
+        for (std::size_t i = extra_fles_.size(); i > 0; --i)
+        {
+            file_op_rng_.push(extra_fles_[i - 1].op_type, extra_fles_[i - 1].pth, {}, {}, i - 1,
+                              complete_deletion);
+        }
+
+        file_op_rng_.flush(complete_deletion);
+        return;
+    }
+#endif
+
+    for (auto it = extra_fles_.rbegin(); it != extra_fles_.rend(); ++it)
+    {
+        complete_extra_file_deletion(
+                *it, remove_file(it->pth, it->op_type == file_operation_types::RMDIR));
     }
 }
 
 
-void program::escape_special_characters_in_regex_string(std::string& inpt)
+void program::complete_extra_file_deletion(const file_operation& extra_fle, bool succss)
 {
-    const std::string special_chars = R"([\^$.|?*+(){}])";
+    print_extra_file_deletion(extra_fle, succss);
 
-    for (auto it = inpt.begin(); it != inpt.end(); ++it)
+    if (succss)
     {
-        if (special_chars.find(*it) != std::string::npos)
+        if (extra_fle.op_type == file_operation_types::RMDIR)
+        {
+            current_stte_.remove_directory(get_destination_relative_path(extra_fle.pth));
+        }
+        else
         {
-            it = inpt.insert(it, '\\');
-            ++it;
+            current_stte_.remove_entry(extra_fle.pth.native());
         }
     }
+    // The next pass of the watch mode tries again to delete a stale link.
+    else if (current_stte_.find_entry(extra_fle.pth.native()) != nullptr)
+    {
+        retried_pths_.insert(extra_fle.pth.native());
+    }
+}
+
+
+void program::print_extra_file_deletion(const file_operation& extra_fle, bool succss) const
+{
+    std::cout << spd::ios::set_light_red_text
+              << (extra_fle.op_type == file_operation_types::RMDIR ? "Deleting directory: " :
+                                                                     "Deleting file: ")
+              << spd::ios::set_white_text
+              << "\""
+              << spd::cast::type_cast<std::string>(extra_fle.pth.c_str())
+              << "\" ";
+
+    if (succss)
+    {
+        std::cout << spd::ios::set_light_green_text
+                  << "[ok]"
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
+    }
+    else
+    {
+        std::cout << spd::ios::set_light_red_text
+                  << "[fail]"
+                  << spd::ios::set_default_text
+                  << spd::ios::newl;
+    }
+}
+
+
+#if defined(__linux__)
+unsigned program::get_ring_queue_depth() const
+{
+    return static_cast<unsigned>(std::min<std::size_t>(prog_args_.queue_depth, MAX_QUEUE_DEPTH));
 }
+#endif
 
 
 }
@@ -27,11 +27,32 @@
 #ifndef CLASSIFIER_PROGRAM_HPP
 #define CLASSIFIER_PROGRAM_HPP
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include <speed/speed.hpp>
 
+#include "bounded_queue.hpp"
+#include "categories_cache.hpp"
+#include "category_index.hpp"
+#include "category_list.hpp"
+#include "category_query.hpp"
+#include "daemon_server.hpp"
+#include "directory_handle_cache.hpp"
 #include "exception.hpp"
-#include "json.hpp"
+#include "file_id_set.hpp"
+#include "file_operation.hpp"
+#include "file_operation_ring.hpp"
 #include "program_args.hpp"
+#include "source_watcher.hpp"
+#include "state_file.hpp"
+#include "string_interner.hpp"
 
 
 /**
@@ -60,18 +81,185 @@ public:
     int execute();
 
 private:
-    bool parse_categories_file(const std::filesystem::path& categories_file_pth);
+    struct loaded_categories_file
+    {
+        std::filesystem::path categories_file_pth;
+
+        /** The entry path, or the line, in the catalog the categories come from, if any. */
+        std::filesystem::path catalog_entry_pth;
+
+        category_list categories;
+        entry_state entry_stte;
+        const entry_state* previous_entry_stte = nullptr;
+        const char* fail_reasn = nullptr;
+        std::exception_ptr excep;
+
+        /** The position of the file in the input, the files are parsed in this order. */
+        std::size_t seq_nbr = 0;
+
+        bool loaded = false;
+        bool unchanged = false;
+    };
+
+    /**
+     * @brief       A categories file found by the feeder stage for the loaders.
+     */
+    struct queued_categories_file
+    {
+        std::filesystem::path pth;
+        std::size_t seq_nbr = 0;
+    };
+
+    /**
+     * @brief       A line of the catalog, read by the catalog stage for the loaders.
+     */
+    struct catalog_line
+    {
+        std::string txt;
+        std::size_t nbr = 0;
+        std::size_t seq_nbr = 0;
+    };
+
+    /**
+     * @brief       A category directory, for a key or for a value of a key, planned during the run.
+     *              Its identifier is the identifier of its category in the index.
+     */
+    struct category_directory
+    {
+        std::uint32_t id = 0;
+        const category_directory* key_dir = nullptr;
+        std::filesystem::path pth;
+        string_type relative_pth;
+        bool planned = false;
+        bool built = false;
+    };
+
+    /**
+     * @brief       A view of the views file, a directory of links to the entries that match its
+     *              expression.
+     */
+    struct view
+    {
+        std::string nme;
+        category_query qury;
+    };
+
+    /**
+     * @brief       The attributes of a file of the destination directory, links not followed.
+     */
+    struct destination_file_status
+    {
+        file_id id;
+        std::int64_t mtime_ns = 0;
+        bool is_directory = false;
+    };
+
+    /** The capacity of the queues that connect the stages of the pipeline. */
+    static constexpr std::size_t QUEUE_CAPACITY = 1024;
+
+    /** The number of loaded files that can wait for the files before them to be parsed. */
+    static constexpr std::size_t REORDER_WINDOW = QUEUE_CAPACITY;
+
+    static constexpr std::size_t DIRECTORY_HANDLES_CAPACITY = 256;
+
+    static constexpr std::size_t MAX_QUEUE_DEPTH = 4096;
+
+    int execute_query();
+
+    void save_run_files();
+
+    void classify_source_directory();
+
+    void classify_categories_files(
+            std::size_t loaders_nbr,
+            const std::function<void(bounded_queue<queued_categories_file>&)>& feedr
+    );
+
+    bool classify_catalog();
+
+#if defined(__linux__)
+    int watch_source_directory();
+
+    void classify_changes(const source_changes& chnges);
+
+    void release_entry(const string_type& categories_file_pth);
+
+    std::uint32_t add_released_category(std::uint32_t ctgry_id);
 
-    bool parse_entries(json& json_parsr, const std::filesystem::path& current_source_dir);
+    bool post_reclassification(const std::filesystem::path& entry_pth, std::uint64_t* posted_nbr);
+
+    void publish_snapshot(
+            std::uint64_t updates_nbr,
+            std::uint64_t applied_nbr,
+            std::uint64_t update_duration_ms
+    );
+#endif
+
+    void load_categories_files(
+            bounded_queue<queued_categories_file>& categories_file_que,
+            bounded_queue<loaded_categories_file>& loaded_file_que
+    );
+
+    void load_catalog_lines(
+            bounded_queue<catalog_line>& catalog_line_que,
+            bounded_queue<loaded_categories_file>& loaded_file_que
+    );
+
+    void push_loaded_file(
+            bounded_queue<loaded_categories_file>& loaded_file_que,
+            loaded_categories_file&& loaded_fle
+    );
+
+    bool load_cached_categories(loaded_categories_file& loaded_fle);
+
+    void load_categories(loaded_categories_file& loaded_fle, std::string_view contnt);
+
+    void parse_loaded_files(
+            bounded_queue<loaded_categories_file>& loaded_file_que,
+            std::exception_ptr& excep
+    );
+
+    void parse_loaded_file(loaded_categories_file& loaded_fle, std::exception_ptr& excep);
+
+    bool parse_categories_file(loaded_categories_file& loaded_fle);
+
+    void discard_entry_operations(std::size_t plan_sz);
+
+    void keep_entry_links();
+
+    void keep_unchanged_entry(loaded_categories_file& loaded_fle);
+
+    bool move_renamed_entry(loaded_categories_file& loaded_fle);
+
+    void keep_previous_directory(string_type directory_pth);
+
+    [[nodiscard]] const entry_state* find_previous_entry(
+            const std::filesystem::path& categories_file_pth
+    ) const;
+
+    std::uint32_t add_previous_category(std::uint32_t previous_ctgry_id);
+
+    [[nodiscard]] static std::string get_entry_key(
+            const std::filesystem::path& categories_file_pth
+    );
+
+    void set_current_entry_name(const std::filesystem::path& source_dir);
+
+    bool parse_entries(
+            const category_list& categories,
+            const std::filesystem::path& current_source_dir
+    );
 
     bool parse_value(
-            json::value_type& val,
+            const category_list& categories,
+            const category_list::token& tokn,
             const std::filesystem::path& current_source_dir,
-            const std::filesystem::path& current_destination_dir
+            const category_directory& key_dir
     );
 
     bool parse_icon(
-            json::value_type& val,
+            const category_list& categories,
+            const category_list::token& tokn,
             const std::filesystem::path& current_source_dir,
             const std::filesystem::path& current_destination_dir
     );
@@ -81,28 +269,219 @@ private:
             const std::filesystem::path& current_destination_dir
     );
 
-    bool make_directory(const std::filesystem::path& directory_pth);
+    const category_directory* plan_category_directory(
+            const category_directory* key_dir,
+            std::string_view nme
+    );
+
+    bool plan_directory(
+            const std::filesystem::path& directory_pth,
+            const string_type& relative_pth
+    );
+
+    void add_entry_directory(const category_directory& dir);
+
+    bool plan_shortcut(const std::filesystem::path& target_pth, const category_directory& dir);
+
+    bool load_views();
+
+    void plan_views();
+
+    bool plan_view(const view& vew, std::uint32_t dir_id);
+
+    void apply_plan();
+
+    void complete_planned_operation(const file_operation& op, bool succss, const file_id& id);
+
+    bool recreate_moved_link(const file_operation& op, file_id* id);
+
+    void keep_unmoved_link(const file_operation& op);
+
+    void print_plan() const;
+
+    bool make_directory(const std::filesystem::path& directory_pth, file_id* id);
 
     bool configure_directory(const std::filesystem::path& directory_pth);
 
     bool make_shortcut(
             const std::filesystem::path& target_pth,
-            const std::filesystem::path& shortcut_pth
+            const std::filesystem::path& shortcut_pth,
+            file_id* id
     );
 
-    void check_extra_file(const std::filesystem::path& extra_file_pth);
+    bool remove_file(const std::filesystem::path& file_pth, bool is_directory);
 
-    void delete_extra_file(const std::filesystem::path& extra_file_pth) const;
+    bool get_destination_file_status(
+            const std::filesystem::path& file_pth,
+            destination_file_status* file_stat
+    );
+
+    bool get_destination_file_status(
+            const std::filesystem::path& directory_pth,
+            const string_type& file_nme,
+            destination_file_status* file_stat
+    );
+
+    void keep_directory_id(const std::filesystem::path& directory_pth, const file_id& id);
 
-    void escape_special_characters_in_regex_string(std::string& inpt);
+    void keep_produced_file(const std::filesystem::path& file_pth, const file_id& id);
+
+    static std::filesystem::path get_shortcut_actual_path(const std::filesystem::path& shortcut_pth);
+
+    [[nodiscard]] string_type get_destination_relative_path(
+            const std::filesystem::path& pth
+    ) const;
+
+    void plan_stale_files();
+
+    static void add_parent_directories(
+            const string_type& pth,
+            std::unordered_set<string_type>* directory_pths
+    );
+
+    bool is_recorded_link(const std::filesystem::path& lnk_pth, const file_id& id);
+
+    void print_stale_file(const file_operation& stale_fle) const;
+
+    void check_extra_file(
+            const std::filesystem::path& extra_file_pth,
+            const file_id& id,
+            bool is_directory
+    );
+
+    static bool is_audited_file_name(const string_type& file_nme);
+
+    void delete_extra_files();
+
+    void complete_extra_file_deletion(const file_operation& extra_fle, bool succss);
+
+    void print_extra_file_deletion(const file_operation& extra_fle, bool succss) const;
+
+#if defined(__linux__)
+    [[nodiscard]] unsigned get_ring_queue_depth() const;
+#endif
 
 private:
     /** The program arguments. */
     program_args prog_args_;
 
-    std::set<std::uint64_t> inode_st_;
+    /** The identifiers of the files produced, every other file is an extra file. */
+    file_id_set file_id_st_;
+
+    /** The state saved by the previous run. */
+    state_file previous_stte_;
+
+    /** The state of the current run. */
+    state_file current_stte_;
+
+    /** The category lists of the categories files parsed by the previous runs and this one. */
+    categories_cache categories_cche_;
+
+    /** The category lists released by the applier, their storage is reused by the loaders. */
+    bounded_queue<category_list> recycled_categories_que_;
+
+    /** The position of the next loaded file to parse, a loader waits before handing over a file
+     *  too far ahead of it. */
+    std::atomic<std::size_t> next_seq_nbr_;
 
-    bool extra_files_fnd_;
+    /** The views to build in the destination directory. */
+    std::vector<view> views_;
+
+    /** The signature of the catalog, shared by all the entries it holds. */
+    file_signature catalog_sig_;
+
+    /** The path of the categories file being planned. */
+    string_type current_entry_pth_;
+
+    /** The state of the categories file being planned. */
+    entry_state current_entry_stte_;
+
+    /** The operations needed to bring the destination directory to the desired state. */
+    std::vector<file_operation> plan_;
+
+    /** The index saved by the previous run, unchanged entries take their categories from it. */
+    category_index previous_indx_;
+
+    /** The index of the current run, built while the categories files are planned. */
+    category_index indx_;
+
+    /** The categories of the current index by the categories of the previous one, if known. */
+    std::vector<std::uint32_t> previous_ctgry_ids_;
+
+    /** The category directories, built once per run, by category identifier. A deque keeps them
+     *  in place while categories met later are added. */
+    std::deque<category_directory> category_dirs_;
+
+    /** The names of the entries met during the run. */
+    string_interner entry_nmes_;
+
+    /** The links that the plan creates, by category directory and entry name identifiers. */
+    std::unordered_set<std::uint64_t> planned_shortcuts_;
+
+    /** The name of the entry being planned, the name of its links. */
+    std::filesystem::path current_entry_nme_;
+
+    std::uint32_t current_entry_nme_id_;
+
+    /** The file name of the links of the entry being planned, with the shortcut extension. */
+    string_type current_entry_lnk_nme_;
+
+    /** The category directories of the entry being planned. */
+    std::vector<const category_directory*> current_entry_dirs_;
+
+    /** The category directories holding the links of the entry being planned. */
+    std::vector<const category_directory*> current_entry_lnk_dirs_;
+
+    /** The categories of the entry being planned. */
+    std::vector<std::uint32_t> current_entry_ctgries_;
+
+    std::size_t destination_prefix_len_;
+
+    /** The removal of the extra files found by the audit of the destination directory. */
+    std::vector<file_operation> extra_fles_;
+
+    /** The files that a run leaves in the destination directory for the next one. */
+    std::filesystem::path state_file_pth_;
+
+    std::filesystem::path cache_file_pth_;
+
+    std::filesystem::path index_file_pth_;
+
+    /** The categories files to classify again even if they have not changed. */
+    std::unordered_set<string_type> forced_pths_;
+
+    /** The categories files whose entry could not be completed, classified again by the next
+     *  pass of the watch mode. */
+    std::unordered_set<string_type> retried_pths_;
+
+    /** The categories files of the previous state by entry directory, built when the first new
+     *  entry of the run is met. */
+    std::unordered_map<file_id, string_type, file_id_hash> previous_entry_dirs_;
+
+    bool previous_entry_dirs_built_;
+
+    /** The categories files of the previous state whose entry has been renamed, their links are
+     *  moved instead of being removed. */
+    std::unordered_set<string_type> moved_entry_pths_;
+
+    /** The previous categories file of each renamed entry, by its new categories file. */
+    std::unordered_map<string_type, string_type> moved_entries_;
+
+#if !defined(_WIN32)
+    /** The open destination directories, the operations only resolve the last path component. */
+    directory_handle_cache dir_handle_cche_;
+#endif
+
+#if defined(__linux__)
+    /** The io_uring batches of destination operations, unused if the ring cannot be set up. */
+    file_operation_ring file_op_rng_;
+
+    /** The watch of the source directory, only open in watch mode. */
+    source_watcher source_watchr_;
+
+    /** The server of the requests, only open in daemon mode. */
+    daemon_server daemn_servr_;
+#endif
 };
 
 
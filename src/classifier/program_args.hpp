@@ -40,7 +40,17 @@ struct program_args
 {
     spd::fsys::rx_directory_path source_dir;
     spd::fsys::output_directory_path destination_dir;
+    spd::fsys::r_regular_file_path catalog_fle;
+    spd::fsys::r_regular_file_path views_fle;
     std::string categories_file_nme = ".categories.json";
+    std::string query_expr;
+    std::size_t jobs_nbr = 0;
+    std::size_t queue_depth = 64;
+    bool rebuild = false;
+    bool audit = false;
+    bool dry_run = false;
+    bool watch = false;
+    bool daemon = false;
 };
 
 
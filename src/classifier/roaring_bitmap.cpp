@@ -0,0 +1,866 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier/roaring_bitmap.cpp
+ * @brief       roaring_bitmap class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "roaring_bitmap.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CLASSIFIER_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+
+namespace classifier {
+
+
+namespace {
+
+
+/**
+ * @brief       The operations that combine two bitset containers word by word.
+ */
+enum class bitset_operations : std::uint8_t
+{
+    AND,
+    OR,
+    AND_NOT,
+};
+
+
+using intersect_function = std::size_t (*)(const std::uint16_t* lhs, std::size_t lhs_sz,
+                                           const std::uint16_t* rhs, std::size_t rhs_sz,
+                                           std::uint16_t* res);
+
+using combine_function = std::uint32_t (*)(const std::uint64_t* lhs, const std::uint64_t* rhs,
+                                           std::uint64_t* res);
+
+
+template<typename T>
+void append_value(std::string* buf, const T& val)
+{
+    buf->append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+
+template<typename T>
+bool read_value(std::string_view contnt, std::size_t* offst, T* val)
+{
+    if (contnt.size() - *offst < sizeof(T))
+    {
+        return false;
+    }
+
+    std::memcpy(val, contnt.data() + *offst, sizeof(T));
+    *offst += sizeof(T);
+
+    return true;
+}
+
+
+std::size_t intersect_scalar(
+        const std::uint16_t* lhs,
+        std::size_t lhs_sz,
+        const std::uint16_t* rhs,
+        std::size_t rhs_sz,
+        std::uint16_t* res
+)
+{
+    return static_cast<std::size_t>(std::set_intersection(lhs, lhs + lhs_sz, rhs, rhs + rhs_sz,
+                                                          res) - res);
+}
+
+
+template<bitset_operations TpOperation>
+std::uint32_t combine_scalar(const std::uint64_t* lhs, const std::uint64_t* rhs, std::uint64_t* res)
+{
+    std::uint32_t cardinality = 0;
+
+    for (std::size_t i = 0; i < roaring_bitmap::BITSET_WORDS_NBR; ++i)
+    {
+        if constexpr (TpOperation == bitset_operations::AND)
+        {
+            res[i] = lhs[i] & rhs[i];
+        }
+        else if constexpr (TpOperation == bitset_operations::OR)
+        {
+            res[i] = lhs[i] | rhs[i];
+        }
+        else
+        {
+            res[i] = lhs[i] & ~rhs[i];
+        }
+
+        cardinality += static_cast<std::uint32_t>(std::popcount(res[i]));
+    }
+
+    return cardinality;
+}
+
+
+#if defined(CLASSIFIER_X86_DISPATCH)
+
+/*
+ * Two sorted arrays are intersected eight values at a time: a string comparison instruction tells
+ * which values of a block of the left array are equal to any value of a block of the right array,
+ * then the block whose last value is the smallest is replaced by the next one.
+ */
+__attribute__((target("sse4.2")))
+std::size_t intersect_sse42(
+        const std::uint16_t* lhs,
+        std::size_t lhs_sz,
+        const std::uint16_t* rhs,
+        std::size_t rhs_sz,
+        std::uint16_t* res
+)
+{
+    constexpr int mode = _SIDD_UWORD_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK;
+    std::size_t lhs_blks_sz = lhs_sz / 8 * 8;
+    std::size_t rhs_blks_sz = rhs_sz / 8 * 8;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t res_sz = 0;
+    __m128i lhs_vec;
+    __m128i rhs_vec;
+    unsigned msk;
+
+    if (lhs_blks_sz > 0 && rhs_blks_sz > 0)
+    {
+        lhs_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs));
+        rhs_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs));
+
+        for (;;)
+        {
+            msk = static_cast<unsigned>(_mm_cvtsi128_si32(
+                    _mm_cmpestrm(rhs_vec, 8, lhs_vec, 8, mode)));
+
+            for (; msk != 0; msk &= msk - 1)
+            {
+                res[res_sz++] = lhs[i + static_cast<std::size_t>(std::countr_zero(msk))];
+            }
+
+            std::uint16_t lhs_max = lhs[i + 7];
+            std::uint16_t rhs_max = rhs[j + 7];
+
+            if (lhs_max <= rhs_max)
+            {
+                i += 8;
+                if (i == lhs_blks_sz)
+                {
+                    break;
+                }
+
+                lhs_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+            }
+
+            if (rhs_max <= lhs_max)
+            {
+                j += 8;
+                if (j == rhs_blks_sz)
+                {
+                    break;
+                }
+
+                rhs_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + j));
+            }
+        }
+    }
+
+    // The values of the partial blocks are merged one by one.
+    while (i < lhs_sz && j < rhs_sz)
+    {
+        if (lhs[i] < rhs[j])
+        {
+            ++i;
+        }
+        else if (lhs[i] > rhs[j])
+        {
+            ++j;
+        }
+        else
+        {
+            res[res_sz++] = lhs[i];
+            ++i;
+            ++j;
+        }
+    }
+
+    return res_sz;
+}
+
+
+template<bitset_operations TpOperation>
+__attribute__((target("avx2,popcnt")))
+std::uint32_t combine_avx2(const std::uint64_t* lhs, const std::uint64_t* rhs, std::uint64_t* res)
+{
+    std::uint64_t cardinality = 0;
+    __m256i lhs_vec;
+    __m256i rhs_vec;
+    __m256i res_vec;
+
+    for (std::size_t i = 0; i < roaring_bitmap::BITSET_WORDS_NBR; i += 4)
+    {
+        lhs_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+        rhs_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+
+        if constexpr (TpOperation == bitset_operations::AND)
+        {
+            res_vec = _mm256_and_si256(lhs_vec, rhs_vec);
+        }
+        else if constexpr (TpOperation == bitset_operations::OR)
+        {
+            res_vec = _mm256_or_si256(lhs_vec, rhs_vec);
+        }
+        else
+        {
+            res_vec = _mm256_andnot_si256(rhs_vec, lhs_vec);
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + i), res_vec);
+    }
+
+    for (std::size_t i = 0; i < roaring_bitmap::BITSET_WORDS_NBR; ++i)
+    {
+        cardinality += static_cast<std::uint64_t>(_mm_popcnt_u64(res[i]));
+    }
+
+    return static_cast<std::uint32_t>(cardinality);
+}
+
+#endif
+
+
+intersect_function get_intersect_function() noexcept
+{
+#if defined(CLASSIFIER_X86_DISPATCH)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        return intersect_sse42;
+    }
+#endif
+
+    return intersect_scalar;
+}
+
+
+template<bitset_operations TpOperation>
+combine_function get_combine_function() noexcept
+{
+#if defined(CLASSIFIER_X86_DISPATCH)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+    {
+        return combine_avx2<TpOperation>;
+    }
+#endif
+
+    return combine_scalar<TpOperation>;
+}
+
+
+/** The implementations used for the set operations, the best ones the CPU supports. */
+const intersect_function intersect_arrays = get_intersect_function();
+
+const combine_function and_bitsets = get_combine_function<bitset_operations::AND>();
+
+const combine_function or_bitsets = get_combine_function<bitset_operations::OR>();
+
+const combine_function and_not_bitsets = get_combine_function<bitset_operations::AND_NOT>();
+
+
+}
+
+
+void roaring_bitmap::add(std::uint32_t val)
+{
+    auto ky = static_cast<std::uint16_t>(val >> 16);
+    auto low_bits = static_cast<std::uint16_t>(val);
+    std::uint64_t bit = std::uint64_t(1) << (low_bits % 64);
+
+    // The values are mostly added in increasing order, the last container is tried first.
+    auto it = containrs_.end();
+    if (containrs_.empty() || containrs_.back().ky != ky)
+    {
+        it = std::lower_bound(containrs_.begin(), containrs_.end(), ky,
+                              [](const container& containr, std::uint16_t ky)
+        {
+            return containr.ky < ky;
+        });
+
+        if (it == containrs_.end() || it->ky != ky)
+        {
+            it = containrs_.insert(it, container());
+            it->ky = ky;
+        }
+    }
+    else
+    {
+        --it;
+    }
+
+    if (it->is_bitset())
+    {
+        if ((it->wrds[low_bits / 64] & bit) == 0)
+        {
+            it->wrds[low_bits / 64] |= bit;
+            ++it->cardinality;
+        }
+
+        return;
+    }
+
+    auto val_it = it->vals.end();
+    if (!it->vals.empty() && it->vals.back() >= low_bits)
+    {
+        val_it = std::lower_bound(it->vals.begin(), it->vals.end(), low_bits);
+        if (*val_it == low_bits)
+        {
+            return;
+        }
+    }
+
+    it->vals.insert(val_it, low_bits);
+    if (++it->cardinality > ARRAY_MAX_SIZE)
+    {
+        convert_to_bitset(&*it);
+    }
+}
+
+
+void roaring_bitmap::add_range(std::uint32_t first, std::uint64_t last)
+{
+    roaring_bitmap rng;
+    std::uint64_t containr_first;
+    std::uint64_t containr_last;
+
+    // The range is built container by container, then added with a single union.
+    for (containr_first = first; containr_first < last; containr_first = containr_last)
+    {
+        containr_last = std::min(last, (containr_first | 0xffff) + 1);
+
+        auto& containr = rng.containrs_.emplace_back();
+        containr.ky = static_cast<std::uint16_t>(containr_first >> 16);
+        containr.cardinality = static_cast<std::uint32_t>(containr_last - containr_first);
+
+        for (auto i = containr_first; i < containr_last; ++i)
+        {
+            containr.vals.push_back(static_cast<std::uint16_t>(i));
+        }
+
+        if (containr.cardinality > ARRAY_MAX_SIZE)
+        {
+            convert_to_bitset(&containr);
+        }
+    }
+
+    *this |= rng;
+}
+
+
+void roaring_bitmap::remove(std::uint32_t val)
+{
+    auto low_bits = static_cast<std::uint16_t>(val);
+    std::uint64_t bit = std::uint64_t(1) << (low_bits % 64);
+    container* containr = find_container(static_cast<std::uint16_t>(val >> 16));
+
+    if (containr == nullptr)
+    {
+        return;
+    }
+
+    if (containr->is_bitset())
+    {
+        if ((containr->wrds[low_bits / 64] & bit) != 0)
+        {
+            containr->wrds[low_bits / 64] &= ~bit;
+            if (--containr->cardinality <= ARRAY_MAX_SIZE)
+            {
+                convert_to_array(containr);
+            }
+        }
+
+        return;
+    }
+
+    auto val_it = std::lower_bound(containr->vals.begin(), containr->vals.end(), low_bits);
+    if (val_it == containr->vals.end() || *val_it != low_bits)
+    {
+        return;
+    }
+
+    containr->vals.erase(val_it);
+    if (--containr->cardinality == 0)
+    {
+        containrs_.erase(containrs_.begin() + (containr - containrs_.data()));
+    }
+}
+
+
+bool roaring_bitmap::contains(std::uint32_t val) const noexcept
+{
+    auto low_bits = static_cast<std::uint16_t>(val);
+    const container* containr = find_container(static_cast<std::uint16_t>(val >> 16));
+
+    if (containr == nullptr)
+    {
+        return false;
+    }
+
+    if (containr->is_bitset())
+    {
+        return (containr->wrds[low_bits / 64] & (std::uint64_t(1) << (low_bits % 64))) != 0;
+    }
+
+    return std::binary_search(containr->vals.begin(), containr->vals.end(), low_bits);
+}
+
+
+std::uint64_t roaring_bitmap::get_cardinality() const noexcept
+{
+    std::uint64_t cardinality = 0;
+
+    for (auto& x : containrs_)
+    {
+        cardinality += x.cardinality;
+    }
+
+    return cardinality;
+}
+
+
+void roaring_bitmap::clear() noexcept
+{
+    containrs_.clear();
+}
+
+
+roaring_bitmap& roaring_bitmap::operator &=(const roaring_bitmap& rhs)
+{
+    std::vector<container> res;
+    std::size_t i = 0;
+    std::size_t j = 0;
+
+    if (this == &rhs)
+    {
+        return *this;
+    }
+
+    while (i < containrs_.size() && j < rhs.containrs_.size())
+    {
+        if (containrs_[i].ky < rhs.containrs_[j].ky)
+        {
+            ++i;
+        }
+        else if (containrs_[i].ky > rhs.containrs_[j].ky)
+        {
+            ++j;
+        }
+        else
+        {
+            container containr;
+            intersect(containrs_[i++], rhs.containrs_[j++], &containr);
+
+            if (containr.cardinality > 0)
+            {
+                res.push_back(std::move(containr));
+            }
+        }
+    }
+
+    containrs_ = std::move(res);
+
+    return *this;
+}
+
+
+roaring_bitmap& roaring_bitmap::operator |=(const roaring_bitmap& rhs)
+{
+    std::vector<container> res;
+    std::size_t i = 0;
+    std::size_t j = 0;
+
+    if (this == &rhs)
+    {
+        return *this;
+    }
+
+    res.reserve(std::max(containrs_.size(), rhs.containrs_.size()));
+
+    while (i < containrs_.size() || j < rhs.containrs_.size())
+    {
+        if (j == rhs.containrs_.size() ||
+            (i < containrs_.size() && containrs_[i].ky < rhs.containrs_[j].ky))
+        {
+            res.push_back(std::move(containrs_[i++]));
+        }
+        else if (i == containrs_.size() || containrs_[i].ky > rhs.containrs_[j].ky)
+        {
+            res.push_back(rhs.containrs_[j++]);
+        }
+        else
+        {
+            container containr;
+            unite(containrs_[i++], rhs.containrs_[j++], &containr);
+            res.push_back(std::move(containr));
+        }
+    }
+
+    containrs_ = std::move(res);
+
+    return *this;
+}
+
+
+roaring_bitmap& roaring_bitmap::operator -=(const roaring_bitmap& rhs)
+{
+    std::vector<container> res;
+    std::size_t j = 0;
+
+    if (this == &rhs)
+    {
+        clear();
+        return *this;
+    }
+
+    for (auto& x : containrs_)
+    {
+        while (j < rhs.containrs_.size() && rhs.containrs_[j].ky < x.ky)
+        {
+            ++j;
+        }
+
+        if (j == rhs.containrs_.size() || rhs.containrs_[j].ky != x.ky)
+        {
+            res.push_back(std::move(x));
+            continue;
+        }
+
+        container containr;
+        subtract(x, rhs.containrs_[j], &containr);
+
+        if (containr.cardinality > 0)
+        {
+            res.push_back(std::move(containr));
+        }
+    }
+
+    containrs_ = std::move(res);
+
+    return *this;
+}
+
+
+void roaring_bitmap::serialize(std::string* buf) const
+{
+    append_value(buf, static_cast<std::uint32_t>(containrs_.size()));
+
+    for (auto& x : containrs_)
+    {
+        append_value(buf, x.ky);
+        append_value(buf, x.cardinality);
+
+        if (x.is_bitset())
+        {
+            buf->append(reinterpret_cast<const char*>(x.wrds.data()),
+                        BITSET_WORDS_NBR * sizeof(std::uint64_t));
+        }
+        else
+        {
+            buf->append(reinterpret_cast<const char*>(x.vals.data()),
+                        x.vals.size() * sizeof(std::uint16_t));
+        }
+    }
+}
+
+
+bool roaring_bitmap::deserialize(std::string_view contnt, std::size_t* offst)
+{
+    std::uint32_t containrs_nbr;
+    std::size_t payload_sz;
+
+    clear();
+
+    if (!read_value(contnt, offst, &containrs_nbr))
+    {
+        return false;
+    }
+
+    containrs_.reserve(containrs_nbr);
+    for (std::uint32_t i = 0; i < containrs_nbr; ++i)
+    {
+        container containr;
+
+        if (!read_value(contnt, offst, &containr.ky) ||
+            !read_value(contnt, offst, &containr.cardinality) ||
+            containr.cardinality == 0 || containr.cardinality > BITSET_WORDS_NBR * 64 ||
+            (!containrs_.empty() && containrs_.back().ky >= containr.ky))
+        {
+            goto error;
+        }
+
+        payload_sz = containr.cardinality > ARRAY_MAX_SIZE ?
+                     BITSET_WORDS_NBR * sizeof(std::uint64_t) :
+                     containr.cardinality * sizeof(std::uint16_t);
+        if (contnt.size() - *offst < payload_sz)
+        {
+            goto error;
+        }
+
+        // The containers are checked to be in their canonical form, sets compare by value.
+        if (containr.cardinality > ARRAY_MAX_SIZE)
+        {
+            containr.wrds.resize(BITSET_WORDS_NBR);
+            std::memcpy(containr.wrds.data(), contnt.data() + *offst, payload_sz);
+            count_bitset(&containr);
+
+            if (!containr.is_bitset())
+            {
+                goto error;
+            }
+        }
+        else
+        {
+            containr.vals.resize(containr.cardinality);
+            std::memcpy(containr.vals.data(), contnt.data() + *offst, payload_sz);
+
+            if (std::adjacent_find(containr.vals.begin(), containr.vals.end(),
+                                   std::greater_equal<>()) != containr.vals.end())
+            {
+                goto error;
+            }
+        }
+
+        *offst += payload_sz;
+        containrs_.push_back(std::move(containr));
+    }
+
+    return true;
+
+error:
+    clear();
+    return false;
+}
+
+
+roaring_bitmap::container* roaring_bitmap::find_container(std::uint16_t ky) noexcept
+{
+    return const_cast<container*>(std::as_const(*this).find_container(ky));
+}
+
+
+const roaring_bitmap::container* roaring_bitmap::find_container(std::uint16_t ky) const noexcept
+{
+    auto it = std::lower_bound(containrs_.begin(), containrs_.end(), ky,
+                               [](const container& containr, std::uint16_t ky)
+    {
+        return containr.ky < ky;
+    });
+
+    return it != containrs_.end() && it->ky == ky ? &*it : nullptr;
+}
+
+
+void roaring_bitmap::intersect(const container& lhs, const container& rhs, container* res)
+{
+    res->ky = lhs.ky;
+
+    if (lhs.is_bitset() && rhs.is_bitset())
+    {
+        res->wrds.resize(BITSET_WORDS_NBR);
+        res->cardinality = and_bitsets(lhs.wrds.data(), rhs.wrds.data(), res->wrds.data());
+        shrink_bitset(res);
+        return;
+    }
+
+    if (lhs.is_bitset() || rhs.is_bitset())
+    {
+        const container& arr = lhs.is_bitset() ? rhs : lhs;
+        const container& bitst = lhs.is_bitset() ? lhs : rhs;
+
+        for (auto& x : arr.vals)
+        {
+            if ((bitst.wrds[x / 64] & (std::uint64_t(1) << (x % 64))) != 0)
+            {
+                res->vals.push_back(x);
+            }
+        }
+    }
+    else
+    {
+        res->vals.resize(std::min(lhs.vals.size(), rhs.vals.size()));
+        res->vals.resize(intersect_arrays(lhs.vals.data(), lhs.vals.size(), rhs.vals.data(),
+                                          rhs.vals.size(), res->vals.data()));
+    }
+
+    res->cardinality = static_cast<std::uint32_t>(res->vals.size());
+}
+
+
+void roaring_bitmap::unite(const container& lhs, const container& rhs, container* res)
+{
+    res->ky = lhs.ky;
+
+    if (!lhs.is_bitset() && !rhs.is_bitset())
+    {
+        res->vals.reserve(lhs.vals.size() + rhs.vals.size());
+        std::set_union(lhs.vals.begin(), lhs.vals.end(), rhs.vals.begin(), rhs.vals.end(),
+                       std::back_inserter(res->vals));
+        res->cardinality = static_cast<std::uint32_t>(res->vals.size());
+
+        if (res->cardinality > ARRAY_MAX_SIZE)
+        {
+            convert_to_bitset(res);
+        }
+
+        return;
+    }
+
+    if (lhs.is_bitset() && rhs.is_bitset())
+    {
+        res->wrds.resize(BITSET_WORDS_NBR);
+        res->cardinality = or_bitsets(lhs.wrds.data(), rhs.wrds.data(), res->wrds.data());
+        return;
+    }
+
+    const container& arr = lhs.is_bitset() ? rhs : lhs;
+
+    res->wrds = lhs.is_bitset() ? lhs.wrds : rhs.wrds;
+    for (auto& x : arr.vals)
+    {
+        res->wrds[x / 64] |= std::uint64_t(1) << (x % 64);
+    }
+
+    count_bitset(res);
+}
+
+
+void roaring_bitmap::subtract(const container& lhs, const container& rhs, container* res)
+{
+    res->ky = lhs.ky;
+
+    if (lhs.is_bitset() && rhs.is_bitset())
+    {
+        res->wrds.resize(BITSET_WORDS_NBR);
+        res->cardinality = and_not_bitsets(lhs.wrds.data(), rhs.wrds.data(), res->wrds.data());
+        shrink_bitset(res);
+        return;
+    }
+
+    if (lhs.is_bitset())
+    {
+        res->wrds = lhs.wrds;
+        for (auto& x : rhs.vals)
+        {
+            res->wrds[x / 64] &= ~(std::uint64_t(1) << (x % 64));
+        }
+
+        count_bitset(res);
+        return;
+    }
+
+    if (rhs.is_bitset())
+    {
+        for (auto& x : lhs.vals)
+        {
+            if ((rhs.wrds[x / 64] & (std::uint64_t(1) << (x % 64))) == 0)
+            {
+                res->vals.push_back(x);
+            }
+        }
+    }
+    else
+    {
+        std::set_difference(lhs.vals.begin(), lhs.vals.end(), rhs.vals.begin(), rhs.vals.end(),
+                            std::back_inserter(res->vals));
+    }
+
+    res->cardinality = static_cast<std::uint32_t>(res->vals.size());
+}
+
+
+void roaring_bitmap::convert_to_bitset(container* containr)
+{
+    containr->wrds.assign(BITSET_WORDS_NBR, 0);
+    for (auto& x : containr->vals)
+    {
+        containr->wrds[x / 64] |= std::uint64_t(1) << (x % 64);
+    }
+
+    std::vector<std::uint16_t>().swap(containr->vals);
+}
+
+
+void roaring_bitmap::convert_to_array(container* containr)
+{
+    std::uint64_t wrd;
+
+    containr->vals.clear();
+    containr->vals.reserve(containr->cardinality);
+    for (std::size_t i = 0; i < BITSET_WORDS_NBR; ++i)
+    {
+        for (wrd = containr->wrds[i]; wrd != 0; wrd &= wrd - 1)
+        {
+            containr->vals.push_back(static_cast<std::uint16_t>(i * 64 + std::countr_zero(wrd)));
+        }
+    }
+
+    std::vector<std::uint64_t>().swap(containr->wrds);
+}
+
+
+void roaring_bitmap::count_bitset(container* containr)
+{
+    std::uint32_t cardinality = 0;
+
+    for (auto& x : containr->wrds)
+    {
+        cardinality += static_cast<std::uint32_t>(std::popcount(x));
+    }
+
+    containr->cardinality = cardinality;
+    shrink_bitset(containr);
+}
+
+
+void roaring_bitmap::shrink_bitset(container* containr)
+{
+    // A bitset that lost values goes back to an array, so that every set has a single form.
+    if (containr->cardinality <= ARRAY_MAX_SIZE)
+    {
+        convert_to_array(containr);
+    }
+}
+
+
+}
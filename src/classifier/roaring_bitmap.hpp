@@ -0,0 +1,230 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier/roaring_bitmap.hpp
+ * @brief       roaring_bitmap class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_ROARING_BITMAP_HPP
+#define CLASSIFIER_ROARING_BITMAP_HPP
+
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Compressed set of 32 bits integers in the manner of Roaring bitmaps. The values are
+ *              split by their 16 high bits into containers that hold the 16 low bits, either as a
+ *              sorted array while they are few or as a bitset once they are more than
+ *              ARRAY_MAX_SIZE. Sparse sets thus cost two bytes per value, dense sets one bit per
+ *              value, and the set operations work container by container.
+ */
+class roaring_bitmap
+{
+public:
+    /** The number of values above which a container is stored as a bitset. */
+    static constexpr std::size_t ARRAY_MAX_SIZE = 4096;
+
+    /** The number of words of a bitset container. */
+    static constexpr std::size_t BITSET_WORDS_NBR = 1024;
+
+    /**
+     * @brief       Default constructor.
+     */
+    roaring_bitmap() = default;
+
+    /**
+     * @brief       Add a value.
+     * @param       val : The value to add.
+     */
+    void add(std::uint32_t val);
+
+    /**
+     * @brief       Add all the values of a range.
+     * @param       first : The first value of the range.
+     * @param       last : The value past the end of the range.
+     */
+    void add_range(std::uint32_t first, std::uint64_t last);
+
+    /**
+     * @brief       Remove a value.
+     * @param       val : The value to remove.
+     */
+    void remove(std::uint32_t val);
+
+    /**
+     * @brief       Check whether a value is in the set.
+     * @param       val : The value to check.
+     * @return      If the value is in the set true is returned, otherwise false is returned.
+     */
+    [[nodiscard]] bool contains(std::uint32_t val) const noexcept;
+
+    /**
+     * @brief       Get the number of values in the set.
+     * @return      The number of values in the set.
+     */
+    [[nodiscard]] std::uint64_t get_cardinality() const noexcept;
+
+    /**
+     * @brief       Check whether the set is empty.
+     * @return      If the set is empty true is returned, otherwise false is returned.
+     */
+    [[nodiscard]] bool is_empty() const noexcept
+    {
+        return containrs_.empty();
+    }
+
+    /**
+     * @brief       Remove all the values.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief       Keep the values that are also in another set.
+     * @param       rhs : The other set.
+     * @return      The set itself.
+     */
+    roaring_bitmap& operator &=(const roaring_bitmap& rhs);
+
+    /**
+     * @brief       Add the values of another set.
+     * @param       rhs : The other set.
+     * @return      The set itself.
+     */
+    roaring_bitmap& operator |=(const roaring_bitmap& rhs);
+
+    /**
+     * @brief       Remove the values that are in another set.
+     * @param       rhs : The other set.
+     * @return      The set itself.
+     */
+    roaring_bitmap& operator -=(const roaring_bitmap& rhs);
+
+    [[nodiscard]] bool operator ==(const roaring_bitmap& rhs) const = default;
+
+    /**
+     * @brief       Call a function with every value of the set, in increasing order.
+     * @param       fn : The function to call.
+     */
+    template<typename TpFunction>
+    void for_each(TpFunction&& fn) const
+    {
+        std::uint32_t high_bits;
+        std::uint64_t wrd;
+
+        for (auto& x : containrs_)
+        {
+            high_bits = static_cast<std::uint32_t>(x.ky) << 16;
+
+            if (!x.is_bitset())
+            {
+                for (auto& val : x.vals)
+                {
+                    fn(high_bits | val);
+                }
+
+                continue;
+            }
+
+            for (std::size_t i = 0; i < BITSET_WORDS_NBR; ++i)
+            {
+                for (wrd = x.wrds[i]; wrd != 0; wrd &= wrd - 1)
+                {
+                    fn(high_bits | static_cast<std::uint32_t>(i * 64 + std::countr_zero(wrd)));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief       Append the binary form of the set to a buffer.
+     * @param       buf : The buffer.
+     */
+    void serialize(std::string* buf) const;
+
+    /**
+     * @brief       Read a set from its binary form, replacing the current values.
+     * @param       contnt : The content holding the binary form.
+     * @param       offst : The position of the binary form, moved past it.
+     * @return      If function was successful true is returned, otherwise false is returned and
+     *              the set is left empty.
+     */
+    bool deserialize(std::string_view contnt, std::size_t* offst);
+
+private:
+    /**
+     * @brief       The values sharing the same 16 high bits.
+     */
+    struct container
+    {
+        std::uint16_t ky = 0;
+        std::uint32_t cardinality = 0;
+
+        /** The sorted low bits, while the container holds at most ARRAY_MAX_SIZE values. */
+        std::vector<std::uint16_t> vals;
+
+        /** The low bits as a bitset, once the container holds more than ARRAY_MAX_SIZE values. */
+        std::vector<std::uint64_t> wrds;
+
+        [[nodiscard]] bool is_bitset() const noexcept
+        {
+            return !wrds.empty();
+        }
+
+        [[nodiscard]] bool operator ==(const container& rhs) const = default;
+    };
+
+    [[nodiscard]] container* find_container(std::uint16_t ky) noexcept;
+
+    [[nodiscard]] const container* find_container(std::uint16_t ky) const noexcept;
+
+    static void intersect(const container& lhs, const container& rhs, container* res);
+
+    static void unite(const container& lhs, const container& rhs, container* res);
+
+    static void subtract(const container& lhs, const container& rhs, container* res);
+
+    static void convert_to_bitset(container* containr);
+
+    static void convert_to_array(container* containr);
+
+    static void count_bitset(container* containr);
+
+    static void shrink_bitset(container* containr);
+
+private:
+    /** The containers, sorted by their high bits, none of them empty. */
+    std::vector<container> containrs_;
+};
+
+
+}
+
+
+#endif
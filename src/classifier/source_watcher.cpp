@@ -0,0 +1,507 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier/source_watcher.cpp
+ * @brief       source_watcher class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#if defined(__linux__)
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "source_watcher.hpp"
+
+
+namespace classifier {
+
+
+namespace {
+
+
+constexpr std::uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM |
+                                     IN_MOVED_TO | IN_ONLYDIR | IN_DONT_FOLLOW;
+
+
+void sort_unique(std::vector<std::filesystem::path>* pths)
+{
+    std::sort(pths->begin(), pths->end());
+    pths->erase(std::unique(pths->begin(), pths->end()), pths->end());
+}
+
+
+}
+
+
+source_watcher::source_watcher(std::filesystem::path root_pth, std::string file_nme)
+        : root_pth_(std::move(root_pth))
+        , file_nme_(std::move(file_nme))
+        , fd_(-1)
+        , wake_fd_(-1)
+        , posted_mtx_()
+        , posted_pths_()
+        , posted_nbr_(0)
+        , watched_dirs_()
+        , watch_descs_()
+        , canonical_root_pth_()
+        , linked_dirs_()
+        , linked_watch_ids_()
+        , watch_errno_(0)
+{
+}
+
+
+source_watcher::~source_watcher()
+{
+    close();
+}
+
+
+bool source_watcher::open()
+{
+    std::error_code err_code;
+
+    close();
+    watch_errno_ = 0;
+
+    fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd_ < 0 || wake_fd_ < 0)
+    {
+        close();
+        return false;
+    }
+
+    canonical_root_pth_ = (std::filesystem::weakly_canonical(root_pth_, err_code) / "").native();
+    linked_dirs_.insert(get_file_id(root_pth_));
+
+    add_watches(root_pth_, {}, file_id(), nullptr);
+    if (watched_dirs_.empty() || watch_errno_ != 0)
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool source_watcher::wait(source_changes* chnges)
+{
+    pollfd poll_fds[2] = {{fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+    std::chrono::steady_clock::time_point deadln;
+    std::chrono::milliseconds remaining_tme;
+    std::uint64_t wake_cnt;
+    [[maybe_unused]] ssize_t read_sz;
+    int poll_res;
+
+    chnges->clear();
+
+    // Nothing runs until the first event of a burst arrives, or until a file is posted.
+    do
+    {
+        poll_res = ::poll(poll_fds, 2, -1);
+    } while (poll_res < 0 && errno == EINTR);
+
+    if (poll_res < 0)
+    {
+        return false;
+    }
+
+    deadln = std::chrono::steady_clock::now() + MAX_DELAY;
+
+    for (;;)
+    {
+        if (!read_events(chnges) || watch_errno_ != 0)
+        {
+            return false;
+        }
+
+        // The posted files are taken at the end of the burst, only the wake up is consumed.
+        read_sz = ::read(wake_fd_, &wake_cnt, sizeof(wake_cnt));
+
+        remaining_tme = std::min(DEBOUNCE_DELAY,
+                                 std::chrono::duration_cast<std::chrono::milliseconds>(
+                                         deadln - std::chrono::steady_clock::now()));
+        if (remaining_tme.count() <= 0)
+        {
+            break;
+        }
+
+        poll_res = ::poll(poll_fds, 2, static_cast<int>(remaining_tme.count()));
+        if (poll_res == 0)
+        {
+            break;
+        }
+
+        if (poll_res < 0 && errno != EINTR)
+        {
+            return false;
+        }
+    }
+
+    take_posted(chnges);
+    sort_unique(&chnges->categories_file_pths);
+    sort_unique(&chnges->removed_dirs);
+    sort_unique(&chnges->forced_pths);
+
+    return true;
+}
+
+
+std::uint64_t source_watcher::post(std::filesystem::path categories_file_pth)
+{
+    std::uint64_t one = 1;
+    std::uint64_t posted_nbr;
+
+    {
+        std::lock_guard<std::mutex> lock(posted_mtx_);
+        posted_pths_.push_back(std::move(categories_file_pth));
+        posted_nbr = ++posted_nbr_;
+    }
+
+    if (wake_fd_ >= 0)
+    {
+        [[maybe_unused]] ssize_t write_sz = ::write(wake_fd_, &one, sizeof(one));
+    }
+
+    return posted_nbr;
+}
+
+
+const char* source_watcher::get_failure_reason() const noexcept
+{
+    if (watch_errno_ == 0)
+    {
+        return nullptr;
+    }
+
+    if (watch_errno_ == ENOSPC)
+    {
+        return "too many directories for fs.inotify.max_user_watches";
+    }
+
+    return std::strerror(watch_errno_);
+}
+
+
+void source_watcher::close() noexcept
+{
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    if (wake_fd_ >= 0)
+    {
+        ::close(wake_fd_);
+        wake_fd_ = -1;
+    }
+
+    watched_dirs_.clear();
+    watch_descs_.clear();
+    linked_dirs_.clear();
+    linked_watch_ids_.clear();
+}
+
+
+void source_watcher::add_watches(
+        const std::filesystem::path& directory_pth,
+        const std::filesystem::path& target_pth,
+        const file_id& target_id,
+        source_changes* chnges
+)
+{
+    std::vector<pending_directory> pending_dirs = {{directory_pth, target_pth, target_id}};
+    pending_directory current_dir;
+    std::filesystem::path subdir_target_pth;
+    file_id subdir_target_id;
+    std::error_code err_code;
+    int wd;
+
+    // The directories are watched before being listed, so that nothing created in between is
+    // missed. What is both listed and reported by an event is reported twice, and coalesced.
+    while (!pending_dirs.empty())
+    {
+        current_dir = std::move(pending_dirs.back());
+        pending_dirs.pop_back();
+
+        // A linked directory is watched through its target, its events are reported under the
+        // path of the link like the files that the scan finds in it.
+        wd = current_dir.target_pth.empty() ?
+                ::inotify_add_watch(fd_, current_dir.pth.c_str(), WATCH_MASK) :
+                ::inotify_add_watch(fd_, current_dir.target_pth.c_str(), WATCH_MASK);
+        if (wd < 0)
+        {
+            // A directory removed or made unreadable in between is skipped, any other failure
+            // would leave a part of the tree unwatched.
+            if (errno != ENOENT && errno != ENOTDIR && errno != EACCES)
+            {
+                watch_errno_ = errno;
+                return;
+            }
+
+            linked_dirs_.erase(current_dir.target_id);
+            continue;
+        }
+
+        if (auto it = watched_dirs_.find(wd); it != watched_dirs_.end())
+        {
+            watch_descs_.erase(it->second.native());
+        }
+
+        watched_dirs_.insert_or_assign(wd, current_dir.pth);
+        watch_descs_.insert_or_assign(current_dir.pth.native(), wd);
+        if (!current_dir.target_pth.empty())
+        {
+            linked_watch_ids_.insert_or_assign(wd, current_dir.target_id);
+        }
+
+        std::filesystem::directory_iterator it(
+                current_dir.pth, std::filesystem::directory_options::skip_permission_denied,
+                err_code);
+
+        for (; !err_code && it != std::filesystem::directory_iterator(); it.increment(err_code))
+        {
+            const std::filesystem::directory_entry& entry = *it;
+
+            if (entry.is_directory(err_code))
+            {
+                if (!entry.is_symlink(err_code))
+                {
+                    pending_dirs.push_back({entry.path(), {}, file_id()});
+                }
+                else if (enter_linked_directory(entry.path(), &subdir_target_pth,
+                                                &subdir_target_id))
+                {
+                    pending_dirs.push_back({entry.path(), std::move(subdir_target_pth),
+                                            subdir_target_id});
+                }
+            }
+            else if (chnges != nullptr && entry.path().filename() == file_nme_ &&
+                     entry.is_regular_file(err_code))
+            {
+                chnges->categories_file_pths.push_back(entry.path());
+            }
+
+            err_code.clear();
+        }
+
+        err_code.clear();
+    }
+}
+
+
+bool source_watcher::enter_linked_directory(
+        const std::filesystem::path& lnk_pth,
+        std::filesystem::path* target_pth,
+        file_id* target_id
+)
+{
+    std::error_code err_code;
+    std::filesystem::path::string_type target_prefx;
+
+    *target_pth = std::filesystem::canonical(lnk_pth, err_code);
+    if (err_code)
+    {
+        return false;
+    }
+
+    // A target inside the tree is watched through its own path, and a target holding the tree
+    // would watch it again.
+    target_prefx = (*target_pth / "").native();
+    if (target_prefx.starts_with(canonical_root_pth_) ||
+        canonical_root_pth_.starts_with(target_prefx))
+    {
+        return false;
+    }
+
+    *target_id = get_file_id(*target_pth);
+
+    return linked_dirs_.insert(*target_id).second;
+}
+
+
+void source_watcher::remove_watches(const std::filesystem::path& directory_pth)
+{
+    const std::filesystem::path::string_type& directory_pth_str = directory_pth.native();
+
+    // The directories below sort right after the directory, among the paths that start alike.
+    for (auto it = watch_descs_.lower_bound(directory_pth_str);
+         it != watch_descs_.end() && it->first.starts_with(directory_pth_str);)
+    {
+        if (it->first.size() == directory_pth_str.size() ||
+            it->first[directory_pth_str.size()] == std::filesystem::path::preferred_separator)
+        {
+            ::inotify_rm_watch(fd_, it->second);
+            watched_dirs_.erase(it->second);
+            if (auto id_it = linked_watch_ids_.find(it->second); id_it != linked_watch_ids_.end())
+            {
+                linked_dirs_.erase(id_it->second);
+                linked_watch_ids_.erase(id_it);
+            }
+
+            it = watch_descs_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+
+void source_watcher::forget_watch(int wd)
+{
+    auto it = watched_dirs_.find(wd);
+
+    if (it == watched_dirs_.end())
+    {
+        return;
+    }
+
+    watch_descs_.erase(it->second.native());
+    watched_dirs_.erase(it);
+
+    if (auto id_it = linked_watch_ids_.find(wd); id_it != linked_watch_ids_.end())
+    {
+        linked_dirs_.erase(id_it->second);
+        linked_watch_ids_.erase(id_it);
+    }
+}
+
+
+bool source_watcher::read_events(source_changes* chnges)
+{
+    alignas(inotify_event) char buf[64 * 1024];
+    const inotify_event* evnt;
+    std::filesystem::path pth;
+    std::filesystem::path target_pth;
+    file_id target_id;
+    std::error_code err_code;
+    ssize_t read_sz;
+
+    for (;;)
+    {
+        read_sz = ::read(fd_, buf, sizeof(buf));
+        if (read_sz < 0)
+        {
+            return errno == EAGAIN || errno == EINTR;
+        }
+
+        for (char* ptr = buf; ptr < buf + read_sz; ptr += sizeof(inotify_event) + evnt->len)
+        {
+            evnt = reinterpret_cast<const inotify_event*>(ptr);
+
+            if (evnt->mask & IN_Q_OVERFLOW)
+            {
+                chnges->overflowed = true;
+                continue;
+            }
+
+            auto it = watched_dirs_.find(evnt->wd);
+            if (it == watched_dirs_.end())
+            {
+                continue;
+            }
+
+            if (evnt->mask & IN_IGNORED)
+            {
+                forget_watch(evnt->wd);
+                continue;
+            }
+
+            if (evnt->len == 0)
+            {
+                continue;
+            }
+
+            pth = it->second / evnt->name;
+
+            if (evnt->mask & IN_ISDIR)
+            {
+                // A directory moved inside the tree is reported as removed from its old place and
+                // added to the new one, with its entries.
+                if (evnt->mask & (IN_DELETE | IN_MOVED_FROM))
+                {
+                    remove_watches(pth);
+                    chnges->removed_dirs.push_back(std::move(pth));
+                }
+                else if (evnt->mask & (IN_CREATE | IN_MOVED_TO))
+                {
+                    add_watches(pth, {}, file_id(), chnges);
+                }
+            }
+            else if (pth.filename() == file_nme_)
+            {
+                chnges->categories_file_pths.push_back(std::move(pth));
+            }
+            // A symbolic link to a directory is followed like in the scan, and its removal removes
+            // the directory.
+            else if (evnt->mask & (IN_CREATE | IN_MOVED_TO))
+            {
+                if (std::filesystem::is_directory(pth, err_code) &&
+                    enter_linked_directory(pth, &target_pth, &target_id))
+                {
+                    add_watches(pth, target_pth, target_id, chnges);
+                }
+            }
+            else if (watch_descs_.contains(pth.native()))
+            {
+                remove_watches(pth);
+                chnges->removed_dirs.push_back(std::move(pth));
+            }
+
+            if (watch_errno_ != 0)
+            {
+                return false;
+            }
+        }
+    }
+}
+
+
+void source_watcher::take_posted(source_changes* chnges)
+{
+    std::lock_guard<std::mutex> lock(posted_mtx_);
+
+    for (auto& x : posted_pths_)
+    {
+        chnges->forced_pths.push_back(std::move(x));
+    }
+
+    posted_pths_.clear();
+    chnges->posted_nbr = posted_nbr_;
+}
+
+
+}
+
+#endif
@@ -0,0 +1,282 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier/source_watcher.hpp
+ * @brief       source_watcher class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_SOURCE_WATCHER_HPP
+#define CLASSIFIER_SOURCE_WATCHER_HPP
+
+#if defined(__linux__)
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "file_id.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       The changes of the source directory gathered by a source_watcher.
+ */
+struct source_changes
+{
+    /** The categories files created, modified, moved or deleted, sorted. */
+    std::vector<std::filesystem::path> categories_file_pths;
+
+    /** The directories deleted or moved away, along with every entry below them, sorted. */
+    std::vector<std::filesystem::path> removed_dirs;
+
+    /** The categories files posted to be classified again even if they have not changed, sorted. */
+    std::vector<std::filesystem::path> forced_pths;
+
+    /** The number of categories files posted so far, all of them are part of these changes or of
+     *  the previous ones. */
+    std::uint64_t posted_nbr = 0;
+
+    /** Whether events have been lost, the whole source directory has to be scanned again. */
+    bool overflowed = false;
+
+    /**
+     * @brief       Check whether there is no change.
+     * @return      If there is no change true is returned, otherwise false is returned.
+     */
+    [[nodiscard]] bool is_empty() const noexcept
+    {
+        return categories_file_pths.empty() && removed_dirs.empty() && forced_pths.empty() &&
+               !overflowed;
+    }
+
+    /**
+     * @brief       Remove all the changes.
+     */
+    void clear() noexcept
+    {
+        categories_file_pths.clear();
+        removed_dirs.clear();
+        forced_pths.clear();
+        overflowed = false;
+    }
+};
+
+
+/**
+ * @brief       Watch of a source directory tree with inotify. Every directory of the tree is
+ *              watched for the creation, modification and removal of its categories file and for
+ *              the creation, removal and renaming of its subdirectories. The directories that
+ *              appear are watched as soon as they are reported, and the categories files they
+ *              already hold are reported with them. The events of a burst are coalesced: once the
+ *              first event arrives, the events are gathered until the tree stays quiet for the
+ *              debounce delay, or until the maximum delay is reached. Categories files can also be
+ *              posted from other threads, to be classified again along with the next burst. Like
+ *              in the scan, the symbolic links to directories outside of the tree are followed,
+ *              every target being watched once. A directory that cannot be watched, once the
+ *              inotify watches run out for instance, stops the watch instead of being missed.
+ */
+class source_watcher
+{
+public:
+    /** The time without events after which a burst is considered over. */
+    static constexpr std::chrono::milliseconds DEBOUNCE_DELAY{100};
+
+    /** The longest time during which the events of a burst are gathered. */
+    static constexpr std::chrono::milliseconds MAX_DELAY{500};
+
+    /**
+     * @brief       Constructor with parameters.
+     * @param       root_pth : The directory to watch.
+     * @param       file_nme : The name of the categories files.
+     */
+    source_watcher(std::filesystem::path root_pth, std::string file_nme);
+
+    source_watcher(const source_watcher& rhs) = delete;
+
+    /**
+     * @brief       Destructor.
+     */
+    ~source_watcher();
+
+    source_watcher& operator =(const source_watcher& rhs) = delete;
+
+    /**
+     * @brief       Start watching the directory tree.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool open();
+
+    /**
+     * @brief       Block until the directory tree changes and gather the changes of the burst.
+     *              Nothing is consumed while waiting.
+     * @param       chnges : The object in which the changes will be stored.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool wait(source_changes* chnges);
+
+    /**
+     * @brief       Post a categories file to be classified again, as part of the next changes
+     *              gathered. Can be called from any thread.
+     * @param       categories_file_pth : The categories file.
+     * @return      The number of categories files posted so far, this one included.
+     */
+    std::uint64_t post(std::filesystem::path categories_file_pth);
+
+    /**
+     * @brief       Check whether the directory tree is being watched.
+     * @return      If the directory tree is being watched true is returned, otherwise false is
+     *              returned.
+     */
+    [[nodiscard]] bool is_open() const noexcept
+    {
+        return fd_ >= 0;
+    }
+
+    /**
+     * @brief       Get the reason why a directory could not be watched.
+     * @return      The reason, or nullptr if no watch has failed.
+     */
+    [[nodiscard]] const char* get_failure_reason() const noexcept;
+
+    /**
+     * @brief       Stop watching the directory tree.
+     */
+    void close() noexcept;
+
+private:
+    /**
+     * @brief       A directory to watch, along with the target of the symbolic link it is reached
+     *              through, if any.
+     */
+    struct pending_directory
+    {
+        std::filesystem::path pth;
+        std::filesystem::path target_pth;
+        file_id target_id;
+    };
+
+    /**
+     * @brief       Watch a directory and all its subdirectories.
+     * @param       directory_pth : The directory, or the symbolic link to it.
+     * @param       target_pth : The canonical target of the symbolic link, empty for a directory.
+     * @param       target_id : The identifier of the target of the symbolic link.
+     * @param       chnges : The object in which the categories files found are stored, nullptr to
+     *              ignore them.
+     */
+    void add_watches(
+            const std::filesystem::path& directory_pth,
+            const std::filesystem::path& target_pth,
+            const file_id& target_id,
+            source_changes* chnges
+    );
+
+    /**
+     * @brief       Check if a symbolic link to a directory has to be followed, which is the case
+     *              once for every target outside of the tree.
+     * @param       lnk_pth : The symbolic link.
+     * @param       target_pth : The object in which the canonical target will be stored.
+     * @param       target_id : The object in which the identifier of the target will be stored.
+     * @return      If the link has to be followed true is returned, otherwise false is returned.
+     */
+    bool enter_linked_directory(
+            const std::filesystem::path& lnk_pth,
+            std::filesystem::path* target_pth,
+            file_id* target_id
+    );
+
+    /**
+     * @brief       Forget a watch removed.
+     * @param       wd : The watch descriptor.
+     */
+    void forget_watch(int wd);
+
+    /**
+     * @brief       Stop watching a directory and all its subdirectories.
+     * @param       directory_pth : The directory.
+     */
+    void remove_watches(const std::filesystem::path& directory_pth);
+
+    /**
+     * @brief       Read the pending events without blocking.
+     * @param       chnges : The object in which the changes will be stored.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool read_events(source_changes* chnges);
+
+    /**
+     * @brief       Move the posted categories files into the changes.
+     * @param       chnges : The object in which the changes will be stored.
+     */
+    void take_posted(source_changes* chnges);
+
+private:
+    std::filesystem::path root_pth_;
+
+    std::filesystem::path file_nme_;
+
+    int fd_;
+
+    /** The event file that wakes a wait when a categories file is posted. */
+    int wake_fd_;
+
+    std::mutex posted_mtx_;
+
+    std::vector<std::filesystem::path> posted_pths_;
+
+    std::uint64_t posted_nbr_;
+
+    /** The watched directories by watch descriptor. */
+    std::unordered_map<int, std::filesystem::path> watched_dirs_;
+
+    /** The watch descriptors by directory path, in path order to find a directory and the ones
+     *  below it. */
+    std::map<std::filesystem::path::string_type, int> watch_descs_;
+
+    /** The canonical root path followed by a separator, to recognize the links into the tree. */
+    std::filesystem::path::string_type canonical_root_pth_;
+
+    /** The directories watched through a symbolic link, and the root directory. */
+    std::unordered_set<file_id, file_id_hash> linked_dirs_;
+
+    /** The targets of the symbolic links by watch descriptor. */
+    std::unordered_map<int, file_id> linked_watch_ids_;
+
+    /** The error of the watch that failed, zero if none has. */
+    int watch_errno_;
+};
+
+
+}
+
+#endif
+
+
+#endif
@@ -0,0 +1,911 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/state_file.cpp
+ * @brief       state_file class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#endif
+
+#include "state_file.hpp"
+
+
+namespace classifier {
+
+
+namespace {
+
+
+constexpr char STATE_MAGIC[8] = {'C', 'L', 'S', 'S', 'T', 'A', 'T', 'E'};
+
+constexpr std::uint32_t STATE_VERSION = 4;
+
+constexpr char JOURNAL_MAGIC[8] = {'C', 'L', 'S', 'J', 'O', 'U', 'R', 'N'};
+
+/** The smallest sizes of the records, an empty string being its length alone. */
+constexpr std::size_t MIN_STRING_SIZE = sizeof(std::uint32_t);
+
+constexpr std::size_t FILE_ID_SIZE = sizeof(file_id::dev) + sizeof(file_id::ino);
+
+constexpr std::size_t MIN_LINK_SIZE = MIN_STRING_SIZE + FILE_ID_SIZE;
+
+constexpr std::size_t MIN_DIRECTORY_SIZE = MIN_STRING_SIZE + sizeof(std::uint32_t);
+
+constexpr std::size_t MIN_ENTRY_SIZE = MIN_STRING_SIZE + sizeof(file_signature::mtime_ns) +
+                                       sizeof(file_signature::sz) + sizeof(file_signature::ino) +
+                                       sizeof(entry_state::content_hsh) + FILE_ID_SIZE +
+                                       2 * sizeof(std::uint32_t);
+
+/** The records of a journal, every one replacing or removing an entry or a directory. */
+enum class journal_record_types : std::uint8_t
+{
+    ENTRY,
+    ENTRY_REMOVAL,
+    DIRECTORY,
+    DIRECTORY_REMOVAL,
+};
+
+
+class state_writer
+{
+public:
+    template<typename T>
+    void write(const T& val)
+    {
+        buf_.append(reinterpret_cast<const char*>(&val), sizeof(T));
+    }
+
+    void write_string(const state_file::string_type& str)
+    {
+        write(static_cast<std::uint32_t>(str.size()));
+        buf_.append(reinterpret_cast<const char*>(str.data()),
+                    str.size() * sizeof(state_file::string_type::value_type));
+    }
+
+    void write_bytes(const char* dat, std::size_t sz)
+    {
+        buf_.append(dat, sz);
+    }
+
+    void write_entry(
+            const state_file::string_type& categories_file_pth,
+            const entry_state& entry_stte
+    )
+    {
+        write_string(categories_file_pth);
+        write(entry_stte.categories_file_sig.mtime_ns);
+        write(entry_stte.categories_file_sig.sz);
+        write(entry_stte.categories_file_sig.ino);
+        write(entry_stte.content_hsh);
+        write(entry_stte.entry_dir_id.dev);
+        write(entry_stte.entry_dir_id.ino);
+        write(static_cast<std::uint32_t>(entry_stte.lnks.size()));
+        for (auto& x : entry_stte.lnks)
+        {
+            write_string(x.pth);
+            write(x.id.dev);
+            write(x.id.ino);
+        }
+
+        write(static_cast<std::uint32_t>(entry_stte.dirs.size()));
+        for (auto& x : entry_stte.dirs)
+        {
+            write_string(x);
+        }
+    }
+
+    void write_directory(
+            const state_file::string_type& directory_pth,
+            const std::vector<file_id>& ids
+    )
+    {
+        write_string(directory_pth);
+        write(static_cast<std::uint32_t>(ids.size()));
+        for (auto& x : ids)
+        {
+            write(x.dev);
+            write(x.ino);
+        }
+    }
+
+    [[nodiscard]] const std::string& get_buffer() const noexcept
+    {
+        return buf_;
+    }
+
+private:
+    std::string buf_;
+};
+
+
+class state_reader
+{
+public:
+    state_reader(const char* beg, const char* end)
+            : cur_(beg)
+            , end_(end)
+    {
+    }
+
+    template<typename T>
+    bool read(T& val)
+    {
+        if (static_cast<std::size_t>(end_ - cur_) < sizeof(T))
+        {
+            return false;
+        }
+
+        std::memcpy(&val, cur_, sizeof(T));
+        cur_ += sizeof(T);
+
+        return true;
+    }
+
+    bool read_string(state_file::string_type& str)
+    {
+        std::uint32_t len;
+        std::size_t bytes_nbr;
+
+        if (!read(len))
+        {
+            return false;
+        }
+
+        bytes_nbr = len * sizeof(state_file::string_type::value_type);
+        if (static_cast<std::size_t>(end_ - cur_) < bytes_nbr)
+        {
+            return false;
+        }
+
+        str.resize(len);
+        std::memcpy(str.data(), cur_, bytes_nbr);
+        cur_ += bytes_nbr;
+
+        return true;
+    }
+
+    bool read_bytes(char* dat, std::size_t sz)
+    {
+        if (static_cast<std::size_t>(end_ - cur_) < sz)
+        {
+            return false;
+        }
+
+        std::memcpy(dat, cur_, sz);
+        cur_ += sz;
+
+        return true;
+    }
+
+    // A count is checked against the bytes left before room is made for its records, so that a
+    // corrupted count fails the load instead of allocating.
+    [[nodiscard]] bool can_hold(std::uint64_t records_nbr, std::size_t record_sz) const noexcept
+    {
+        return records_nbr <= static_cast<std::size_t>(end_ - cur_) / record_sz;
+    }
+
+    bool read_entry(state_file::string_type& categories_file_pth, entry_state& entry_stte)
+    {
+        std::uint32_t lnks_nbr;
+        std::uint32_t dirs_nbr;
+
+        if (!read_string(categories_file_pth) ||
+            !read(entry_stte.categories_file_sig.mtime_ns) ||
+            !read(entry_stte.categories_file_sig.sz) ||
+            !read(entry_stte.categories_file_sig.ino) ||
+            !read(entry_stte.content_hsh) ||
+            !read(entry_stte.entry_dir_id.dev) ||
+            !read(entry_stte.entry_dir_id.ino) ||
+            !read(lnks_nbr) || !can_hold(lnks_nbr, MIN_LINK_SIZE))
+        {
+            return false;
+        }
+
+        entry_stte.lnks.resize(lnks_nbr);
+        for (auto& x : entry_stte.lnks)
+        {
+            if (!read_string(x.pth) || !read(x.id.dev) || !read(x.id.ino))
+            {
+                return false;
+            }
+        }
+
+        if (!read(dirs_nbr) || !can_hold(dirs_nbr, MIN_STRING_SIZE))
+        {
+            return false;
+        }
+
+        entry_stte.dirs.resize(dirs_nbr);
+        for (auto& x : entry_stte.dirs)
+        {
+            if (!read_string(x))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool read_directory(state_file::string_type& directory_pth, std::vector<file_id>& ids)
+    {
+        std::uint32_t ids_nbr;
+
+        if (!read_string(directory_pth) || !read(ids_nbr) || !can_hold(ids_nbr, FILE_ID_SIZE))
+        {
+            return false;
+        }
+
+        ids.resize(ids_nbr);
+        for (auto& x : ids)
+        {
+            if (!read(x.dev) || !read(x.ino))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] std::size_t get_position(const char* beg) const noexcept
+    {
+        return static_cast<std::size_t>(cur_ - beg);
+    }
+
+    [[nodiscard]] bool is_at_end() const noexcept
+    {
+        return cur_ == end_;
+    }
+
+private:
+    const char* cur_;
+
+    const char* end_;
+};
+
+
+}
+
+
+bool state_file::load(const std::filesystem::path& state_file_pth)
+{
+    std::ifstream ifstr(state_file_pth, std::ios::binary);
+    std::string buf;
+    char magic[sizeof(STATE_MAGIC)];
+    std::uint32_t versn;
+    std::uint32_t char_sz;
+    std::uint64_t dirs_nbr;
+    std::uint64_t entries_nbr;
+
+    clear();
+
+    if (!ifstr.is_open())
+    {
+        return false;
+    }
+
+    buf.assign(std::istreambuf_iterator<char>(ifstr), std::istreambuf_iterator<char>());
+    state_reader readr(buf.data(), buf.data() + buf.size());
+
+    if (!readr.read_bytes(magic, sizeof(magic)) ||
+        std::memcmp(magic, STATE_MAGIC, sizeof(magic)) != 0 ||
+        !readr.read(versn) || versn != STATE_VERSION ||
+        !readr.read(char_sz) || char_sz != sizeof(string_type::value_type) ||
+        !readr.read(gen_) || !readr.read(dirs_nbr) ||
+        !readr.can_hold(dirs_nbr, MIN_DIRECTORY_SIZE))
+    {
+        goto error;
+    }
+
+    dirs_.reserve(dirs_nbr);
+    for (std::uint64_t i = 0; i < dirs_nbr; ++i)
+    {
+        string_type directory_pth;
+        std::vector<file_id> ids;
+
+        if (!readr.read_directory(directory_pth, ids))
+        {
+            goto error;
+        }
+
+        dirs_.emplace(std::move(directory_pth), std::move(ids));
+    }
+
+    if (!readr.read(entries_nbr) || !readr.can_hold(entries_nbr, MIN_ENTRY_SIZE))
+    {
+        goto error;
+    }
+
+    entries_.reserve(entries_nbr);
+    for (std::uint64_t i = 0; i < entries_nbr; ++i)
+    {
+        string_type categories_file_pth;
+        entry_state entry_stte;
+
+        if (!readr.read_entry(categories_file_pth, entry_stte))
+        {
+            goto error;
+        }
+
+        entries_.emplace(std::move(categories_file_pth), std::move(entry_stte));
+    }
+
+    saved_sz_ = buf.size();
+    load_journal(get_journal_path(state_file_pth));
+
+    return true;
+
+error:
+    clear();
+    return false;
+}
+
+
+bool state_file::save(const std::filesystem::path& state_file_pth)
+{
+    std::filesystem::path tmp_pth = state_file_pth;
+    std::ofstream ofstr;
+    std::error_code err_code;
+    state_writer writr;
+    std::random_device rand_dev;
+    std::uint64_t gen;
+
+    tmp_pth += ".tmp";
+
+    // A journal left by a previous state is recognized by its generation and ignored.
+    gen = (static_cast<std::uint64_t>(rand_dev()) << 32) | rand_dev();
+
+    writr.write_bytes(STATE_MAGIC, sizeof(STATE_MAGIC));
+    writr.write(STATE_VERSION);
+    writr.write(static_cast<std::uint32_t>(sizeof(string_type::value_type)));
+    writr.write(gen);
+
+    writr.write(static_cast<std::uint64_t>(dirs_.size()));
+    for (auto& x : dirs_)
+    {
+        writr.write_directory(x.first, x.second);
+    }
+
+    writr.write(static_cast<std::uint64_t>(entries_.size()));
+    for (auto& x : entries_)
+    {
+        writr.write_entry(x.first, x.second);
+    }
+
+    ofstr.open(tmp_pth, std::ios::binary | std::ios::trunc);
+    if (!ofstr.is_open())
+    {
+        return false;
+    }
+
+    ofstr.write(writr.get_buffer().data(), static_cast<std::streamsize>(writr.get_buffer().size()));
+    ofstr.close();
+    if (!ofstr)
+    {
+        std::filesystem::remove(tmp_pth, err_code);
+        return false;
+    }
+
+    std::filesystem::rename(tmp_pth, state_file_pth, err_code);
+    if (err_code)
+    {
+        return false;
+    }
+
+    std::filesystem::remove(get_journal_path(state_file_pth), err_code);
+    gen_ = gen;
+    saved_sz_ = writr.get_buffer().size();
+    journal_sz_ = 0;
+    changed_entry_pths_.clear();
+    changed_dir_pths_.clear();
+
+    return true;
+}
+
+
+bool state_file::save_changes(const std::filesystem::path& state_file_pth)
+{
+    std::filesystem::path journal_pth = get_journal_path(state_file_pth);
+    std::ofstream ofstr;
+    std::error_code err_code;
+    state_writer writr;
+
+    if (!tracking_chnges_ || saved_sz_ == 0)
+    {
+        return save(state_file_pth);
+    }
+
+    if (journal_sz_ == 0)
+    {
+        writr.write_bytes(JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+        writr.write(STATE_VERSION);
+        writr.write(static_cast<std::uint32_t>(sizeof(string_type::value_type)));
+        writr.write(gen_);
+    }
+
+    for (auto& x : changed_dir_pths_)
+    {
+        auto it = dirs_.find(x);
+        if (it != dirs_.end())
+        {
+            writr.write(journal_record_types::DIRECTORY);
+            writr.write_directory(x, it->second);
+        }
+        else
+        {
+            writr.write(journal_record_types::DIRECTORY_REMOVAL);
+            writr.write_string(x);
+        }
+    }
+
+    for (auto& x : changed_entry_pths_)
+    {
+        auto it = entries_.find(x);
+        if (it != entries_.end())
+        {
+            writr.write(journal_record_types::ENTRY);
+            writr.write_entry(x, it->second);
+        }
+        else
+        {
+            writr.write(journal_record_types::ENTRY_REMOVAL);
+            writr.write_string(x);
+        }
+    }
+
+    // Once the journal outgrows the state, the state is saved again in full.
+    if (journal_sz_ + writr.get_buffer().size() > saved_sz_)
+    {
+        return save(state_file_pth);
+    }
+
+    // A record torn by an interrupted append is cut before appending after it.
+    if (journal_sz_ > 0)
+    {
+        std::filesystem::resize_file(journal_pth, journal_sz_, err_code);
+        if (err_code)
+        {
+            return save(state_file_pth);
+        }
+    }
+
+    ofstr.open(journal_pth, std::ios::binary | (journal_sz_ > 0 ? std::ios::app : std::ios::trunc));
+    if (!ofstr.is_open())
+    {
+        return false;
+    }
+
+    ofstr.write(writr.get_buffer().data(), static_cast<std::streamsize>(writr.get_buffer().size()));
+    ofstr.close();
+    if (!ofstr)
+    {
+        journal_sz_ = 0;
+        return save(state_file_pth);
+    }
+
+    journal_sz_ += writr.get_buffer().size();
+    changed_entry_pths_.clear();
+    changed_dir_pths_.clear();
+
+    return true;
+}
+
+
+void state_file::track_changes()
+{
+    tracking_chnges_ = true;
+    sorted_entry_pths_.clear();
+    lnk_uses_.clear();
+    dir_uses_.clear();
+    changed_entry_pths_.clear();
+    changed_dir_pths_.clear();
+
+    for (auto& x : entries_)
+    {
+        sorted_entry_pths_.insert(x.first);
+        update_uses(x.second, true);
+    }
+}
+
+
+const entry_state* state_file::find_entry(const string_type& categories_file_pth) const
+{
+    auto it = entries_.find(categories_file_pth);
+    return it != entries_.end() ? &it->second : nullptr;
+}
+
+
+void state_file::add_entry(string_type categories_file_pth, entry_state entry_stte)
+{
+    if (!tracking_chnges_)
+    {
+        entries_.insert_or_assign(std::move(categories_file_pth), std::move(entry_stte));
+        return;
+    }
+
+    auto it = entries_.find(categories_file_pth);
+    if (it != entries_.end())
+    {
+        update_uses(it->second, false);
+        it->second = std::move(entry_stte);
+    }
+    else
+    {
+        it = entries_.emplace(categories_file_pth, std::move(entry_stte)).first;
+        sorted_entry_pths_.insert(it->first);
+    }
+
+    update_uses(it->second, true);
+    changed_entry_pths_.insert(std::move(categories_file_pth));
+}
+
+
+void state_file::remove_entry(const string_type& categories_file_pth)
+{
+    auto it = entries_.find(categories_file_pth);
+
+    if (it == entries_.end())
+    {
+        return;
+    }
+
+    if (tracking_chnges_)
+    {
+        update_uses(it->second, false);
+        sorted_entry_pths_.erase(it->first);
+        changed_entry_pths_.insert(categories_file_pth);
+    }
+
+    entries_.erase(it);
+}
+
+
+bool state_file::set_link_id(
+        const string_type& categories_file_pth,
+        const string_type& lnk_pth,
+        const file_id& id
+)
+{
+    auto it = entries_.find(categories_file_pth);
+
+    if (it != entries_.end())
+    {
+        for (auto& x : it->second.lnks)
+        {
+            if (x.pth == lnk_pth)
+            {
+                x.id = id;
+                if (tracking_chnges_)
+                {
+                    changed_entry_pths_.insert(categories_file_pth);
+                }
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+const std::vector<file_id>* state_file::find_directory(
+        const string_type& directory_pth
+) const
+{
+    auto it = dirs_.find(directory_pth);
+    return it != dirs_.end() ? &it->second : nullptr;
+}
+
+
+void state_file::add_directory(const string_type& directory_pth)
+{
+    if (dirs_.try_emplace(directory_pth).second && tracking_chnges_)
+    {
+        changed_dir_pths_.insert(directory_pth);
+    }
+}
+
+
+void state_file::add_directory_id(const string_type& directory_pth, const file_id& id)
+{
+    auto& ids = dirs_[directory_pth];
+
+    if (std::find(ids.begin(), ids.end(), id) == ids.end())
+    {
+        ids.push_back(id);
+        if (tracking_chnges_)
+        {
+            changed_dir_pths_.insert(directory_pth);
+        }
+    }
+}
+
+
+void state_file::remove_directory(const string_type& directory_pth)
+{
+    if (dirs_.erase(directory_pth) > 0 && tracking_chnges_)
+    {
+        changed_dir_pths_.insert(directory_pth);
+    }
+}
+
+
+bool state_file::is_link_used(const string_type& lnk_pth) const
+{
+    return lnk_uses_.contains(lnk_pth);
+}
+
+
+bool state_file::is_directory_used(const string_type& directory_pth) const
+{
+    return dir_uses_.contains(directory_pth);
+}
+
+
+std::size_t state_file::get_file_ids_number() const noexcept
+{
+    std::size_t ids_nbr = 0;
+
+    for (auto& x : dirs_)
+    {
+        ids_nbr += x.second.size();
+    }
+
+    for (auto& x : entries_)
+    {
+        ids_nbr += x.second.lnks.size();
+    }
+
+    return ids_nbr;
+}
+
+
+void state_file::clear() noexcept
+{
+    entries_.clear();
+    dirs_.clear();
+    tracking_chnges_ = false;
+    sorted_entry_pths_.clear();
+    lnk_uses_.clear();
+    dir_uses_.clear();
+    changed_entry_pths_.clear();
+    changed_dir_pths_.clear();
+    gen_ = 0;
+    saved_sz_ = 0;
+    journal_sz_ = 0;
+}
+
+
+bool state_file::get_file_signature(
+        const std::filesystem::path& file_pth,
+        file_signature* file_sig
+)
+{
+#if defined(_WIN32)
+    std::error_code err_code;
+    auto last_write_tme = std::filesystem::last_write_time(file_pth, err_code);
+    if (err_code)
+    {
+        return false;
+    }
+
+    file_sig->sz = std::filesystem::file_size(file_pth, err_code);
+    if (err_code)
+    {
+        return false;
+    }
+
+    file_sig->mtime_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            last_write_tme.time_since_epoch()).count();
+    file_sig->ino = 0;
+
+    return true;
+
+#else
+    struct stat file_stat;
+
+    if (::stat(file_pth.c_str(), &file_stat) != 0)
+    {
+        return false;
+    }
+
+#if defined(__APPLE__)
+    file_sig->mtime_ns = static_cast<std::int64_t>(file_stat.st_mtimespec.tv_sec) * 1000000000 +
+                         file_stat.st_mtimespec.tv_nsec;
+#else
+    file_sig->mtime_ns = static_cast<std::int64_t>(file_stat.st_mtim.tv_sec) * 1000000000 +
+                         file_stat.st_mtim.tv_nsec;
+#endif
+    file_sig->sz = static_cast<std::uint64_t>(file_stat.st_size);
+    file_sig->ino = static_cast<std::uint64_t>(file_stat.st_ino);
+
+    return true;
+#endif
+}
+
+
+std::uint64_t state_file::hash_content(const char* dat, std::size_t sz) noexcept
+{
+    std::uint64_t hsh = 0xcbf29ce484222325ULL;
+
+    for (std::size_t i = 0; i < sz; ++i)
+    {
+        hsh ^= static_cast<unsigned char>(dat[i]);
+        hsh *= 0x100000001b3ULL;
+    }
+
+    return hsh;
+}
+
+
+std::filesystem::path state_file::get_journal_path(const std::filesystem::path& state_file_pth)
+{
+    std::filesystem::path journal_pth = state_file_pth;
+
+    journal_pth += JOURNAL_SUFFIX;
+
+    return journal_pth;
+}
+
+
+void state_file::load_journal(const std::filesystem::path& journal_pth)
+{
+    std::ifstream ifstr(journal_pth, std::ios::binary);
+    std::string buf;
+    char magic[sizeof(JOURNAL_MAGIC)];
+    std::uint32_t versn;
+    std::uint32_t char_sz;
+    std::uint64_t gen;
+    journal_record_types recrd_type;
+
+    if (!ifstr.is_open())
+    {
+        return;
+    }
+
+    buf.assign(std::istreambuf_iterator<char>(ifstr), std::istreambuf_iterator<char>());
+    state_reader readr(buf.data(), buf.data() + buf.size());
+
+    // A journal of another state is left for the next save to replace.
+    if (!readr.read_bytes(magic, sizeof(magic)) ||
+        std::memcmp(magic, JOURNAL_MAGIC, sizeof(magic)) != 0 ||
+        !readr.read(versn) || versn != STATE_VERSION ||
+        !readr.read(char_sz) || char_sz != sizeof(string_type::value_type) ||
+        !readr.read(gen) || gen != gen_)
+    {
+        return;
+    }
+
+    // The records are replayed up to the first one torn by an interrupted append.
+    for (;;)
+    {
+        journal_sz_ = readr.get_position(buf.data());
+        if (readr.is_at_end() || !readr.read(recrd_type))
+        {
+            return;
+        }
+
+        string_type pth;
+        entry_state entry_stte;
+        std::vector<file_id> ids;
+
+        switch (recrd_type)
+        {
+            case journal_record_types::ENTRY:
+                if (!readr.read_entry(pth, entry_stte))
+                {
+                    return;
+                }
+
+                entries_.insert_or_assign(std::move(pth), std::move(entry_stte));
+                break;
+
+            case journal_record_types::ENTRY_REMOVAL:
+                if (!readr.read_string(pth))
+                {
+                    return;
+                }
+
+                entries_.erase(pth);
+                break;
+
+            case journal_record_types::DIRECTORY:
+                if (!readr.read_directory(pth, ids))
+                {
+                    return;
+                }
+
+                dirs_.insert_or_assign(std::move(pth), std::move(ids));
+                break;
+
+            case journal_record_types::DIRECTORY_REMOVAL:
+                if (!readr.read_string(pth))
+                {
+                    return;
+                }
+
+                dirs_.erase(pth);
+                break;
+
+            default:
+                return;
+        }
+    }
+}
+
+
+void state_file::update_uses(const entry_state& entry_stte, bool used)
+{
+    std::size_t separator_pos;
+
+    auto update_use = [&](std::unordered_map<string_type, std::uint32_t>& uses,
+                          const string_type& pth)
+    {
+        if (used)
+        {
+            ++uses[pth];
+            return;
+        }
+
+        auto it = uses.find(pth);
+        if (it != uses.end() && --it->second == 0)
+        {
+            uses.erase(it);
+        }
+    };
+
+    // A directory is used by the links and the directories of the entries that it contains.
+    auto update_parent_uses = [&](string_type pth)
+    {
+        while ((separator_pos = pth.find_last_of(std::filesystem::path::preferred_separator)) !=
+               string_type::npos)
+        {
+            pth.resize(separator_pos);
+            update_use(dir_uses_, pth);
+        }
+    };
+
+    for (auto& x : entry_stte.lnks)
+    {
+        update_use(lnk_uses_, x.pth);
+        update_parent_uses(x.pth);
+    }
+
+    for (auto& x : entry_stte.dirs)
+    {
+        update_use(dir_uses_, x);
+        update_parent_uses(x);
+    }
+}
+
+
+}
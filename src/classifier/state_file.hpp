@@ -0,0 +1,366 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/state_file.hpp
+ * @brief       state_file class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_STATE_FILE_HPP
+#define CLASSIFIER_STATE_FILE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "file_id.hpp"
+
+
+namespace classifier {
+
+
+/**
+ * @brief       The stat information used to know whether a categories file has changed.
+ */
+struct file_signature
+{
+    std::int64_t mtime_ns = 0;
+    std::uint64_t sz = 0;
+    std::uint64_t ino = 0;
+
+    bool operator ==(const file_signature& rhs) const noexcept = default;
+};
+
+
+/**
+ * @brief       A link created in the destination directory.
+ */
+struct link_state
+{
+    /** The link path relative to the destination directory. */
+    std::filesystem::path::string_type pth;
+
+    file_id id;
+};
+
+
+/**
+ * @brief       What a categories file produced during a run.
+ */
+struct entry_state
+{
+    file_signature categories_file_sig;
+    std::uint64_t content_hsh = 0;
+
+    /** The identifier of the entry directory, which finds the entry again once renamed. */
+    file_id entry_dir_id;
+
+    /** The links and the other files produced. */
+    std::vector<link_state> lnks;
+
+    /** The category directories produced that do not contain any of the files produced. */
+    std::vector<std::filesystem::path::string_type> dirs;
+};
+
+
+/**
+ * @brief       The state that a run leaves in the destination directory so that the next run only
+ *              processes the categories files that have changed. It records, for every categories
+ *              file, its signature, the hash of its content and the links it produced, and the
+ *              identifiers of the category directories. The links of an entry that changes or
+ *              disappears are removed from it, without auditing the destination directory.
+ */
+class state_file
+{
+public:
+    using string_type = std::filesystem::path::string_type;
+
+    using string_view_type = std::basic_string_view<string_type::value_type>;
+
+    /** The name of the state file inside the destination directory. */
+    static constexpr const char* FILE_NAME = ".classifier.state";
+
+    /** The suffix that the journal of a state file adds to its path. */
+    static constexpr const char* JOURNAL_SUFFIX = ".journal";
+
+    /**
+     * @brief       Load a state file along with its journal, replacing the current content.
+     * @param       state_file_pth : The path of the state file.
+     * @return      If function was successful true is returned, otherwise false is returned and
+     *              the state is left empty.
+     */
+    bool load(const std::filesystem::path& state_file_pth);
+
+    /**
+     * @brief       Save the state. The file is first written under a temporary name and then
+     *              renamed, so an interrupted run never leaves a truncated state behind. Its
+     *              journal is removed.
+     * @param       state_file_pth : The path of the state file.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool save(const std::filesystem::path& state_file_pth);
+
+    /**
+     * @brief       Append the entries and the directories changed since the last save to the
+     *              journal of the state file. The state is saved in full instead when the changes
+     *              are not tracked, when it has not been saved or loaded yet, or when the journal
+     *              would outgrow the state file.
+     * @param       state_file_pth : The path of the state file.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    bool save_changes(const std::filesystem::path& state_file_pth);
+
+    /**
+     * @brief       Track the changes made from now on for save_changes, along with the entries in
+     *              path order and the links and the directories in use. The tracking lasts until
+     *              the next clear.
+     */
+    void track_changes();
+
+    /**
+     * @brief       Check if the changes are tracked.
+     * @return      If the changes are tracked true is returned, otherwise false is returned.
+     */
+    [[nodiscard]] bool is_tracking_changes() const noexcept
+    {
+        return tracking_chnges_;
+    }
+
+    /**
+     * @brief       Find the state of a categories file.
+     * @param       categories_file_pth : The path of the categories file.
+     * @return      The entry state if found, otherwise nullptr.
+     */
+    [[nodiscard]] const entry_state* find_entry(const string_type& categories_file_pth) const;
+
+    /**
+     * @brief       Add the state of a categories file.
+     * @param       categories_file_pth : The path of the categories file.
+     * @param       entry_stte : The entry state.
+     */
+    void add_entry(string_type categories_file_pth, entry_state entry_stte);
+
+    /**
+     * @brief       Remove the state of a categories file.
+     * @param       categories_file_pth : The path of the categories file.
+     */
+    void remove_entry(const string_type& categories_file_pth);
+
+    /**
+     * @brief       Set the identifier of a link produced by a categories file.
+     * @param       categories_file_pth : The path of the categories file.
+     * @param       lnk_pth : The link path relative to the destination directory.
+     * @param       id : The identifier of the link.
+     * @return      If the link has been found true is returned, otherwise false is returned.
+     */
+    bool set_link_id(
+            const string_type& categories_file_pth,
+            const string_type& lnk_pth,
+            const file_id& id
+    );
+
+    /**
+     * @brief       Find the identifiers kept for a category directory.
+     * @param       directory_pth : The directory path relative to the destination directory.
+     * @return      The identifiers if found, otherwise nullptr.
+     */
+    [[nodiscard]] const std::vector<file_id>* find_directory(
+            const string_type& directory_pth
+    ) const;
+
+    /**
+     * @brief       Add a category directory without any identifier yet.
+     * @param       directory_pth : The directory path relative to the destination directory.
+     */
+    void add_directory(const string_type& directory_pth);
+
+    /**
+     * @brief       Add an identifier to keep for a category directory, the directory itself or
+     *              one of its configuration files.
+     * @param       directory_pth : The directory path relative to the destination directory.
+     * @param       id : The identifier to keep.
+     */
+    void add_directory_id(const string_type& directory_pth, const file_id& id);
+
+    /**
+     * @brief       Remove a category directory.
+     * @param       directory_pth : The directory path relative to the destination directory.
+     */
+    void remove_directory(const string_type& directory_pth);
+
+    /**
+     * @brief       Check if an entry produces a link. The changes have to be tracked.
+     * @param       lnk_pth : The link path relative to the destination directory.
+     * @return      If an entry produces the link true is returned, otherwise false is returned.
+     */
+    [[nodiscard]] bool is_link_used(const string_type& lnk_pth) const;
+
+    /**
+     * @brief       Check if an entry produces a link or records a directory inside a directory,
+     *              or records the directory itself. The changes have to be tracked.
+     * @param       directory_pth : The directory path relative to the destination directory.
+     * @return      If the directory is used true is returned, otherwise false is returned.
+     */
+    [[nodiscard]] bool is_directory_used(const string_type& directory_pth) const;
+
+    /**
+     * @brief       Call a function with the path of every categories file inside a directory, in
+     *              path order. The changes have to be tracked.
+     * @param       directory_pth : The directory path.
+     * @param       fn : The function to call.
+     */
+    template<typename TpFunction>
+    void for_each_entry_under(const string_type& directory_pth, TpFunction&& fn) const
+    {
+        string_type prefx = directory_pth;
+        prefx += std::filesystem::path::preferred_separator;
+
+        for (auto it = sorted_entry_pths_.lower_bound(prefx);
+             it != sorted_entry_pths_.end() && it->starts_with(prefx); ++it)
+        {
+            fn(*it);
+        }
+    }
+
+    /**
+     * @brief       Call a function with the path and the state of every categories file.
+     * @param       fn : The function to call.
+     */
+    template<typename TpFunction>
+    void for_each_entry(TpFunction&& fn) const
+    {
+        for (auto& [pth, entry_stte] : entries_)
+        {
+            fn(pth, entry_stte);
+        }
+    }
+
+    /**
+     * @brief       Call a function with the path of every category directory.
+     * @param       fn : The function to call.
+     */
+    template<typename TpFunction>
+    void for_each_directory(TpFunction&& fn) const
+    {
+        for (auto& x : dirs_)
+        {
+            fn(x.first);
+        }
+    }
+
+    /**
+     * @brief       Remove all the content.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief       Get the number of entries.
+     * @return      The number of entries.
+     */
+    [[nodiscard]] std::size_t get_entries_number() const noexcept
+    {
+        return entries_.size();
+    }
+
+    /**
+     * @brief       Get the number of file identifiers, links and directories, the state holds. It
+     *              is the number of files that the next run is expected to keep.
+     * @return      The number of file identifiers.
+     */
+    [[nodiscard]] std::size_t get_file_ids_number() const noexcept;
+
+    /**
+     * @brief       Get the signature of a file.
+     * @param       file_pth : The path of the file.
+     * @param       file_sig : The object in which the signature will be stored.
+     * @return      If function was successful true is returned, otherwise false is returned.
+     */
+    static bool get_file_signature(const std::filesystem::path& file_pth, file_signature* file_sig);
+
+    /**
+     * @brief       Hash the content of a file (64 bits FNV-1a).
+     * @param       dat : The content of the file.
+     * @param       sz : The content size.
+     * @return      The hash of the content.
+     */
+    static std::uint64_t hash_content(const char* dat, std::size_t sz) noexcept;
+
+private:
+    /**
+     * @brief       Get the path of the journal of a state file.
+     * @param       state_file_pth : The path of the state file.
+     * @return      The path of the journal.
+     */
+    static std::filesystem::path get_journal_path(const std::filesystem::path& state_file_pth);
+
+    /**
+     * @brief       Replay the journal of the state file loaded, if it belongs to it.
+     * @param       journal_pth : The path of the journal.
+     */
+    void load_journal(const std::filesystem::path& journal_pth);
+
+    /**
+     * @brief       Count the links and the directories of an entry in or out of the ones in use.
+     * @param       entry_stte : The entry state.
+     * @param       used : If the entry is added true, if it is removed false.
+     */
+    void update_uses(const entry_state& entry_stte, bool used);
+
+private:
+    std::unordered_map<string_type, entry_state> entries_;
+
+    std::unordered_map<string_type, std::vector<file_id>> dirs_;
+
+    bool tracking_chnges_ = false;
+
+    /** The paths of the entries in order, viewing the keys of the entries. */
+    std::set<string_view_type, std::less<>> sorted_entry_pths_;
+
+    /** The number of entries producing every link. */
+    std::unordered_map<string_type, std::uint32_t> lnk_uses_;
+
+    /** The number of links and directories recorded inside every directory, or recording it. */
+    std::unordered_map<string_type, std::uint32_t> dir_uses_;
+
+    std::unordered_set<string_type> changed_entry_pths_;
+
+    std::unordered_set<string_type> changed_dir_pths_;
+
+    /** The generation of the state file saved or loaded, which its journal carries. */
+    std::uint64_t gen_ = 0;
+
+    /** The size of the state file saved or loaded, zero until then. */
+    std::uint64_t saved_sz_ = 0;
+
+    /** The size of the journal of the state file, zero while it has none. */
+    std::uint64_t journal_sz_ = 0;
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,107 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/string_interner.cpp
+ * @brief       string_interner class implementation.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <cstring>
+
+#include "string_interner.hpp"
+
+
+namespace classifier {
+
+
+std::uint32_t string_interner::intern(std::string_view str)
+{
+    auto id = static_cast<std::uint32_t>(strs_.size());
+    char* dest;
+
+    auto it = ids_.find(str);
+    if (it != ids_.end())
+    {
+        return it->second;
+    }
+
+    if (str.size() > BLOCK_SIZE / 4)
+    {
+        large_strs_.push_back(std::make_unique_for_overwrite<char[]>(str.size()));
+        dest = large_strs_.back().get();
+    }
+    else
+    {
+        if (str.size() > blk_free_sz_ || blks_.empty())
+        {
+            blks_.push_back(std::make_unique_for_overwrite<char[]>(BLOCK_SIZE));
+            blk_free_sz_ = BLOCK_SIZE;
+        }
+
+        dest = blks_.back().get() + BLOCK_SIZE - blk_free_sz_;
+        blk_free_sz_ -= str.size();
+    }
+
+    if (!str.empty())
+    {
+        std::memcpy(dest, str.data(), str.size());
+    }
+
+    strs_.emplace_back(dest, str.size());
+    ids_.emplace(strs_.back(), id);
+
+    return id;
+}
+
+
+std::uint32_t string_interner::find(std::string_view str) const
+{
+    auto it = ids_.find(str);
+    return it != ids_.end() ? it->second : NPOS;
+}
+
+
+void string_interner::remove(std::uint32_t id)
+{
+    auto last_id = static_cast<std::uint32_t>(strs_.size() - 1);
+
+    ids_.erase(strs_[id]);
+    if (id != last_id)
+    {
+        strs_[id] = strs_[last_id];
+        ids_[strs_[id]] = id;
+    }
+
+    strs_.pop_back();
+}
+
+
+void string_interner::clear() noexcept
+{
+    ids_.clear();
+    strs_.clear();
+    large_strs_.clear();
+    blks_.clear();
+    blk_free_sz_ = 0;
+}
+
+
+}
@@ -0,0 +1,142 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier/string_interner.hpp
+ * @brief       string_interner class header.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#ifndef CLASSIFIER_STRING_INTERNER_HPP
+#define CLASSIFIER_STRING_INTERNER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace classifier {
+
+
+/**
+ * @brief       Table that stores every distinct string once and identifies it by a compact integer,
+ *              the identifiers being given in order from zero. The strings are copied into large
+ *              blocks that are never moved, so the views handed out stay valid until the table is
+ *              cleared.
+ */
+class string_interner
+{
+public:
+    /** The value returned when a string is not in the table. */
+    static constexpr std::uint32_t NPOS = static_cast<std::uint32_t>(-1);
+
+    /** The size of the blocks in which the strings are copied. */
+    static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+    /**
+     * @brief       Default constructor.
+     */
+    string_interner() = default;
+
+    string_interner(const string_interner& rhs) = delete;
+
+    /**
+     * @brief       Move constructor. The views handed out stay valid, the blocks are not moved.
+     * @param       rhs : Object to move.
+     */
+    string_interner(string_interner&& rhs) noexcept = default;
+
+    string_interner& operator =(const string_interner& rhs) = delete;
+
+    /**
+     * @brief       Move assignment operator. The views handed out stay valid, the blocks are not
+     *              moved.
+     * @param       rhs : Object to move.
+     * @return      The object who call the method.
+     */
+    string_interner& operator =(string_interner&& rhs) noexcept = default;
+
+    /**
+     * @brief       Get the identifier of a string, adding the string if it is not in the table.
+     * @param       str : The string.
+     * @return      The identifier of the string.
+     */
+    std::uint32_t intern(std::string_view str);
+
+    /**
+     * @brief       Get the identifier of a string without adding it.
+     * @param       str : The string.
+     * @return      The identifier of the string if found, otherwise NPOS.
+     */
+    [[nodiscard]] std::uint32_t find(std::string_view str) const;
+
+    /**
+     * @brief       Remove a string, the last string takes its identifier. The bytes of the string
+     *              are only released by clear.
+     * @param       id : The identifier, it has to come from this table.
+     */
+    void remove(std::uint32_t id);
+
+    /**
+     * @brief       Get the string of an identifier.
+     * @param       id : The identifier, it has to come from this table.
+     * @return      The string.
+     */
+    [[nodiscard]] std::string_view get_string(std::uint32_t id) const noexcept
+    {
+        return strs_[id];
+    }
+
+    /**
+     * @brief       Get the number of strings.
+     * @return      The number of strings.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return strs_.size();
+    }
+
+    /**
+     * @brief       Remove all the strings, which invalidates all the identifiers.
+     */
+    void clear() noexcept;
+
+private:
+    std::vector<std::unique_ptr<char[]>> blks_;
+
+    /** The strings too large to share a block, each in its own allocation. */
+    std::vector<std::unique_ptr<char[]>> large_strs_;
+
+    /** The free space left in the last block. */
+    std::size_t blk_free_sz_ = 0;
+
+    /** The strings by identifier, viewing the blocks. */
+    std::vector<std::string_view> strs_;
+
+    std::unordered_map<std::string_view, std::uint32_t> ids_;
+};
+
+
+}
+
+
+#endif
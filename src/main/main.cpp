@@ -37,6 +37,40 @@ int main(int argc, char* argv[])
     try 
     {
         classifier::program_args prog_args;
+
+        if (argc > 1 && std::string_view(argv[1]) == "query")
+        {
+            spd::ap::arg_parser query_ap("classifier query");
+
+            query_ap.add_help_menu()
+                    .description("Print the entries that match an expression, answered from the "
+                                 "index saved in the destination directory by the last run "
+                                 "without reading the categories files.")
+                    .epilogue("Example:\n"
+                              "$ classifier query 'Genres=Drama AND Languages=French' "
+                              "./Categories");
+
+            query_ap.add_keyless_arg("EXPRESSION")
+                    .description("The expression that combines Key, Key=Value, Key!=Value, "
+                                 "Key<Value, Key<=Value, Key>Value and Key>=Value with AND, OR, "
+                                 "NOT and parentheses.")
+                    .store_into(&prog_args.query_expr);
+
+            query_ap.add_keyless_arg("DESTINATION-DIR")
+                    .description("Destination directory.")
+                    .store_into(&prog_args.destination_dir);
+
+            query_ap.add_help_arg("--help", "-h")
+                    .description("Display this help and exit.");
+
+            // The subcommand is parsed as the program name.
+            query_ap.parse_args(argc - 1, argv + 1);
+
+            classifier::program prog(std::move(prog_args));
+
+            return prog.execute();
+        }
+
         spd::ap::arg_parser ap("classifier");
         
         ap.add_help_menu()
@@ -45,6 +79,7 @@ int main(int argc, char* argv[])
                              "categories.")
                 .epilogue("Example:\n"
                           "$ classifier ./Index ./Categories\n"
+                          "$ classifier query 'Genres=Drama AND Languages=French' ./Categories\n"
                           "\n"
                           "Example of JSON file:\n"
                           "{\n"
@@ -61,6 +96,70 @@ int main(int argc, char* argv[])
                 .description("The categories file name. The default value is '.categories.json'.")
                 .store_into(&prog_args.categories_file_nme);
 
+        ap.add_key_value_arg("--catalog", "-c")
+                .description("Read the categories of every entry from a single JSON Lines file "
+                             "instead of searching the categories files in the source directory. "
+                             "Each line holds the entry path, relative to the source directory, "
+                             "and its categories: [\"Kimi ni Todoke\", {\"Mark\": 9}]")
+                .store_into(&prog_args.catalog_fle);
+
+        ap.add_key_value_arg("--views", "-e")
+                .description("Build the views declared in a JSON file as directories of links "
+                             "next to the category directories. Each view maps a directory name "
+                             "to an expression that combines Key, Key=Value, Key!=Value, "
+                             "Key<Value, Key<=Value, Key>Value and Key>=Value with AND, OR, NOT "
+                             "and parentheses: {\"Top dramas\": \"Genres=Drama AND Mark>=8 AND "
+                             "NOT Status=Ongoing\"}")
+                .store_into(&prog_args.views_fle);
+
+        ap.add_key_value_arg("--jobs", "-j")
+                .description("The number of threads used to scan the source directory. The "
+                             "default value is the number of CPUs available to the process.")
+                .store_into(&prog_args.jobs_nbr);
+
+        ap.add_key_value_arg("--queue-depth", "-q")
+                .description("The number of operations submitted at once to the kernel with "
+                             "io_uring when updating the destination directory on Linux. Use 0 "
+                             "to issue one system call per operation. The default value is 64.")
+                .store_into(&prog_args.queue_depth);
+
+        ap.add_key_arg("--rebuild", "-r")
+                .description("Ignore the state saved in the destination directory by the previous "
+                             "run, process every categories file again and audit the whole "
+                             "destination directory for extra files. Without it or --audit, only "
+                             "the links recorded for the entries that changed or disappeared are "
+                             "removed. Use it after modifying the destination directory by hand.")
+                .store_presence(&prog_args.rebuild);
+
+        ap.add_key_arg("--audit", "-a")
+                .description("Audit the whole destination directory for the files that no entry "
+                             "produces, instead of only removing the links recorded for the "
+                             "entries that changed or disappeared. Unlike --rebuild, the "
+                             "unchanged categories files are not processed again.")
+                .store_presence(&prog_args.audit);
+
+        ap.add_key_arg("--dry-run", "-n")
+                .description("Print the operations needed to update the destination directory "
+                             "and the extra files found, without modifying anything.")
+                .store_presence(&prog_args.dry_run);
+
+        ap.add_key_arg("--watch", "-w")
+                .description("Keep running after the first run and update the destination "
+                             "directory as soon as categories files or entry directories are "
+                             "created, modified, renamed or deleted in the source directory. "
+                             "Only available on Linux.")
+                .store_presence(&prog_args.watch);
+
+        ap.add_key_arg("--daemon", "-d")
+                .description("Keep running like the watch mode and serve requests on the Unix "
+                             "socket '.classifier.socket' of the destination directory, once the "
+                             "first run is done. Each request is a line answered by 'OK "
+                             "<lines-number>' and the lines of the answer, or by 'ERROR "
+                             "<message>': 'QUERY <expression>' prints the matching entries, "
+                             "'RECLASSIFY <entry-path>' classifies an entry again and 'STATS' "
+                             "prints the counters of the daemon. Only available on Linux.")
+                .store_presence(&prog_args.daemon);
+
         ap.add_keyless_arg("SOURCE-DIR")
                 .description("Source directory.")
                 .store_into(&prog_args.source_dir);
@@ -0,0 +1,106 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/bounded_queue_test.cpp
+ * @brief       bounded_queue unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/bounded_queue.hpp"
+
+
+TEST(classifier_bounded_queue, try_push_try_pop)
+{
+    classifier::bounded_queue<int> que(3);
+    int val = 0;
+
+    EXPECT_FALSE(que.try_pop(val));
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(que.try_push(int(i)));
+    }
+    EXPECT_FALSE(que.try_push(4));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(que.try_pop(val));
+        EXPECT_EQ(val, i);
+    }
+    EXPECT_FALSE(que.try_pop(val));
+}
+
+
+TEST(classifier_bounded_queue, multiple_producers_multiple_consumers)
+{
+    constexpr int producers_nbr = 4;
+    constexpr int consumers_nbr = 4;
+    constexpr long long values_nbr = 100000;
+    classifier::bounded_queue<long long> que(64);
+    std::vector<std::thread> producer_thrds;
+    std::vector<std::thread> consumer_thrds;
+    std::vector<long long> sums(consumers_nbr, 0);
+    long long total_sum = 0;
+
+    for (int i = 0; i < consumers_nbr; ++i)
+    {
+        consumer_thrds.emplace_back([&, i]()
+        {
+            long long val;
+            while (que.pop(val))
+            {
+                sums[i] += val;
+            }
+        });
+    }
+
+    for (int i = 0; i < producers_nbr; ++i)
+    {
+        producer_thrds.emplace_back([&]()
+        {
+            for (long long j = 1; j <= values_nbr; ++j)
+            {
+                que.push(std::move(j));
+            }
+        });
+    }
+
+    for (auto& x : producer_thrds)
+    {
+        x.join();
+    }
+    que.close();
+    for (auto& x : consumer_thrds)
+    {
+        x.join();
+    }
+
+    for (auto& x : sums)
+    {
+        total_sum += x;
+    }
+
+    EXPECT_EQ(total_sum, producers_nbr * values_nbr * (values_nbr + 1) / 2);
+}
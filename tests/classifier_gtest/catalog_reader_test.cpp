@@ -0,0 +1,103 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/catalog_reader_test.cpp
+ * @brief       catalog_reader unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/catalog_reader.hpp"
+
+
+TEST(classifier_catalog_reader, read_line)
+{
+    std::filesystem::path catalog_pth = std::filesystem::temp_directory_path() /
+                                        "classifier_catalog_reader_test.jsonl";
+    std::string long_lne(100, 'x');
+    std::vector<std::string> lnes;
+    std::string_view lne;
+
+    std::ofstream(catalog_pth, std::ios::binary) << "first\n" << long_lne << "\r\n\nlast";
+
+    // A buffer smaller than a line has to grow.
+    classifier::catalog_reader catalog_readr(16);
+
+    ASSERT_TRUE(catalog_readr.open(catalog_pth));
+    while (catalog_readr.read_line(&lne))
+    {
+        lnes.emplace_back(lne);
+    }
+
+    EXPECT_FALSE(catalog_readr.has_failed());
+    EXPECT_EQ(catalog_readr.get_line_number(), 4);
+    EXPECT_EQ(lnes, std::vector<std::string>({"first", long_lne, "", "last"}));
+
+    EXPECT_FALSE(catalog_readr.open(catalog_pth.string() + ".missing"));
+    EXPECT_FALSE(catalog_readr.read_line(&lne));
+
+    std::filesystem::remove(catalog_pth);
+}
+
+
+TEST(classifier_catalog_reader, parse_line)
+{
+    std::string entry_pth;
+    std::string_view contnt;
+
+    ASSERT_TRUE(classifier::catalog_reader::parse_line(
+            R"( ["Index/Kimi ni Todoke/", {"Genres": ["Drama"], "Mark": 9}] )", &entry_pth,
+            &contnt));
+    EXPECT_EQ(entry_pth, "Index/Kimi ni Todoke");
+    EXPECT_EQ(contnt, R"({"Genres": ["Drama"], "Mark": 9})");
+
+    ASSERT_TRUE(classifier::catalog_reader::parse_line(R"(["Say \"Hi\"",{}])", &entry_pth,
+                                                       &contnt));
+    EXPECT_EQ(entry_pth, "Say \"Hi\"");
+    EXPECT_EQ(contnt, "{}");
+
+    for (std::string_view lne : {"", "[]", R"({"Index": {}})", R"(["Index" {}])",
+                                 R"(["Index", {})", R"(["Index", ])", R"(["/", {}])",
+                                 R"(["Index)", R"(["Bad \q", {}])"})
+    {
+        EXPECT_FALSE(classifier::catalog_reader::parse_line(lne, &entry_pth, &contnt)) << lne;
+    }
+
+    for (std::string_view pth : {"Index", "Index/Kimi ni Todoke", "./Index", "Index/..a", "...",
+                                 "a..b/c"})
+    {
+        EXPECT_TRUE(classifier::catalog_reader::is_inner_entry_path(pth)) << pth;
+    }
+
+    for (std::string_view pth : {"", "/etc", "\\Index", "..", "../Index", "Index/..",
+                                 "Index/../../etc", "Index\\..\\.."})
+    {
+        EXPECT_FALSE(classifier::catalog_reader::is_inner_entry_path(pth)) << pth;
+    }
+
+    EXPECT_TRUE(classifier::catalog_reader::is_blank_line(" \t\r"));
+    EXPECT_FALSE(classifier::catalog_reader::is_blank_line(" [ "));
+}
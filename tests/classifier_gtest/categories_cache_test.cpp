@@ -0,0 +1,192 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/categories_cache_test.cpp
+ * @brief       categories_cache unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/categories_cache.hpp"
+
+
+namespace {
+
+
+std::vector<std::pair<classifier::category_token_types, std::string>> get_tokens(
+        const classifier::category_list& categories
+)
+{
+    std::vector<std::pair<classifier::category_token_types, std::string>> tokns;
+
+    for (auto& x : categories.get_tokens())
+    {
+        tokns.emplace_back(x.tokn_type, categories.get_text(x));
+    }
+
+    return tokns;
+}
+
+
+}
+
+
+TEST(classifier_categories_cache, save_load)
+{
+    std::filesystem::path cache_file_pth = std::filesystem::temp_directory_path() /
+                                           "classifier_categories_cache_test";
+    classifier::file_signature drama_sig = {1, 2, 3};
+    classifier::file_signature comedy_sig = {4, 5, 6};
+    classifier::category_list drama_categories;
+    classifier::category_list comedy_categories;
+    classifier::category_list categories;
+    std::uint64_t content_hsh = 0;
+
+    ASSERT_TRUE(drama_categories.parse(R"({"Genres": ["Drama", "Shoujo"], "Seen": true})"));
+    ASSERT_TRUE(comedy_categories.parse(R"({"Genres": "Comedy", "Mark": 9, "Old": false})"));
+
+    {
+        classifier::categories_cache cche;
+
+        EXPECT_FALSE(cche.load(cache_file_pth.string() + ".missing"));
+        cche.add("drama", drama_sig, 11, drama_categories);
+        cche.add("comedy", comedy_sig, 22, comedy_categories);
+        ASSERT_TRUE(cche.save(cache_file_pth));
+    }
+
+    {
+        classifier::categories_cache cche;
+
+        ASSERT_TRUE(cche.load(cache_file_pth));
+
+        ASSERT_TRUE(cche.find("drama", drama_sig, &content_hsh, &categories));
+        EXPECT_EQ(content_hsh, 11);
+        EXPECT_EQ(get_tokens(categories), get_tokens(drama_categories));
+
+        EXPECT_FALSE(cche.find("drama", comedy_sig, &content_hsh, &categories));
+        EXPECT_FALSE(cche.find("missing", drama_sig, &content_hsh, &categories));
+
+        ASSERT_TRUE(cche.find(22, &categories));
+        EXPECT_EQ(get_tokens(categories), get_tokens(comedy_categories));
+        EXPECT_FALSE(cche.find(33, &categories));
+
+        // Only the files carried over make it to the next cache.
+        EXPECT_TRUE(cche.keep("comedy", drama_sig));
+        EXPECT_FALSE(cche.keep("missing", drama_sig));
+        ASSERT_TRUE(cche.save(cache_file_pth));
+    }
+
+    {
+        classifier::categories_cache cche;
+
+        ASSERT_TRUE(cche.load(cache_file_pth));
+        EXPECT_FALSE(cche.find("drama", drama_sig, &content_hsh, &categories));
+
+        ASSERT_TRUE(cche.find("comedy", drama_sig, &content_hsh, &categories));
+        EXPECT_EQ(content_hsh, 22);
+        EXPECT_EQ(get_tokens(categories), get_tokens(comedy_categories));
+    }
+
+    // A truncated cache is not used at all.
+    std::filesystem::resize_file(cache_file_pth, std::filesystem::file_size(cache_file_pth) - 1);
+
+    {
+        classifier::categories_cache cche;
+
+        EXPECT_FALSE(cche.load(cache_file_pth));
+        EXPECT_FALSE(cche.find(22, &categories));
+    }
+
+    std::filesystem::remove(cache_file_pth);
+}
+
+
+TEST(classifier_categories_cache, append)
+{
+    std::filesystem::path cache_file_pth = std::filesystem::temp_directory_path() /
+                                           "classifier_categories_cache_append_test";
+    classifier::file_signature drama_sig = {1, 2, 3};
+    classifier::file_signature comedy_sig = {4, 5, 6};
+    classifier::category_list drama_categories;
+    classifier::category_list comedy_categories;
+    classifier::category_list categories;
+    std::uint64_t content_hsh = 0;
+    std::uintmax_t saved_sz;
+
+    ASSERT_TRUE(drama_categories.parse(R"({"Genres": ["Drama", "Shoujo"], "Seen": true})"));
+    ASSERT_TRUE(comedy_categories.parse(R"({"Genres": "Comedy", "Mark": 9, "Old": false})"));
+
+    {
+        classifier::categories_cache cche;
+
+        // Nothing has been saved yet, the records are saved in full.
+        cche.add("drama", drama_sig, 11, drama_categories);
+        ASSERT_TRUE(cche.append(cache_file_pth));
+        saved_sz = std::filesystem::file_size(cache_file_pth);
+
+        // A record appended replaces the one of the same file.
+        cche.add("drama", comedy_sig, 22, comedy_categories);
+        cche.add("comedy", comedy_sig, 22, comedy_categories);
+        ASSERT_TRUE(cche.append(cache_file_pth));
+        EXPECT_GT(std::filesystem::file_size(cache_file_pth), saved_sz);
+    }
+
+    {
+        classifier::categories_cache cche;
+
+        ASSERT_TRUE(cche.load(cache_file_pth));
+        EXPECT_FALSE(cche.find("drama", drama_sig, &content_hsh, &categories));
+        ASSERT_TRUE(cche.find("drama", comedy_sig, &content_hsh, &categories));
+        EXPECT_EQ(content_hsh, 22);
+        EXPECT_EQ(get_tokens(categories), get_tokens(comedy_categories));
+        EXPECT_TRUE(cche.find("comedy", comedy_sig, &content_hsh, &categories));
+
+        // Once the records appended outgrow the ones saved, only the last record of every file
+        // is kept.
+        cche.add("drama", drama_sig, 11, drama_categories);
+        ASSERT_TRUE(cche.save(cache_file_pth));
+        saved_sz = std::filesystem::file_size(cache_file_pth);
+        for (std::uint64_t i = 0; i < 10; ++i)
+        {
+            cche.add("drama", {static_cast<std::int64_t>(i), 2, 3}, 11, drama_categories);
+            ASSERT_TRUE(cche.append(cache_file_pth));
+        }
+
+        EXPECT_LE(std::filesystem::file_size(cache_file_pth), saved_sz * 2);
+    }
+
+    {
+        classifier::categories_cache cche;
+
+        ASSERT_TRUE(cche.load(cache_file_pth));
+        ASSERT_TRUE(cche.find("drama", {9, 2, 3}, &content_hsh, &categories));
+        EXPECT_EQ(get_tokens(categories), get_tokens(drama_categories));
+        EXPECT_FALSE(cche.find("drama", {8, 2, 3}, &content_hsh, &categories));
+        EXPECT_FALSE(cche.find("comedy", comedy_sig, &content_hsh, &categories));
+    }
+
+    std::filesystem::remove(cache_file_pth);
+}
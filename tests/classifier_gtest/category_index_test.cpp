@@ -0,0 +1,174 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier_gtest/category_index_test.cpp
+ * @brief       category_index unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/category_index.hpp"
+
+
+namespace {
+
+
+std::vector<std::uint32_t> get_entries(const classifier::category_index& indx,
+                                       std::uint32_t ctgry_id)
+{
+    std::vector<std::uint32_t> entry_ids;
+
+    indx.get_category_entries(ctgry_id).for_each([&](std::uint32_t entry_id)
+    {
+        entry_ids.push_back(entry_id);
+    });
+
+    return entry_ids;
+}
+
+
+}
+
+
+TEST(classifier_category_index, add_find)
+{
+    classifier::category_index indx;
+    std::uint32_t genres_id = indx.add_category(classifier::category_index::NPOS, "Genres");
+    std::uint32_t drama_id = indx.add_category(genres_id, "Drama");
+    std::uint32_t comedy_id = indx.add_category(genres_id, "Comedy");
+    std::uint32_t seen_id = indx.add_category(classifier::category_index::NPOS, "Seen");
+    std::vector<std::uint32_t> ctgry_ids = {drama_id, seen_id, drama_id};
+
+    EXPECT_EQ(indx.add_category(genres_id, "Drama"), drama_id);
+    EXPECT_EQ(indx.find_category(genres_id, "Comedy"), comedy_id);
+    EXPECT_EQ(indx.find_category(classifier::category_index::NPOS, "Drama"),
+              classifier::category_index::NPOS);
+    EXPECT_EQ(indx.get_key_category(drama_id), genres_id);
+    EXPECT_EQ(indx.get_category_name(drama_id), "Drama");
+
+    EXPECT_EQ(indx.add_entry("a", ctgry_ids), 0);
+    ctgry_ids = {comedy_id, drama_id};
+    EXPECT_EQ(indx.add_entry("b", ctgry_ids), 1);
+    EXPECT_EQ(indx.add_entry("a", ctgry_ids), 0);
+
+    EXPECT_EQ(indx.get_entries_number(), 2);
+    EXPECT_EQ(indx.find_entry("b"), 1);
+    EXPECT_EQ(indx.find_entry("c"), classifier::category_index::NPOS);
+    EXPECT_EQ(indx.get_entry_path(1), "b");
+    EXPECT_EQ(std::vector<std::uint32_t>(indx.get_entry_categories(0).begin(),
+                                         indx.get_entry_categories(0).end()),
+              (std::vector<std::uint32_t>{drama_id, seen_id}));
+
+    EXPECT_EQ(get_entries(indx, drama_id), (std::vector<std::uint32_t>{0, 1}));
+    EXPECT_EQ(get_entries(indx, comedy_id), (std::vector<std::uint32_t>{1}));
+    EXPECT_EQ(get_entries(indx, genres_id), (std::vector<std::uint32_t>{}));
+}
+
+
+TEST(classifier_category_index, remove_entry)
+{
+    classifier::category_index indx;
+    std::uint32_t mark_id = indx.add_category(classifier::category_index::NPOS, "Mark");
+    std::uint32_t one_id = indx.add_category(mark_id, "1");
+    std::uint32_t two_id = indx.add_category(mark_id, "2");
+    std::vector<std::uint32_t> ctgry_ids;
+
+    for (std::uint32_t i = 0; i < 4; ++i)
+    {
+        ctgry_ids = {i % 2 == 0 ? one_id : two_id};
+        indx.add_entry("entry" + std::to_string(i), ctgry_ids);
+    }
+
+    // The last entry takes the identifier of the removed one.
+    EXPECT_TRUE(indx.remove_entry("entry1"));
+    EXPECT_FALSE(indx.remove_entry("entry1"));
+    EXPECT_EQ(indx.get_entries_number(), 3);
+    EXPECT_EQ(indx.find_entry("entry1"), classifier::category_index::NPOS);
+    EXPECT_EQ(indx.find_entry("entry3"), 1);
+    EXPECT_EQ(indx.get_entry_path(1), "entry3");
+    EXPECT_EQ(indx.get_entry_categories(1)[0], two_id);
+    EXPECT_EQ(get_entries(indx, one_id), (std::vector<std::uint32_t>{0, 2}));
+    EXPECT_EQ(get_entries(indx, two_id), (std::vector<std::uint32_t>{1}));
+
+    // A removed entry is added again with its new categories, after enough removals to compact
+    // the entries.
+    ctgry_ids = {one_id, two_id};
+    EXPECT_TRUE(indx.remove_entry("entry3"));
+    EXPECT_TRUE(indx.remove_entry("entry2"));
+    EXPECT_EQ(indx.add_entry("entry3", ctgry_ids), 1);
+    EXPECT_EQ(indx.get_entries_number(), 2);
+    EXPECT_EQ(indx.get_entry_path(0), "entry0");
+    EXPECT_EQ(indx.get_entry_categories(0)[0], one_id);
+    EXPECT_EQ(indx.get_entry_categories(1).size(), 2u);
+    EXPECT_EQ(get_entries(indx, one_id), (std::vector<std::uint32_t>{0, 1}));
+    EXPECT_EQ(get_entries(indx, two_id), (std::vector<std::uint32_t>{1}));
+
+    EXPECT_TRUE(indx.remove_entry("entry0"));
+    EXPECT_TRUE(indx.remove_entry("entry3"));
+    EXPECT_EQ(indx.get_entries_number(), 0);
+    EXPECT_EQ(get_entries(indx, one_id), (std::vector<std::uint32_t>{}));
+    EXPECT_EQ(indx.get_categories_number(), 3);
+}
+
+
+TEST(classifier_category_index, save_load)
+{
+    std::filesystem::path index_file_pth = std::filesystem::temp_directory_path() /
+                                           "classifier_category_index_test";
+    std::vector<std::uint32_t> ctgry_ids;
+
+    {
+        classifier::category_index indx;
+        std::uint32_t mark_id = indx.add_category(classifier::category_index::NPOS, "Mark");
+
+        for (std::uint32_t i = 0; i < 10000; ++i)
+        {
+            ctgry_ids = {indx.add_category(mark_id, std::to_string(i % 10))};
+            indx.add_entry("entry" + std::to_string(i), ctgry_ids);
+        }
+
+        ASSERT_TRUE(indx.save(index_file_pth));
+    }
+
+    {
+        classifier::category_index indx;
+        std::uint32_t mark_id;
+        std::uint32_t nine_id;
+
+        EXPECT_FALSE(indx.load(index_file_pth.string() + ".missing"));
+        ASSERT_TRUE(indx.load(index_file_pth));
+        EXPECT_EQ(indx.get_entries_number(), 10000);
+        EXPECT_EQ(indx.get_categories_number(), 11);
+
+        mark_id = indx.find_category(classifier::category_index::NPOS, "Mark");
+        nine_id = indx.find_category(mark_id, "9");
+        ASSERT_NE(nine_id, classifier::category_index::NPOS);
+        EXPECT_EQ(indx.get_category_entries(nine_id).get_cardinality(), 1000);
+        EXPECT_TRUE(indx.get_category_entries(nine_id).contains(indx.find_entry("entry19")));
+        EXPECT_EQ(indx.get_entry_categories(indx.find_entry("entry19"))[0], nine_id);
+    }
+
+    std::filesystem::remove(index_file_pth);
+}
@@ -0,0 +1,101 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/category_list_test.cpp
+ * @brief       category_list unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/category_list.hpp"
+
+
+namespace {
+
+
+std::vector<std::pair<classifier::category_token_types, std::string>> get_tokens(
+        const classifier::category_list& categories
+)
+{
+    std::vector<std::pair<classifier::category_token_types, std::string>> tokns;
+
+    for (auto& x : categories.get_tokens())
+    {
+        tokns.emplace_back(x.tokn_type, std::string(categories.get_text(x)));
+    }
+
+    return tokns;
+}
+
+
+}
+
+
+TEST(classifier_category_list, parse)
+{
+    using classifier::category_token_types;
+
+    classifier::category_list categories;
+
+    ASSERT_TRUE(categories.parse(R"({"Genres": ["Drama", ["Comedy"]], "Mark": 9, "Ratio": 1.5,
+                                     "Seen": true, "Owned": false, "Empty": [],
+                                     "Bad": {"Nested": [1, {"A": 2}]}, "Null": null})"));
+
+    std::vector<std::pair<category_token_types, std::string>> expected_tokns = {
+            {category_token_types::KEY, "Genres"},
+            {category_token_types::NAME, "Drama"},
+            {category_token_types::NAME, "Comedy"},
+            {category_token_types::KEY, "Mark"},
+            {category_token_types::NAME, "9"},
+            {category_token_types::KEY, "Ratio"},
+            {category_token_types::NAME, "1.5"},
+            {category_token_types::KEY, "Seen"},
+            {category_token_types::TRUE_VALUE, ""},
+            {category_token_types::KEY, "Owned"},
+            {category_token_types::FALSE_VALUE, ""},
+            {category_token_types::KEY, "Empty"},
+            {category_token_types::KEY, "Bad"},
+            {category_token_types::INVALID, ""},
+            {category_token_types::KEY, "Null"},
+            {category_token_types::INVALID, ""},
+    };
+
+    EXPECT_EQ(get_tokens(categories), expected_tokns);
+}
+
+
+TEST(classifier_category_list, parse_invalid)
+{
+    classifier::category_list categories;
+
+    EXPECT_FALSE(categories.parse(R"({"Genres": [)"));
+    EXPECT_TRUE(categories.get_tokens().empty());
+    EXPECT_FALSE(categories.parse(R"(["Drama"])"));
+    EXPECT_FALSE(categories.parse(R"("Drama")"));
+    EXPECT_FALSE(categories.parse(""));
+    EXPECT_TRUE(categories.parse("{}"));
+    EXPECT_TRUE(categories.get_tokens().empty());
+}
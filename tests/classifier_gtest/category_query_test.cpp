@@ -0,0 +1,135 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/**
+ * @file        classifier_gtest/category_query_test.cpp
+ * @brief       category_query unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/category_index.hpp"
+#include "classifier/category_query.hpp"
+
+
+namespace {
+
+
+/*
+ * The entries of the index:
+ *   0: Genres Drama, Mark 8,   Status Ongoing
+ *   1: Genres Drama, Mark 9.5, Status Ended, Seen
+ *   2: Genres Comedy, Mark 10
+ *   3: Genres Drama Comedy, Mark 7, Status "On hold"
+ */
+void build_index(classifier::category_index* indx)
+{
+    constexpr std::uint32_t npos = classifier::category_index::NPOS;
+    std::uint32_t genres_id = indx->add_category(npos, "Genres");
+    std::uint32_t mark_id = indx->add_category(npos, "Mark");
+    std::uint32_t status_id = indx->add_category(npos, "Status");
+    std::uint32_t seen_id = indx->add_category(npos, "Seen");
+    std::uint32_t drama_id = indx->add_category(genres_id, "Drama");
+    std::uint32_t comedy_id = indx->add_category(genres_id, "Comedy");
+    std::vector<std::uint32_t> ctgry_ids;
+
+    ctgry_ids = {drama_id, indx->add_category(mark_id, "8"),
+                 indx->add_category(status_id, "Ongoing")};
+    indx->add_entry("a", ctgry_ids);
+    ctgry_ids = {drama_id, indx->add_category(mark_id, "9.5"),
+                 indx->add_category(status_id, "Ended"), seen_id};
+    indx->add_entry("b", ctgry_ids);
+    ctgry_ids = {comedy_id, indx->add_category(mark_id, "10")};
+    indx->add_entry("c", ctgry_ids);
+    ctgry_ids = {drama_id, comedy_id, indx->add_category(mark_id, "7"),
+                 indx->add_category(status_id, "On hold")};
+    indx->add_entry("d", ctgry_ids);
+}
+
+
+std::vector<std::uint32_t> evaluate(const classifier::category_index& indx, std::string_view expr)
+{
+    classifier::category_query qury;
+    std::vector<std::uint32_t> entry_ids;
+
+    EXPECT_TRUE(qury.parse(expr)) << expr;
+    qury.evaluate(indx).for_each([&](std::uint32_t entry_id)
+    {
+        entry_ids.push_back(entry_id);
+    });
+
+    return entry_ids;
+}
+
+
+}
+
+
+TEST(classifier_category_query, parse)
+{
+    classifier::category_query qury;
+
+    EXPECT_TRUE(qury.is_empty());
+    EXPECT_TRUE(qury.parse("Genres=Drama AND (Mark>=8 OR NOT \"Status\"=\"On hold\")"));
+    EXPECT_FALSE(qury.is_empty());
+
+    EXPECT_FALSE(qury.parse(""));
+    EXPECT_TRUE(qury.is_empty());
+    EXPECT_FALSE(qury.parse("Genres="));
+    EXPECT_FALSE(qury.parse("Genres=Drama AND"));
+    EXPECT_FALSE(qury.parse("(Genres=Drama"));
+    EXPECT_FALSE(qury.parse("Genres=Drama)"));
+    EXPECT_FALSE(qury.parse("Genres!Drama"));
+    EXPECT_FALSE(qury.parse("Status=\"On hold"));
+    EXPECT_FALSE(qury.parse("Genres Drama"));
+}
+
+
+TEST(classifier_category_query, evaluate)
+{
+    classifier::category_index indx;
+
+    build_index(&indx);
+
+    EXPECT_EQ(evaluate(indx, "Genres=Drama"), (std::vector<std::uint32_t>{0, 1, 3}));
+    EXPECT_EQ(evaluate(indx, "Genres=Drama AND Mark>=8 AND NOT Status=Ongoing"),
+              (std::vector<std::uint32_t>{1}));
+    EXPECT_EQ(evaluate(indx, "Mark>8"), (std::vector<std::uint32_t>{1, 2}));
+    EXPECT_EQ(evaluate(indx, "Mark<=8"), (std::vector<std::uint32_t>{0, 3}));
+    EXPECT_EQ(evaluate(indx, "Mark<9.5 OR Genres=Comedy"), (std::vector<std::uint32_t>{0, 2, 3}));
+    EXPECT_EQ(evaluate(indx, "Status"), (std::vector<std::uint32_t>{0, 1, 3}));
+    EXPECT_EQ(evaluate(indx, "Status!=Ended"), (std::vector<std::uint32_t>{0, 3}));
+    EXPECT_EQ(evaluate(indx, "Status=\"On hold\""), (std::vector<std::uint32_t>{3}));
+    EXPECT_EQ(evaluate(indx, "Seen=true"), (std::vector<std::uint32_t>{1}));
+    EXPECT_EQ(evaluate(indx, "NOT Seen"), (std::vector<std::uint32_t>{0, 2, 3}));
+    EXPECT_EQ(evaluate(indx, "NOT Status AND NOT Seen"), (std::vector<std::uint32_t>{2}));
+    EXPECT_EQ(evaluate(indx, "NOT (Genres=Drama OR Genres=Comedy)"),
+              (std::vector<std::uint32_t>{}));
+    EXPECT_EQ(evaluate(indx, "Genres=Western"), (std::vector<std::uint32_t>{}));
+    EXPECT_EQ(evaluate(indx, "Country=France OR Genres=Comedy"),
+              (std::vector<std::uint32_t>{2, 3}));
+}
@@ -0,0 +1,258 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier_gtest/daemon_server_test.cpp
+ * @brief       daemon_server unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#if defined(__linux__)
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/category_index.hpp"
+#include "classifier/daemon_server.hpp"
+
+
+namespace {
+
+
+int connect_to(const std::filesystem::path& socket_pth)
+{
+    sockaddr_un addr = {};
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_pth.c_str(), sizeof(addr.sun_path) - 1);
+
+    if (fd >= 0 && ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0)
+    {
+        ::close(fd);
+        fd = -1;
+    }
+
+    return fd;
+}
+
+
+void send_request(int fd, const std::string& reqst)
+{
+    ASSERT_EQ(::send(fd, reqst.data(), reqst.size(), MSG_NOSIGNAL),
+              static_cast<ssize_t>(reqst.size()));
+}
+
+
+std::string receive_line(int fd)
+{
+    std::string lne;
+    char chr;
+
+    while (::recv(fd, &chr, 1, 0) == 1 && chr != '\n')
+    {
+        lne += chr;
+    }
+
+    return lne;
+}
+
+
+std::shared_ptr<const classifier::daemon_snapshot> make_snapshot(
+        const std::filesystem::path& index_file_pth,
+        std::uint64_t applied_nbr
+)
+{
+    auto snap = std::make_shared<classifier::daemon_snapshot>();
+
+    snap->indx.open(index_file_pth);
+    snap->updates_nbr = applied_nbr;
+    snap->applied_nbr = applied_nbr;
+
+    return snap;
+}
+
+
+}
+
+
+TEST(classifier_daemon_server, run)
+{
+    std::filesystem::path tmp_pth = std::filesystem::temp_directory_path();
+    std::filesystem::path index_file_pth = tmp_pth / "classifier_daemon_server_test.index";
+    std::filesystem::path socket_pth = tmp_pth / "classifier_daemon_server_test.socket";
+    std::vector<std::filesystem::path> posted_pths;
+    std::thread server_thrd;
+    int fd;
+
+    {
+        classifier::category_index indx;
+        std::uint32_t genres_id = indx.add_category(classifier::category_index::NPOS, "Genres");
+        std::vector<std::uint32_t> ctgry_ids = {indx.add_category(genres_id, "Drama")};
+
+        indx.add_entry("/source/a", ctgry_ids);
+        indx.add_entry("/source/b", ctgry_ids);
+        indx.add_entry("/source/c", {});
+        ASSERT_TRUE(indx.save(index_file_pth));
+    }
+
+    classifier::daemon_server servr([&](const std::filesystem::path& entry_pth,
+                                        std::uint64_t* posted_nbr)
+    {
+        if (entry_pth.parent_path() != "/source")
+        {
+            return false;
+        }
+
+        posted_pths.push_back(entry_pth);
+        *posted_nbr = posted_pths.size();
+
+        return true;
+    });
+
+    ASSERT_TRUE(servr.open(socket_pth));
+    servr.publish(make_snapshot(index_file_pth, 0));
+    server_thrd = std::thread([&]()
+    {
+        EXPECT_TRUE(servr.run());
+    });
+
+    // The socket of a running daemon is not taken over.
+    {
+        classifier::daemon_server other_servr([](const std::filesystem::path&, std::uint64_t*)
+        {
+            return false;
+        });
+
+        EXPECT_FALSE(other_servr.open(socket_pth));
+    }
+
+    fd = connect_to(socket_pth);
+    ASSERT_GE(fd, 0);
+
+    // Pipelined requests are answered in order, the same query twice included.
+    send_request(fd, "QUERY Genres=Drama\nQUERY Genres=Drama\r\nQUERY Genres=\nPING\n");
+    EXPECT_EQ(receive_line(fd), "OK 2");
+    EXPECT_EQ(receive_line(fd), "/source/a");
+    EXPECT_EQ(receive_line(fd), "/source/b");
+    EXPECT_EQ(receive_line(fd), "OK 2");
+    EXPECT_EQ(receive_line(fd), "/source/a");
+    EXPECT_EQ(receive_line(fd), "/source/b");
+    EXPECT_EQ(receive_line(fd), "ERROR Invalid query expression");
+    EXPECT_EQ(receive_line(fd), "ERROR Unknown request");
+
+    send_request(fd, "RECLASSIFY /elsewhere/c\n");
+    EXPECT_EQ(receive_line(fd), "ERROR Not an entry of the source directory");
+
+    // A reclassification is answered once an update applies it, and the requests that follow it
+    // wait for that update.
+    send_request(fd, "RECLASSIFY /source/c\nSTATS\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    servr.publish(make_snapshot(index_file_pth, 1));
+
+    EXPECT_EQ(receive_line(fd), "OK 0");
+    EXPECT_EQ(receive_line(fd), "OK 7");
+    EXPECT_EQ(receive_line(fd), "entries 3");
+    EXPECT_EQ(receive_line(fd), "categories 2");
+    EXPECT_EQ(receive_line(fd), "updates 1");
+    EXPECT_EQ(receive_line(fd), "update_duration_ms 0");
+    EXPECT_EQ(receive_line(fd), "clients 1");
+    EXPECT_EQ(receive_line(fd), "requests 7");
+    EXPECT_NE(receive_line(fd).find("batches "), std::string::npos);
+    EXPECT_EQ(posted_pths, (std::vector<std::filesystem::path>{"/source/c"}));
+
+    // A client that does not read its answers is not read either, past the answers kept for it,
+    // and it is answered in full once it reads them.
+    {
+        const std::string reqst = "QUERY Genres=Drama\n";
+        const std::string answr = "OK 2\n/source/a\n/source/b\n";
+        std::string reqsts;
+        std::size_t sent_sz = 0;
+        std::size_t received_sz = 0;
+        ssize_t sz;
+        char buf[16 * 1024];
+        int pipelining_fd = connect_to(socket_pth);
+
+        ASSERT_GE(pipelining_fd, 0);
+
+        for (std::size_t i = 0; i < 1024; ++i)
+        {
+            reqsts += reqst;
+        }
+
+        // The server is given some time to catch up before it is deemed to have stopped reading.
+        for (std::size_t retries_nbr = 0;
+             retries_nbr < 20 && sent_sz < 16 * classifier::daemon_server::MAX_OUTPUT_SIZE;)
+        {
+            sz = ::send(pipelining_fd, reqsts.data(), reqsts.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+            if (sz > 0)
+            {
+                sent_sz += static_cast<std::size_t>(sz);
+                retries_nbr = 0;
+                continue;
+            }
+
+            ASSERT_EQ(errno, EAGAIN);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            ++retries_nbr;
+        }
+
+        EXPECT_LT(sent_sz, 16 * classifier::daemon_server::MAX_OUTPUT_SIZE);
+
+        std::thread reader_thrd([&]()
+        {
+            while ((sz = ::recv(pipelining_fd, buf, sizeof(buf), 0)) > 0)
+            {
+                received_sz += static_cast<std::size_t>(sz);
+            }
+        });
+
+        send_request(pipelining_fd, reqst.substr(sent_sz % reqst.size()));
+        ::shutdown(pipelining_fd, SHUT_WR);
+        reader_thrd.join();
+        ::close(pipelining_fd);
+
+        EXPECT_EQ(received_sz, (sent_sz / reqst.size() + 1) * answr.size());
+    }
+
+    // A client that stops sending is answered before being disconnected.
+    ::shutdown(fd, SHUT_WR);
+    EXPECT_EQ(receive_line(fd), "");
+    ::close(fd);
+
+    servr.stop();
+    server_thrd.join();
+    servr.close();
+
+    EXPECT_FALSE(std::filesystem::exists(socket_pth));
+    std::filesystem::remove(index_file_pth);
+}
+
+#endif
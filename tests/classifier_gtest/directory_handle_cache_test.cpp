@@ -0,0 +1,73 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/directory_handle_cache_test.cpp
+ * @brief       directory_handle_cache unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#if !defined(_WIN32)
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "classifier/directory_handle_cache.hpp"
+#include "classifier/file_id.hpp"
+
+
+TEST(classifier_directory_handle_cache, get_handle)
+{
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_directory_handle_cache_test";
+    classifier::directory_handle_cache dir_handle_cche(2);
+    struct stat st;
+    int fd;
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(root_pth / "Genres" / "Drama");
+    std::filesystem::create_directories(root_pth / "Years" / "1999");
+    dir_handle_cche.set_root(root_pth);
+
+    fd = dir_handle_cche.get_handle(root_pth / "Genres" / "Drama");
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(dir_handle_cche.get_handle(root_pth / "Genres" / "Drama"), fd);
+    ASSERT_EQ(::mkdirat(fd, "Entry", 0777), 0);
+    EXPECT_TRUE(std::filesystem::is_directory(root_pth / "Genres" / "Drama" / "Entry"));
+
+    // The capacity is exceeded, the least recently used handles are closed.
+    fd = dir_handle_cche.get_handle(root_pth / "Years" / "1999");
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::fstat(fd, &st), 0);
+    EXPECT_EQ(st.st_ino, classifier::get_file_id(root_pth / "Years" / "1999").ino);
+    EXPECT_GE(dir_handle_cche.get_handle(root_pth / "Genres" / "Drama" / "Entry"), 0);
+
+    dir_handle_cche.forget(root_pth / "Genres" / "Drama" / "Entry");
+    std::filesystem::remove(root_pth / "Genres" / "Drama" / "Entry");
+    EXPECT_LT(dir_handle_cche.get_handle(root_pth / "Genres" / "Drama" / "Entry"), 0);
+    EXPECT_LT(dir_handle_cche.get_handle(root_pth / "Missing"), 0);
+
+    std::filesystem::remove_all(root_pth);
+}
+
+#endif
@@ -0,0 +1,117 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/directory_scanner_test.cpp
+ * @brief       directory_scanner unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+
+#include <gtest/gtest.h>
+
+#include "classifier/directory_scanner.hpp"
+
+
+TEST(classifier_directory_scanner, scan)
+{
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_directory_scanner_test";
+    std::vector<std::filesystem::path> expected_pths;
+    std::vector<std::filesystem::path> found_pths;
+    std::mutex found_pths_mtx;
+
+    std::filesystem::remove_all(root_pth);
+    for (int i = 0; i < 50; ++i)
+    {
+        std::filesystem::path entry_pth = root_pth / ("a" + std::to_string(i % 5)) /
+                                          ("entry" + std::to_string(i));
+        std::filesystem::create_directories(entry_pth);
+        std::ofstream(entry_pth / "other.json") << "{}";
+
+        if (i % 3 != 0)
+        {
+            std::ofstream(entry_pth / ".categories.json") << "{}";
+            expected_pths.push_back(entry_pth / ".categories.json");
+        }
+    }
+
+    for (std::size_t jobs_nbr : {1, 4})
+    {
+        classifier::directory_scanner scannr(root_pth, ".categories.json", jobs_nbr);
+
+        found_pths.clear();
+        scannr.scan([&](std::filesystem::path&& pth)
+        {
+            std::lock_guard<std::mutex> lock(found_pths_mtx);
+            found_pths.push_back(std::move(pth));
+        });
+
+        std::sort(expected_pths.begin(), expected_pths.end());
+        std::sort(found_pths.begin(), found_pths.end());
+        EXPECT_EQ(scannr.get_jobs_number(), jobs_nbr);
+        EXPECT_EQ(found_pths, expected_pths);
+    }
+
+    std::filesystem::remove_all(root_pth);
+}
+
+
+TEST(classifier_directory_scanner, symbolic_links)
+{
+    std::filesystem::path tmp_pth = std::filesystem::temp_directory_path() /
+                                    "classifier_directory_scanner_links_test";
+    std::filesystem::path root_pth = tmp_pth / "root";
+    std::filesystem::path outside_pth = tmp_pth / "outside";
+    std::vector<std::filesystem::path> found_pths;
+    std::mutex found_pths_mtx;
+
+    std::filesystem::remove_all(tmp_pth);
+    std::filesystem::create_directories(root_pth / "entry");
+    std::filesystem::create_directories(outside_pth / "linked");
+    std::ofstream(root_pth / "entry" / ".categories.json") << "{}";
+    std::ofstream(outside_pth / "linked" / ".categories.json") << "{}";
+
+    // The link out of the tree is followed once, the links into the tree, to the root and back to
+    // the linked directory are not.
+    std::filesystem::create_directory_symlink(outside_pth, root_pth / "outside");
+    std::filesystem::create_directory_symlink(outside_pth, root_pth / "outside_again");
+    std::filesystem::create_directory_symlink(root_pth / "entry", root_pth / "entry_link");
+    std::filesystem::create_directory_symlink(tmp_pth, root_pth / "parent");
+    std::filesystem::create_directory_symlink(outside_pth, outside_pth / "linked" / "cycle");
+
+    classifier::directory_scanner scannr(root_pth, ".categories.json", 2);
+    scannr.scan([&](std::filesystem::path&& pth)
+    {
+        std::lock_guard<std::mutex> lock(found_pths_mtx);
+        found_pths.push_back(pth.lexically_relative(root_pth));
+    });
+
+    std::sort(found_pths.begin(), found_pths.end());
+    ASSERT_EQ(found_pths.size(), 2u);
+    EXPECT_EQ(found_pths[0], std::filesystem::path("entry") / ".categories.json");
+    EXPECT_EQ(found_pths[1].filename(), ".categories.json");
+    EXPECT_NE(found_pths[1].native().find("linked"), std::string::npos);
+
+    std::filesystem::remove_all(tmp_pth);
+}
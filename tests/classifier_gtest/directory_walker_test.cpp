@@ -0,0 +1,69 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/directory_walker_test.cpp
+ * @brief       directory_walker unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <fstream>
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include "classifier/directory_walker.hpp"
+
+
+TEST(classifier_directory_walker, walk)
+{
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_directory_walker_test";
+    std::map<std::filesystem::path, bool> found_fles;
+    std::vector<std::filesystem::path> found_ordr;
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(root_pth / "Genres" / "Drama");
+    std::ofstream(root_pth / "Genres" / "desktop.ini") << "";
+    std::filesystem::create_directory_symlink(root_pth / "Genres",
+                                              root_pth / "Genres" / "Drama" / "Entry");
+
+    classifier::directory_walker::walk(root_pth, [&](const std::filesystem::path& file_pth,
+                                                     const classifier::file_id& id,
+                                                     bool is_directory)
+    {
+        EXPECT_EQ(id, classifier::get_file_id(file_pth));
+        found_fles[file_pth] = is_directory;
+        found_ordr.push_back(file_pth);
+    });
+
+    std::map<std::filesystem::path, bool> expected_fles = {
+            {root_pth / "Genres", true},
+            {root_pth / "Genres" / "Drama", true},
+            {root_pth / "Genres" / "desktop.ini", false},
+            {root_pth / "Genres" / "Drama" / "Entry", false},
+    };
+
+    EXPECT_EQ(found_fles, expected_fles);
+    ASSERT_EQ(found_ordr.size(), 4u);
+    EXPECT_EQ(found_ordr.front(), root_pth / "Genres");
+
+    std::filesystem::remove_all(root_pth);
+}
@@ -0,0 +1,81 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/file_id_set_test.cpp
+ * @brief       file_id_set unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <set>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "classifier/file_id_set.hpp"
+
+
+TEST(classifier_file_id_set, insert_contains)
+{
+    classifier::file_id_set id_st;
+
+    EXPECT_FALSE(id_st.contains({1, 2}));
+    EXPECT_TRUE(id_st.insert({1, 2}));
+    EXPECT_FALSE(id_st.insert({1, 2}));
+    EXPECT_TRUE(id_st.contains({1, 2}));
+
+    // Same inode number on another device.
+    EXPECT_FALSE(id_st.contains({3, 2}));
+    EXPECT_TRUE(id_st.insert({3, 2}));
+
+    EXPECT_FALSE(id_st.contains({0, 0}));
+    EXPECT_TRUE(id_st.insert({0, 0}));
+    EXPECT_TRUE(id_st.contains({0, 0}));
+    EXPECT_EQ(id_st.size(), 3u);
+
+    id_st.clear();
+    EXPECT_EQ(id_st.size(), 0u);
+    EXPECT_FALSE(id_st.contains({1, 2}));
+}
+
+
+TEST(classifier_file_id_set, matches_std_set)
+{
+    classifier::file_id_set id_st;
+    std::set<std::pair<std::uint64_t, std::uint64_t>> ref_st;
+    std::mt19937_64 rnd(42);
+
+    id_st.reserve(1000);
+    for (int i = 0; i < 50000; ++i)
+    {
+        classifier::file_id id = {rnd() % 4, rnd() % 20000};
+
+        EXPECT_EQ(id_st.insert(id), ref_st.insert({id.dev, id.ino}).second);
+    }
+
+    EXPECT_EQ(id_st.size(), ref_st.size());
+    for (std::uint64_t dev = 0; dev < 4; ++dev)
+    {
+        for (std::uint64_t ino = 0; ino < 20000; ino += 7)
+        {
+            EXPECT_EQ(id_st.contains({dev, ino}), ref_st.contains({dev, ino}));
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/file_operation_ring_test.cpp
+ * @brief       file_operation_ring unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#if defined(__linux__)
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/file_operation_ring.hpp"
+
+
+TEST(classifier_file_operation_ring, push_flush)
+{
+    using classifier::file_operation_types;
+
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_file_operation_ring_test";
+    classifier::directory_handle_cache dir_handle_cche(4);
+    classifier::file_operation_ring file_op_rng(&dir_handle_cche);
+    std::vector<std::size_t> completed_tgs;
+    std::vector<bool> completed_succsss;
+    std::vector<classifier::file_id> completed_ids;
+
+    auto complete_operation = [&](std::size_t tag, bool succss, const classifier::file_id& id)
+    {
+        completed_tgs.push_back(tag);
+        completed_succsss.push_back(succss);
+        completed_ids.push_back(id);
+    };
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(root_pth / "Extra");
+    dir_handle_cche.set_root(root_pth);
+
+    if (!file_op_rng.open(4))
+    {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+
+    // The link depends on the directory of the same batch, the batch is submitted before it.
+    file_op_rng.push(file_operation_types::MKDIR, root_pth / "Genres", {}, {}, 0,
+                     complete_operation);
+    file_op_rng.push(file_operation_types::MKDIR, root_pth / "Genres" / "Drama", {}, {}, 1,
+                     complete_operation);
+    file_op_rng.push(file_operation_types::SYMLINK, root_pth / "Genres" / "Drama" / "Entry",
+                     root_pth / "Extra", {}, 2, complete_operation);
+    file_op_rng.push(file_operation_types::RMDIR, root_pth / "Extra", {}, {}, 3,
+                     complete_operation);
+    file_op_rng.push(file_operation_types::MKDIR, root_pth / "Genres", {}, {}, 4,
+                     complete_operation);
+    file_op_rng.push(file_operation_types::UNLINK, root_pth / "Missing", {}, {}, 5,
+                     complete_operation);
+    file_op_rng.flush(complete_operation);
+
+    ASSERT_EQ(completed_tgs, (std::vector<std::size_t>{0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(completed_succsss, (std::vector<bool>{true, true, true, true, true, false}));
+    EXPECT_EQ(completed_ids[0], classifier::get_file_id(root_pth / "Genres"));
+    EXPECT_EQ(completed_ids[1], classifier::get_file_id(root_pth / "Genres" / "Drama"));
+    EXPECT_EQ(completed_ids[2], classifier::get_file_id(root_pth / "Genres" / "Drama" / "Entry"));
+    EXPECT_EQ(completed_ids[4], completed_ids[0]);
+    EXPECT_TRUE(std::filesystem::is_symlink(root_pth / "Genres" / "Drama" / "Entry"));
+    EXPECT_FALSE(std::filesystem::exists(root_pth / "Extra"));
+
+    // A moved link replaces the previous one, which may already be gone.
+    completed_tgs.clear();
+    completed_succsss.clear();
+    completed_ids.clear();
+    file_op_rng.push(file_operation_types::RELINK, root_pth / "Genres" / "Drama" / "Renamed",
+                     root_pth / "Renamed", root_pth / "Genres" / "Drama" / "Entry", 6,
+                     complete_operation);
+    file_op_rng.push(file_operation_types::RELINK, root_pth / "Genres" / "Other",
+                     root_pth / "Other", root_pth / "Genres" / "Missing", 7, complete_operation);
+    file_op_rng.flush(complete_operation);
+
+    // A moved link fails when the file it replaces cannot be removed.
+    std::filesystem::create_directories(root_pth / "Genres" / "Blocker" / "Content");
+    file_op_rng.push(file_operation_types::RELINK, root_pth / "Genres" / "Blocked",
+                     root_pth / "Blocked", root_pth / "Genres" / "Blocker", 8, complete_operation);
+    file_op_rng.flush(complete_operation);
+
+    ASSERT_EQ(completed_tgs, (std::vector<std::size_t>{6, 7, 8}));
+    EXPECT_EQ(completed_succsss, (std::vector<bool>{true, true, false}));
+    EXPECT_EQ(completed_ids[0],
+              classifier::get_file_id(root_pth / "Genres" / "Drama" / "Renamed"));
+    EXPECT_FALSE(std::filesystem::exists(
+            std::filesystem::symlink_status(root_pth / "Genres" / "Drama" / "Entry")));
+    EXPECT_EQ(std::filesystem::read_symlink(root_pth / "Genres" / "Drama" / "Renamed"),
+              root_pth / "Renamed");
+
+    std::filesystem::remove_all(root_pth);
+}
+
+#endif
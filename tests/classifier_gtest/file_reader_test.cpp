@@ -0,0 +1,102 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/file_reader_test.cpp
+ * @brief       file_reader unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include "classifier/file_reader.hpp"
+
+
+TEST(classifier_file_reader, read)
+{
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_file_reader_test";
+    std::string small_contnt = R"({"Genres":["Drama"],"Mark":9})";
+    std::string large_contnt(classifier::file_reader::MMAP_THRESHOLD + 123, 'x');
+    classifier::file_reader file_readr;
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(root_pth);
+    std::ofstream(root_pth / "small", std::ios::binary) << small_contnt;
+    std::ofstream(root_pth / "large", std::ios::binary) << large_contnt;
+
+    ASSERT_TRUE(file_readr.read(root_pth / "small", small_contnt.size()));
+    EXPECT_EQ(file_readr.get_content(), small_contnt);
+
+    // A wrong size hint only costs more calls.
+    ASSERT_TRUE(file_readr.read(root_pth / "small", 2));
+    EXPECT_EQ(file_readr.get_content(), small_contnt);
+
+    ASSERT_TRUE(file_readr.read(root_pth / "large", large_contnt.size()));
+    EXPECT_EQ(file_readr.get_content(), large_contnt);
+
+    ASSERT_TRUE(file_readr.read(root_pth / "small", large_contnt.size()));
+    EXPECT_EQ(file_readr.get_content(), small_contnt);
+
+    EXPECT_FALSE(file_readr.read(root_pth / "missing", 0));
+    EXPECT_TRUE(file_readr.get_content().empty());
+
+    std::filesystem::remove_all(root_pth);
+}
+
+
+#if !defined(_WIN32)
+TEST(classifier_file_reader, short_reads)
+{
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_file_reader_short_reads_test";
+    classifier::file_reader file_readr;
+    std::thread writer_thrd;
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(root_pth);
+    ASSERT_EQ(::mkfifo((root_pth / "fifo").c_str(), 0600), 0);
+
+    // The content arrives in two parts, the first read returns less than was asked and the
+    // reading goes on until the end of the file.
+    writer_thrd = std::thread([&]()
+    {
+        std::ofstream ofs(root_pth / "fifo", std::ios::binary);
+        ofs << R"({"Genres":)" << std::flush;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ofs << R"(["Drama"]})";
+    });
+
+    EXPECT_TRUE(file_readr.read(root_pth / "fifo", 64));
+    writer_thrd.join();
+    EXPECT_EQ(file_readr.get_content(), R"({"Genres":["Drama"]})");
+
+    std::filesystem::remove_all(root_pth);
+}
+#endif
@@ -0,0 +1,241 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/flat_json_parser_test.cpp
+ * @brief       flat_json_parser unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/flat_json_parser.hpp"
+#include "classifier/json.hpp"
+
+
+namespace {
+
+
+using token_list = std::vector<std::pair<classifier::category_token_types, std::string>>;
+
+
+token_list get_tokens(const classifier::category_list& categories)
+{
+    token_list tokns;
+
+    for (auto& x : categories.get_tokens())
+    {
+        tokns.emplace_back(x.tokn_type, std::string(categories.get_text(x)));
+    }
+
+    return tokns;
+}
+
+
+void add_expected_tokens(const nlohmann::ordered_json& val, token_list* tokns)
+{
+    using classifier::category_token_types;
+
+    if (val.is_array())
+    {
+        for (auto& x : val)
+        {
+            add_expected_tokens(x, tokns);
+        }
+    }
+    else if (val.is_boolean())
+    {
+        tokns->emplace_back(val.get<bool>() ? category_token_types::TRUE_VALUE :
+                                              category_token_types::FALSE_VALUE, "");
+    }
+    else if (val.is_string())
+    {
+        tokns->emplace_back(category_token_types::NAME, val.get<std::string>());
+    }
+    else
+    {
+        tokns->emplace_back(category_token_types::NAME, val.dump());
+    }
+}
+
+
+std::string make_name(std::mt19937_64& rnd)
+{
+    static const char* const parts[] = {"Drama", "Science Fiction", "é", "日本", "x", "1999",
+                                        "A very long category name that spans several blocks "};
+    std::string nme;
+
+    for (std::size_t i = 0, n = rnd() % 4; i < n; ++i)
+    {
+        nme += parts[rnd() % std::size(parts)];
+    }
+
+    return nme;
+}
+
+
+std::string make_value(std::mt19937_64& rnd, std::size_t depth)
+{
+    static const char* const spaces[] = {"", " ", "\n    ", "\t"};
+    std::string val;
+
+    switch (rnd() % (depth < 2 ? 5 : 4))
+    {
+        case 0:
+            return "\"" + make_name(rnd) + "\"";
+
+        case 1:
+            return std::to_string(static_cast<std::int64_t>(rnd() % 2000000) - 1000000);
+
+        case 2:
+            return rnd() % 2 ? "true" : "false";
+
+        case 3:
+            return "0";
+
+        default:
+            val = "[";
+            for (std::size_t i = 0, n = rnd() % 4; i < n; ++i)
+            {
+                val += (i > 0 ? "," : "") + std::string(spaces[rnd() % 4]) +
+                       make_value(rnd, depth + 1);
+            }
+
+            return val + spaces[rnd() % 4] + "]";
+    }
+}
+
+
+}
+
+
+TEST(classifier_flat_json_parser, parse)
+{
+    using classifier::category_token_types;
+
+    classifier::flat_json_parser flat_json_parsr;
+    classifier::category_list categories;
+
+    ASSERT_TRUE(flat_json_parsr.parse(R"( {"Genres": ["Drama", ["Comedy"], []], "Mark": -9,
+                                          "Seen": true, "Owned" :false, "": 0} )", &categories));
+
+    token_list expected_tokns = {
+            {category_token_types::KEY, "Genres"},
+            {category_token_types::NAME, "Drama"},
+            {category_token_types::NAME, "Comedy"},
+            {category_token_types::KEY, "Mark"},
+            {category_token_types::NAME, "-9"},
+            {category_token_types::KEY, "Seen"},
+            {category_token_types::TRUE_VALUE, ""},
+            {category_token_types::KEY, "Owned"},
+            {category_token_types::FALSE_VALUE, ""},
+            {category_token_types::KEY, ""},
+            {category_token_types::NAME, "0"},
+    };
+
+    EXPECT_EQ(get_tokens(categories), expected_tokns);
+
+    categories.clear();
+    EXPECT_TRUE(flat_json_parsr.parse("{}", &categories));
+    EXPECT_TRUE(categories.get_tokens().empty());
+}
+
+
+TEST(classifier_flat_json_parser, parse_refused)
+{
+    const char* const refused_docs[] = {
+            R"({"Genres": "Dra\"ma"})",
+            R"({"Ratio": 1.5})",
+            R"({"Ratio": 1e3})",
+            R"({"Mark": -0})",
+            R"({"Mark": 007})",
+            R"({"Mark": 12345678901234567890})",
+            R"({"Null": null})",
+            R"({"Nested": {"A": 1}})",
+            R"({"Genres": ["Drama",]})",
+            R"({"Genres": "Drama",})",
+            R"({"Genres": "Drama"} x)",
+            R"({"Genres": tru})",
+            R"({"Genres": truex})",
+            R"({"Genres" "Drama"})",
+            R"({"Genres": "Dra)",
+            R"(["Drama"])",
+            "{\"Genres\": \"Dr\x01ma\"}",
+            "{\"Genres\": \"Dr\xc3ma\"}",
+            "{\"Genres\": \"\xed\xa0\x80\"}",
+            "",
+    };
+
+    for (auto simd_lvl : {classifier::simd_levels::SCALAR, classifier::simd_levels::SSE42})
+    {
+        classifier::flat_json_parser flat_json_parsr(simd_lvl);
+        classifier::category_list categories;
+
+        for (auto& x : refused_docs)
+        {
+            EXPECT_FALSE(flat_json_parsr.parse(x, &categories)) << x;
+            categories.clear();
+        }
+    }
+}
+
+
+TEST(classifier_flat_json_parser, matches_json)
+{
+    std::mt19937_64 rnd(11);
+    std::string doc;
+    nlohmann::ordered_json expected_json;
+    token_list expected_tokns;
+
+    for (std::size_t i = 0; i < 2000; ++i)
+    {
+        doc = rnd() % 2 ? "{" : " {\n";
+        for (std::size_t j = 0, n = rnd() % 8; j < n; ++j)
+        {
+            // The keys are unique, a document keeps only the last value of a duplicated key.
+            doc += (j > 0 ? ",\n  \"" : "\"") + make_name(rnd) + std::to_string(j) + "\":" +
+                   make_value(rnd, 0);
+        }
+
+        doc += "}";
+
+        expected_json = nlohmann::ordered_json::parse(doc);
+        expected_tokns.clear();
+        for (auto& [key, val] : expected_json.items())
+        {
+            expected_tokns.emplace_back(classifier::category_token_types::KEY, key);
+            add_expected_tokens(val, &expected_tokns);
+        }
+
+        for (auto simd_lvl : {classifier::simd_levels::SCALAR, classifier::simd_levels::SSE42})
+        {
+            classifier::flat_json_parser flat_json_parsr(simd_lvl);
+            classifier::category_list categories;
+
+            ASSERT_TRUE(flat_json_parsr.parse(doc, &categories)) << doc;
+            ASSERT_EQ(get_tokens(categories), expected_tokns) << doc;
+        }
+    }
+}
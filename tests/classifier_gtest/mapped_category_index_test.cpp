@@ -0,0 +1,147 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier_gtest/mapped_category_index_test.cpp
+ * @brief       mapped_category_index unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/category_index.hpp"
+#include "classifier/category_query.hpp"
+#include "classifier/mapped_category_index.hpp"
+
+
+namespace {
+
+
+std::vector<std::uint32_t> evaluate(const classifier::mapped_category_index& indx,
+                                    std::string_view expr)
+{
+    classifier::category_query qury;
+    std::vector<std::uint32_t> entry_ids;
+
+    EXPECT_TRUE(qury.parse(expr)) << expr;
+    qury.evaluate(indx).for_each([&](std::uint32_t entry_id)
+    {
+        entry_ids.push_back(entry_id);
+    });
+
+    return entry_ids;
+}
+
+
+}
+
+
+TEST(classifier_mapped_category_index, open_find)
+{
+    constexpr std::uint32_t npos = classifier::category_index::NPOS;
+    std::filesystem::path index_file_pth = std::filesystem::temp_directory_path() /
+                                           "classifier_mapped_category_index_test";
+    std::vector<std::uint32_t> ctgry_ids;
+
+    {
+        classifier::category_index indx;
+        std::uint32_t mark_id = indx.add_category(npos, "Mark");
+        std::uint32_t genres_id = indx.add_category(npos, "Genres");
+        std::uint32_t drama_id = indx.add_category(genres_id, "Drama");
+
+        for (std::uint32_t i = 0; i < 10000; ++i)
+        {
+            ctgry_ids = {indx.add_category(mark_id, std::to_string(i % 10))};
+            if (i % 4 == 0)
+            {
+                ctgry_ids.push_back(drama_id);
+            }
+
+            indx.add_entry("entry" + std::to_string(i), ctgry_ids);
+        }
+
+        ASSERT_TRUE(indx.save(index_file_pth));
+    }
+
+    {
+        classifier::mapped_category_index indx;
+        std::uint32_t mark_id;
+        std::uint32_t nine_id;
+        std::vector<std::uint32_t> entry_ids;
+
+        EXPECT_FALSE(indx.open(index_file_pth.string() + ".missing"));
+        ASSERT_TRUE(indx.open(index_file_pth));
+        EXPECT_EQ(indx.get_entries_number(), 10000);
+        EXPECT_EQ(indx.get_categories_number(), 13);
+
+        mark_id = indx.find_category(npos, "Mark");
+        ASSERT_NE(mark_id, npos);
+        EXPECT_EQ(indx.get_category_name(mark_id), "Mark");
+        EXPECT_EQ(indx.find_category(npos, "9"), npos);
+        EXPECT_EQ(indx.find_category(mark_id, "Drama"), npos);
+
+        nine_id = indx.find_category(mark_id, "9");
+        ASSERT_NE(nine_id, npos);
+        EXPECT_EQ(indx.get_key_category(nine_id), mark_id);
+        EXPECT_EQ(indx.get_category_entries(nine_id).get_cardinality(), 1000);
+        EXPECT_EQ(indx.get_entry_path(19), "entry19");
+
+        entry_ids = evaluate(indx, "Mark=8 AND Genres=Drama");
+        EXPECT_EQ(entry_ids.size(), 500);
+        EXPECT_EQ(indx.get_entry_path(entry_ids.front()), "entry8");
+        EXPECT_EQ(evaluate(indx, "Mark>=9 AND NOT Genres").size(), 1000);
+    }
+
+    std::filesystem::remove(index_file_pth);
+}
+
+
+TEST(classifier_mapped_category_index, open_truncated)
+{
+    std::filesystem::path index_file_pth = std::filesystem::temp_directory_path() /
+                                           "classifier_mapped_category_index_test";
+    std::vector<std::uint32_t> ctgry_ids;
+
+    {
+        classifier::category_index indx;
+        std::uint32_t seen_id = indx.add_category(classifier::category_index::NPOS, "Seen");
+
+        ctgry_ids = {seen_id};
+        indx.add_entry("a", ctgry_ids);
+        ASSERT_TRUE(indx.save(index_file_pth));
+    }
+
+    std::filesystem::resize_file(index_file_pth, std::filesystem::file_size(index_file_pth) - 1);
+
+    {
+        classifier::mapped_category_index indx;
+
+        EXPECT_FALSE(indx.open(index_file_pth));
+        EXPECT_EQ(indx.get_entries_number(), 0);
+        EXPECT_EQ(indx.find_category(classifier::category_index::NPOS, "Seen"),
+                  classifier::category_index::NPOS);
+    }
+
+    std::filesystem::remove(index_file_pth);
+}
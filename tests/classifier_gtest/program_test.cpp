@@ -24,11 +24,125 @@
  * @date        2024/10/15
  */
 
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <streambuf>
+
 #include <gtest/gtest.h>
 
 #include "classifier/program.hpp"
 
 
+namespace {
+
+
+std::atomic<bool> counting_allocs(false);
+
+std::atomic<std::size_t> allocs_nbr(0);
+
+
+class null_buffer : public std::streambuf
+{
+protected:
+    int overflow(int ch) override
+    {
+        return ch;
+    }
+};
+
+
+void make_entries(const std::filesystem::path& source_pth, int first_idx, int last_idx)
+{
+    for (int i = first_idx; i < last_idx; ++i)
+    {
+        std::filesystem::path entry_pth = source_pth / ("entry" + std::to_string(i));
+        std::filesystem::create_directories(entry_pth);
+        std::ofstream(entry_pth / ".categories.json")
+                << R"({"Genres": ["Drama", "Genre)" << i % 7 << R"("], "Mark": )" << i % 10
+                << "}";
+    }
+}
+
+
+void answer_prompts(const std::filesystem::path& answers_pth, const char* answrs)
+{
+    std::ofstream(answers_pth) << answrs;
+    ASSERT_NE(std::freopen(answers_pth.c_str(), "r", stdin), nullptr);
+}
+
+
+int classify(
+        const std::filesystem::path& source_pth,
+        const std::filesystem::path& destination_pth,
+        bool rebuild
+)
+{
+    classifier::program_args prog_args;
+    prog_args.source_dir = source_pth;
+    prog_args.destination_dir = destination_pth;
+    prog_args.jobs_nbr = 1;
+    prog_args.rebuild = rebuild;
+
+    classifier::program prog(std::move(prog_args));
+
+    return prog.execute();
+}
+
+
+std::size_t count_rebuild_allocations(
+        const std::filesystem::path& source_pth,
+        const std::filesystem::path& destination_pth
+)
+{
+    std::size_t nbr;
+
+    classify(source_pth, destination_pth, false);
+
+    allocs_nbr.store(0);
+    counting_allocs.store(true);
+    classify(source_pth, destination_pth, true);
+    counting_allocs.store(false);
+    nbr = allocs_nbr.load();
+
+    return nbr;
+}
+
+
+}
+
+
+void* operator new(std::size_t sz)
+{
+    if (counting_allocs.load(std::memory_order_relaxed))
+    {
+        allocs_nbr.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* ptr = std::malloc(sz > 0 ? sz : 1))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
 TEST(classifier_program, execute)
 {
     int ret = -1;
@@ -39,3 +153,248 @@ TEST(classifier_program, execute)
     EXPECT_NO_THROW(ret = prog.execute());
     EXPECT_TRUE(ret == 0);
 }
+
+
+TEST(classifier_program, steady_state_allocations)
+{
+    constexpr int entries_nbr = 200;
+
+    // Measured at 45 allocations per file when every category list is recycled, the loader never
+    // running ahead, and at 47 when none is, plus about 900 for the rest of a run. How far the
+    // loader runs ahead is up to the scheduler, and the two runs compared can fall at both ends,
+    // which makes at most 49 per file. The budgets leave a clear margin above that.
+    constexpr std::size_t file_allocs_budget = 56;
+    constexpr std::size_t run_allocs_budget = 1000;
+
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_program_test";
+    std::filesystem::path source_pth = root_pth / "source";
+    std::filesystem::path destination_pth = root_pth / "destination";
+    null_buffer null_buf;
+    std::streambuf* cout_buf = std::cout.rdbuf(&null_buf);
+    std::size_t first_allocs_nbr;
+    std::size_t second_allocs_nbr;
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(destination_pth);
+
+    // A rebuild over an up to date destination goes through the scan, the cache, the parse and
+    // the planning of every file, doubling the files must only add a constant cost per file.
+    make_entries(source_pth, 0, entries_nbr);
+    first_allocs_nbr = count_rebuild_allocations(source_pth, destination_pth);
+
+    make_entries(source_pth, entries_nbr, entries_nbr * 2);
+    second_allocs_nbr = count_rebuild_allocations(source_pth, destination_pth);
+
+    std::cout.rdbuf(cout_buf);
+
+    ASSERT_GT(second_allocs_nbr, first_allocs_nbr);
+    EXPECT_LE((second_allocs_nbr - first_allocs_nbr) / entries_nbr, file_allocs_budget);
+    EXPECT_LE(first_allocs_nbr, run_allocs_budget + file_allocs_budget * entries_nbr);
+    EXPECT_LE(second_allocs_nbr, run_allocs_budget + file_allocs_budget * entries_nbr * 2);
+
+    std::filesystem::remove_all(root_pth);
+}
+
+
+TEST(classifier_program, stale_links)
+{
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_program_stale_links_test";
+    std::filesystem::path source_pth = root_pth / "source";
+    std::filesystem::path destination_pth = root_pth / "destination";
+    std::filesystem::path drama_pth = destination_pth / "Genres" / "Drama";
+    null_buffer null_buf;
+    std::streambuf* cout_buf = std::cout.rdbuf(&null_buf);
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(destination_pth);
+
+    make_entries(source_pth, 0, 8);
+    classify(source_pth, destination_pth, false);
+
+    // The links of a deleted entry and the link of a dropped value are removed from the state
+    // alone once confirmed, along with the directory that no entry uses anymore. A recorded path
+    // that holds something else than the link created there is left alone.
+    std::filesystem::remove_all(source_pth / "entry3");
+    std::ofstream(source_pth / "entry4" / ".categories.json") << R"({"Genres": ["Genre4"]})";
+    std::filesystem::remove(drama_pth / "entry3");
+    std::filesystem::create_symlink(source_pth / "entry5", drama_pth / "entry3");
+    answer_prompts(root_pth / "answers", "y\n");
+    classify(source_pth, destination_pth, false);
+
+    std::cout.rdbuf(cout_buf);
+
+    ASSERT_TRUE(std::filesystem::is_symlink(drama_pth / "entry3"));
+    EXPECT_EQ(std::filesystem::read_symlink(drama_pth / "entry3"), source_pth / "entry5");
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::symlink_status(drama_pth / "entry4")));
+    EXPECT_FALSE(std::filesystem::exists(destination_pth / "Mark" / "3"));
+    EXPECT_TRUE(std::filesystem::exists(std::filesystem::symlink_status(drama_pth / "entry5")));
+    EXPECT_TRUE(std::filesystem::exists(
+            std::filesystem::symlink_status(destination_pth / "Genres" / "Genre4" / "entry4")));
+
+    std::filesystem::remove_all(root_pth);
+}
+
+
+TEST(classifier_program, declined_stale_links)
+{
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_program_declined_stale_links_test";
+    std::filesystem::path source_pth = root_pth / "source";
+    std::filesystem::path destination_pth = root_pth / "destination";
+    std::filesystem::path drama_pth = destination_pth / "Genres" / "Drama";
+    null_buffer null_buf;
+    std::streambuf* cout_buf = std::cout.rdbuf(&null_buf);
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(destination_pth);
+
+    make_entries(source_pth, 0, 4);
+    classify(source_pth, destination_pth, false);
+
+    // A stale link whose deletion is declined stays in the state, the next run reports it again.
+    std::ofstream(source_pth / "entry1" / ".categories.json") << R"({"Genres": ["Genre1"]})";
+    answer_prompts(root_pth / "answers", "n\n");
+    classify(source_pth, destination_pth, false);
+
+    EXPECT_TRUE(std::filesystem::is_symlink(drama_pth / "entry1"));
+    EXPECT_TRUE(std::filesystem::is_directory(destination_pth / "Mark" / "1"));
+
+    answer_prompts(root_pth / "answers", "y\n");
+    classify(source_pth, destination_pth, false);
+
+    std::cout.rdbuf(cout_buf);
+
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::symlink_status(drama_pth / "entry1")));
+    EXPECT_FALSE(std::filesystem::exists(destination_pth / "Mark" / "1"));
+    EXPECT_TRUE(std::filesystem::is_symlink(drama_pth / "entry2"));
+
+    std::filesystem::remove_all(root_pth);
+}
+
+
+TEST(classifier_program, failed_entry)
+{
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_program_failed_entry_test";
+    std::filesystem::path source_pth = root_pth / "source";
+    std::filesystem::path destination_pth = root_pth / "destination";
+    null_buffer null_buf;
+    std::streambuf* cout_buf = std::cout.rdbuf(&null_buf);
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(destination_pth);
+
+    // The links planned for an entry before it fails are not created, its directories are left
+    // empty and removed once no entry needs them.
+    make_entries(source_pth, 0, 2);
+    std::filesystem::create_directories(source_pth / "c");
+    std::ofstream(source_pth / "c" / ".categories.json")
+            << R"({"Genres": ["Comedy"], "Mark": 8, "Status": null})";
+    answer_prompts(root_pth / "answers", "y\n");
+    classify(source_pth, destination_pth, false);
+
+    EXPECT_FALSE(std::filesystem::exists(
+            std::filesystem::symlink_status(destination_pth / "Genres" / "Comedy" / "c")));
+    EXPECT_FALSE(std::filesystem::exists(
+            std::filesystem::symlink_status(destination_pth / "Mark" / "8" / "c")));
+    EXPECT_TRUE(std::filesystem::is_symlink(destination_pth / "Mark" / "1" / "entry1"));
+
+    std::filesystem::remove_all(source_pth / "c");
+    answer_prompts(root_pth / "answers", "y\n");
+    classify(source_pth, destination_pth, false);
+
+    std::cout.rdbuf(cout_buf);
+
+    EXPECT_FALSE(std::filesystem::exists(destination_pth / "Genres" / "Comedy"));
+    EXPECT_FALSE(std::filesystem::exists(destination_pth / "Mark" / "8"));
+
+    std::filesystem::remove_all(root_pth);
+}
+
+
+TEST(classifier_program, renamed_entry)
+{
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_program_renamed_entry_test";
+    std::filesystem::path source_pth = root_pth / "source";
+    std::filesystem::path destination_pth = root_pth / "destination";
+    std::filesystem::path drama_pth = destination_pth / "Genres" / "Drama";
+    null_buffer null_buf;
+    std::streambuf* cout_buf = std::cout.rdbuf(&null_buf);
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(destination_pth);
+
+    make_entries(source_pth, 0, 4);
+    classify(source_pth, destination_pth, false);
+
+    // The links of a renamed entry are moved to its new name and point to its new path.
+    std::filesystem::rename(source_pth / "entry2", source_pth / "renamed");
+    classify(source_pth, destination_pth, false);
+
+    std::cout.rdbuf(cout_buf);
+
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::symlink_status(drama_pth / "entry2")));
+    ASSERT_TRUE(std::filesystem::is_symlink(drama_pth / "renamed"));
+    EXPECT_EQ(std::filesystem::read_symlink(drama_pth / "renamed"), source_pth / "renamed");
+    EXPECT_TRUE(std::filesystem::is_symlink(destination_pth / "Mark" / "2" / "renamed"));
+
+    std::filesystem::remove_all(root_pth);
+}
+
+
+TEST(classifier_program, failed_move)
+{
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_program_failed_move_test";
+    std::filesystem::path source_pth = root_pth / "source";
+    std::filesystem::path destination_pth = root_pth / "destination";
+    std::filesystem::path drama_pth = destination_pth / "Genres" / "Drama";
+    null_buffer null_buf;
+    std::streambuf* cout_buf = std::cout.rdbuf(&null_buf);
+    classifier::state_file stte;
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(destination_pth);
+
+    make_entries(source_pth, 0, 4);
+    classify(source_pth, destination_pth, false);
+
+    // A link whose new name is taken is not created, the entry is classified again by the next
+    // run once the name is free.
+    std::ofstream(drama_pth / "renamed1") << "taken";
+    std::filesystem::rename(source_pth / "entry1", source_pth / "renamed1");
+    classify(source_pth, destination_pth, false);
+
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::symlink_status(drama_pth / "entry1")));
+    EXPECT_FALSE(std::filesystem::is_symlink(drama_pth / "renamed1"));
+    EXPECT_TRUE(std::filesystem::is_symlink(destination_pth / "Mark" / "1" / "renamed1"));
+
+    std::filesystem::remove(drama_pth / "renamed1");
+    classify(source_pth, destination_pth, false);
+
+    ASSERT_TRUE(std::filesystem::is_symlink(drama_pth / "renamed1"));
+    EXPECT_EQ(std::filesystem::read_symlink(drama_pth / "renamed1"), source_pth / "renamed1");
+
+    // A link that cannot be removed is left in the state under its previous entry, for the next
+    // run to remove, while the new link is created.
+    std::filesystem::remove(drama_pth / "entry2");
+    std::filesystem::create_directories(drama_pth / "entry2" / "content");
+    std::filesystem::rename(source_pth / "entry2", source_pth / "renamed2");
+    classify(source_pth, destination_pth, false);
+
+    std::cout.rdbuf(cout_buf);
+
+    EXPECT_TRUE(std::filesystem::is_directory(drama_pth / "entry2"));
+    ASSERT_TRUE(std::filesystem::is_symlink(drama_pth / "renamed2"));
+    EXPECT_EQ(std::filesystem::read_symlink(drama_pth / "renamed2"), source_pth / "renamed2");
+    ASSERT_TRUE(stte.load(destination_pth / classifier::state_file::FILE_NAME));
+    ASSERT_NE(stte.find_entry((source_pth / "entry2" / ".categories.json").native()), nullptr);
+    EXPECT_EQ(stte.find_entry((source_pth / "entry2" / ".categories.json").native())->lnks.size(),
+              1u);
+    EXPECT_NE(stte.find_entry((source_pth / "renamed2" / ".categories.json").native()), nullptr);
+
+    std::filesystem::remove_all(root_pth);
+}
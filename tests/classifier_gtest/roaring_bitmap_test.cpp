@@ -0,0 +1,234 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier_gtest/roaring_bitmap_test.cpp
+ * @brief       roaring_bitmap unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/roaring_bitmap.hpp"
+
+
+namespace {
+
+
+classifier::roaring_bitmap make_bitmap(const std::set<std::uint32_t>& vals)
+{
+    classifier::roaring_bitmap bitmp;
+
+    for (auto& x : vals)
+    {
+        bitmp.add(x);
+    }
+
+    return bitmp;
+}
+
+
+std::set<std::uint32_t> get_values(const classifier::roaring_bitmap& bitmp)
+{
+    std::set<std::uint32_t> vals;
+
+    bitmp.for_each([&](std::uint32_t val)
+    {
+        vals.insert(val);
+    });
+
+    return vals;
+}
+
+
+}
+
+
+TEST(classifier_roaring_bitmap, add_remove)
+{
+    classifier::roaring_bitmap bitmp;
+
+    EXPECT_TRUE(bitmp.is_empty());
+
+    // Enough values in the first container to turn it into a bitset.
+    for (std::uint32_t i = 0; i < 10000; i += 2)
+    {
+        bitmp.add(i);
+    }
+
+    bitmp.add(70000);
+    bitmp.add(5);
+    bitmp.add(5);
+
+    EXPECT_EQ(bitmp.get_cardinality(), 5002);
+    EXPECT_TRUE(bitmp.contains(5));
+    EXPECT_TRUE(bitmp.contains(9998));
+    EXPECT_TRUE(bitmp.contains(70000));
+    EXPECT_FALSE(bitmp.contains(7));
+    EXPECT_FALSE(bitmp.contains(70001));
+
+    for (std::uint32_t i = 0; i < 10000; i += 2)
+    {
+        bitmp.remove(i);
+    }
+
+    bitmp.remove(70001);
+
+    EXPECT_EQ(get_values(bitmp), (std::set<std::uint32_t>{5, 70000}));
+    EXPECT_EQ(bitmp, make_bitmap({5, 70000}));
+
+    bitmp.remove(5);
+    bitmp.remove(70000);
+    EXPECT_TRUE(bitmp.is_empty());
+}
+
+
+TEST(classifier_roaring_bitmap, add_range)
+{
+    classifier::roaring_bitmap bitmp;
+    std::set<std::uint32_t> expected_vals = {3, 200000};
+
+    bitmp.add(3);
+    bitmp.add(200000);
+    bitmp.add_range(10, 140000);
+    for (std::uint32_t i = 10; i < 140000; ++i)
+    {
+        expected_vals.insert(i);
+    }
+
+    EXPECT_EQ(get_values(bitmp), expected_vals);
+    EXPECT_EQ(bitmp, make_bitmap(expected_vals));
+
+    bitmp.add_range(5, 5);
+    EXPECT_EQ(bitmp.get_cardinality(), expected_vals.size());
+}
+
+
+TEST(classifier_roaring_bitmap, sparse_intersection)
+{
+    std::set<std::uint32_t> lhs_vals;
+    std::set<std::uint32_t> rhs_vals;
+    std::set<std::uint32_t> expected_vals;
+    std::uint32_t seed = 1;
+
+    // Arrays of unrelated lengths, so that the blocks compared together are rarely aligned.
+    for (std::uint32_t i = 0; i < 3000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        lhs_vals.insert((seed >> 8) % 20000);
+        seed = seed * 1103515245 + 12345;
+        rhs_vals.insert((seed >> 8) % 20000);
+        rhs_vals.insert(i * 7);
+    }
+
+    classifier::roaring_bitmap res = make_bitmap(lhs_vals);
+
+    std::set_intersection(lhs_vals.begin(), lhs_vals.end(), rhs_vals.begin(), rhs_vals.end(),
+                          std::inserter(expected_vals, expected_vals.end()));
+    res &= make_bitmap(rhs_vals);
+    EXPECT_EQ(get_values(res), expected_vals);
+    EXPECT_EQ(res, make_bitmap(expected_vals));
+}
+
+
+TEST(classifier_roaring_bitmap, set_operations)
+{
+    std::set<std::uint32_t> lhs_vals;
+    std::set<std::uint32_t> rhs_vals;
+    std::set<std::uint32_t> expected_vals;
+
+    // Sparse and dense containers on both sides, with shared and distinct high bits.
+    for (std::uint32_t i = 0; i < 200000; i += 3)
+    {
+        lhs_vals.insert(i);
+    }
+
+    for (std::uint32_t i = 0; i < 100000; i += 37)
+    {
+        lhs_vals.insert(300000 + i);
+        rhs_vals.insert(300000 + i * 2);
+    }
+
+    for (std::uint32_t i = 50000; i < 400000; i += 5)
+    {
+        rhs_vals.insert(i);
+    }
+
+    classifier::roaring_bitmap lhs = make_bitmap(lhs_vals);
+    classifier::roaring_bitmap rhs = make_bitmap(rhs_vals);
+    classifier::roaring_bitmap res;
+
+    expected_vals.clear();
+    std::set_intersection(lhs_vals.begin(), lhs_vals.end(), rhs_vals.begin(), rhs_vals.end(),
+                          std::inserter(expected_vals, expected_vals.end()));
+    res = lhs;
+    res &= rhs;
+    EXPECT_EQ(get_values(res), expected_vals);
+    EXPECT_EQ(res, make_bitmap(expected_vals));
+
+    expected_vals.clear();
+    std::set_union(lhs_vals.begin(), lhs_vals.end(), rhs_vals.begin(), rhs_vals.end(),
+                   std::inserter(expected_vals, expected_vals.end()));
+    res = lhs;
+    res |= rhs;
+    EXPECT_EQ(get_values(res), expected_vals);
+    EXPECT_EQ(res, make_bitmap(expected_vals));
+
+    expected_vals.clear();
+    std::set_difference(lhs_vals.begin(), lhs_vals.end(), rhs_vals.begin(), rhs_vals.end(),
+                        std::inserter(expected_vals, expected_vals.end()));
+    res = lhs;
+    res -= rhs;
+    EXPECT_EQ(get_values(res), expected_vals);
+    EXPECT_EQ(res, make_bitmap(expected_vals));
+    EXPECT_EQ(res.get_cardinality(), expected_vals.size());
+}
+
+
+TEST(classifier_roaring_bitmap, serialize)
+{
+    classifier::roaring_bitmap bitmp;
+    classifier::roaring_bitmap read_bitmp;
+    std::string buf = "x";
+    std::size_t offst = 1;
+
+    for (std::uint32_t i = 0; i < 6000; ++i)
+    {
+        bitmp.add(i * 3);
+    }
+
+    bitmp.add(1000000);
+    bitmp.serialize(&buf);
+
+    ASSERT_TRUE(read_bitmp.deserialize(buf, &offst));
+    EXPECT_EQ(offst, buf.size());
+    EXPECT_EQ(read_bitmp, bitmp);
+
+    offst = 1;
+    EXPECT_FALSE(read_bitmp.deserialize(std::string_view(buf).substr(0, buf.size() - 1), &offst));
+    EXPECT_TRUE(read_bitmp.is_empty());
+}
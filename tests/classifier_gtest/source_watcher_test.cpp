@@ -0,0 +1,133 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file        classifier_gtest/source_watcher_test.cpp
+ * @brief       source_watcher unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#if defined(__linux__)
+
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/source_watcher.hpp"
+
+
+TEST(classifier_source_watcher, wait)
+{
+    std::filesystem::path root_pth = std::filesystem::temp_directory_path() /
+                                     "classifier_source_watcher_test";
+    classifier::source_watcher watchr(root_pth, ".categories.json");
+    classifier::source_changes chnges;
+
+    std::filesystem::remove_all(root_pth);
+    std::filesystem::create_directories(root_pth / "Kept");
+    std::filesystem::create_directories(root_pth / "Moved");
+    std::ofstream(root_pth / "Moved" / ".categories.json") << "{}";
+
+    ASSERT_TRUE(watchr.open());
+
+    // A burst of changes is reported at once, the categories files of a new directory included.
+    std::ofstream(root_pth / "Kept" / ".categories.json") << "{}";
+    std::ofstream(root_pth / "Kept" / "other.json") << "{}";
+    std::filesystem::create_directories(root_pth / "New" / "Nested");
+    std::ofstream(root_pth / "New" / "Nested" / ".categories.json") << "{}";
+    std::filesystem::rename(root_pth / "Moved", root_pth / "Renamed");
+
+    ASSERT_TRUE(watchr.wait(&chnges));
+    EXPECT_FALSE(chnges.overflowed);
+    EXPECT_EQ(chnges.categories_file_pths,
+              (std::vector<std::filesystem::path>{root_pth / "Kept" / ".categories.json",
+                                                  root_pth / "New" / "Nested" / ".categories.json",
+                                                  root_pth / "Renamed" / ".categories.json"}));
+    EXPECT_EQ(chnges.removed_dirs, (std::vector<std::filesystem::path>{root_pth / "Moved"}));
+
+    // The directories that appeared are watched as well.
+    std::filesystem::remove(root_pth / "New" / "Nested" / ".categories.json");
+
+    ASSERT_TRUE(watchr.wait(&chnges));
+    EXPECT_EQ(chnges.categories_file_pths, (std::vector<std::filesystem::path>{
+            root_pth / "New" / "Nested" / ".categories.json"}));
+    EXPECT_TRUE(chnges.removed_dirs.empty());
+
+    watchr.close();
+    std::filesystem::remove_all(root_pth);
+}
+
+
+TEST(classifier_source_watcher, linked_directories)
+{
+    std::filesystem::path tmp_pth = std::filesystem::temp_directory_path() /
+                                    "classifier_source_watcher_linked_test";
+    std::filesystem::path root_pth = tmp_pth / "Source";
+    std::filesystem::path external_pth = tmp_pth / "External";
+    classifier::source_watcher watchr(root_pth, ".categories.json");
+    classifier::source_changes chnges;
+
+    std::filesystem::remove_all(tmp_pth);
+    std::filesystem::create_directories(root_pth / "Kept");
+    std::filesystem::create_directories(external_pth / "Linked" / "Nested");
+    std::filesystem::create_directories(external_pth / "Late");
+    std::filesystem::create_directory_symlink(external_pth / "Linked", root_pth / "Linked");
+    std::filesystem::create_directory_symlink(root_pth / "Kept", root_pth / "Inner");
+
+    ASSERT_TRUE(watchr.open());
+    EXPECT_EQ(watchr.get_failure_reason(), nullptr);
+
+    // The changes behind a link are reported under its path, and a link into the tree is not
+    // followed.
+    std::ofstream(external_pth / "Linked" / "Nested" / ".categories.json") << "{}";
+    std::ofstream(root_pth / "Kept" / ".categories.json") << "{}";
+
+    ASSERT_TRUE(watchr.wait(&chnges));
+    EXPECT_EQ(chnges.categories_file_pths,
+              (std::vector<std::filesystem::path>{
+                      root_pth / "Kept" / ".categories.json",
+                      root_pth / "Linked" / "Nested" / ".categories.json"}));
+    EXPECT_TRUE(chnges.removed_dirs.empty());
+
+    // A link created is followed, and a link removed removes its directory.
+    std::ofstream(external_pth / "Late" / ".categories.json") << "{}";
+    std::filesystem::create_directory_symlink(external_pth / "Late", root_pth / "Late");
+    std::filesystem::remove(root_pth / "Linked");
+
+    ASSERT_TRUE(watchr.wait(&chnges));
+    EXPECT_EQ(chnges.categories_file_pths, (std::vector<std::filesystem::path>{
+            root_pth / "Late" / ".categories.json"}));
+    EXPECT_EQ(chnges.removed_dirs, (std::vector<std::filesystem::path>{root_pth / "Linked"}));
+
+    // The directory behind a link removed is no longer watched.
+    std::ofstream(external_pth / "Linked" / "Nested" / ".categories.json") << "{\"Mark\": 1}";
+    std::ofstream(external_pth / "Late" / ".categories.json") << "{\"Mark\": 1}";
+
+    ASSERT_TRUE(watchr.wait(&chnges));
+    EXPECT_EQ(chnges.categories_file_pths, (std::vector<std::filesystem::path>{
+            root_pth / "Late" / ".categories.json"}));
+
+    watchr.close();
+    std::filesystem::remove_all(tmp_pth);
+}
+
+#endif
@@ -0,0 +1,222 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/state_file_test.cpp
+ * @brief       state_file unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/17
+ */
+
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/state_file.hpp"
+
+
+namespace {
+
+
+classifier::entry_state make_entry(std::uint64_t content_hsh, const char* lnk_pth)
+{
+    classifier::entry_state entry_stte;
+
+    entry_stte.content_hsh = content_hsh;
+    entry_stte.lnks.push_back({std::filesystem::path(lnk_pth).native(), {1, content_hsh}});
+
+    return entry_stte;
+}
+
+
+classifier::state_file::string_type native(const char* pth)
+{
+    return std::filesystem::path(pth).native();
+}
+
+
+}
+
+
+TEST(classifier_state_file, save_changes)
+{
+    std::filesystem::path state_file_pth = std::filesystem::temp_directory_path() /
+                                           "classifier_state_file_test";
+    std::filesystem::path journal_pth = state_file_pth.native() +
+                                        native(classifier::state_file::JOURNAL_SUFFIX);
+
+    {
+        classifier::state_file stte;
+
+        stte.add_entry(native("a/.categories.json"), make_entry(1, "Genres/Drama/a"));
+        stte.add_entry(native("b/.categories.json"), make_entry(2, "Genres/Drama/b"));
+        stte.add_directory_id(native("Genres"), {1, 10});
+        stte.add_directory_id(native("Mark"), {1, 11});
+        for (std::uint64_t i = 0; i < 20; ++i)
+        {
+            stte.add_entry(native("other") + native(std::to_string(i).c_str()),
+                           make_entry(10 + i, "Genres/Drama/other"));
+        }
+
+        ASSERT_TRUE(stte.save(state_file_pth));
+        EXPECT_FALSE(std::filesystem::exists(journal_pth));
+
+        // Only the changes are appended to the journal.
+        stte.track_changes();
+        stte.add_entry(native("b/.categories.json"), make_entry(3, "Genres/Comedy/b"));
+        stte.add_entry(native("c/.categories.json"), make_entry(4, "Genres/Drama/c"));
+        stte.remove_entry(native("a/.categories.json"));
+        stte.remove_directory(native("Mark"));
+        ASSERT_TRUE(stte.save_changes(state_file_pth));
+        EXPECT_TRUE(std::filesystem::exists(journal_pth));
+
+        stte.set_link_id(native("c/.categories.json"), native("Genres/Drama/c"), {2, 4});
+        ASSERT_TRUE(stte.save_changes(state_file_pth));
+    }
+
+    {
+        classifier::state_file stte;
+
+        ASSERT_TRUE(stte.load(state_file_pth));
+        EXPECT_EQ(stte.get_entries_number(), 22);
+        EXPECT_EQ(stte.find_entry(native("a/.categories.json")), nullptr);
+        ASSERT_NE(stte.find_entry(native("b/.categories.json")), nullptr);
+        EXPECT_EQ(stte.find_entry(native("b/.categories.json"))->content_hsh, 3);
+        ASSERT_NE(stte.find_entry(native("c/.categories.json")), nullptr);
+        EXPECT_EQ(stte.find_entry(native("c/.categories.json"))->lnks[0].id,
+                  (classifier::file_id{2, 4}));
+        EXPECT_NE(stte.find_directory(native("Genres")), nullptr);
+        EXPECT_EQ(stte.find_directory(native("Mark")), nullptr);
+
+        // A journal left behind by a previous state is ignored.
+        ASSERT_TRUE(std::filesystem::copy_file(journal_pth, state_file_pth.native() +
+                                               native(".old")));
+        ASSERT_TRUE(stte.save(state_file_pth));
+        EXPECT_FALSE(std::filesystem::exists(journal_pth));
+        std::filesystem::rename(state_file_pth.native() + native(".old"), journal_pth);
+
+        // A record torn by an interrupted append is ignored, along with the ones after it.
+        stte.track_changes();
+        stte.remove_entry(native("b/.categories.json"));
+        ASSERT_TRUE(stte.save_changes(state_file_pth));
+        std::ofstream(journal_pth, std::ios::binary | std::ios::app) << '\0' << "torn";
+    }
+
+    {
+        classifier::state_file stte;
+
+        ASSERT_TRUE(stte.load(state_file_pth));
+        EXPECT_EQ(stte.get_entries_number(), 21);
+        EXPECT_EQ(stte.find_entry(native("b/.categories.json")), nullptr);
+        EXPECT_NE(stte.find_entry(native("c/.categories.json")), nullptr);
+
+        stte.track_changes();
+        stte.add_entry(native("d/.categories.json"), make_entry(5, "Genres/Drama/d"));
+        ASSERT_TRUE(stte.save_changes(state_file_pth));
+    }
+
+    {
+        classifier::state_file stte;
+
+        ASSERT_TRUE(stte.load(state_file_pth));
+        EXPECT_EQ(stte.get_entries_number(), 22);
+        EXPECT_NE(stte.find_entry(native("d/.categories.json")), nullptr);
+    }
+
+    std::filesystem::remove(state_file_pth);
+    std::filesystem::remove(journal_pth);
+}
+
+
+TEST(classifier_state_file, corrupted_counts)
+{
+    std::filesystem::path state_file_pth = std::filesystem::temp_directory_path() /
+                                           "classifier_state_file_corrupted_test";
+    classifier::state_file::string_type entry_pth = native("a/.categories.json");
+    // The header and the number of directories and of entries, then the entry up to its links.
+    std::streamoff dirs_nbr_pos = 24;
+    std::streamoff lnks_nbr_pos = 40 + 4 + 48 + static_cast<std::streamoff>(
+            entry_pth.size() * sizeof(classifier::state_file::string_type::value_type));
+    std::uint64_t huge_nbr = ~std::uint64_t(0);
+    classifier::state_file stte;
+
+    stte.add_entry(entry_pth, make_entry(1, "Genres/Drama/a"));
+    ASSERT_TRUE(stte.save(state_file_pth));
+    ASSERT_TRUE(stte.load(state_file_pth));
+    ASSERT_EQ(stte.get_entries_number(), 1);
+
+    // A count larger than what the rest of the file can hold fails the load, without making
+    // room for it.
+    std::fstream(state_file_pth, std::ios::binary | std::ios::in | std::ios::out)
+            .seekp(lnks_nbr_pos)
+            .write(reinterpret_cast<const char*>(&huge_nbr), sizeof(std::uint32_t));
+
+    EXPECT_FALSE(stte.load(state_file_pth));
+    EXPECT_EQ(stte.get_entries_number(), 0);
+
+    std::fstream(state_file_pth, std::ios::binary | std::ios::in | std::ios::out)
+            .seekp(dirs_nbr_pos)
+            .write(reinterpret_cast<const char*>(&huge_nbr), sizeof(huge_nbr));
+
+    EXPECT_FALSE(stte.load(state_file_pth));
+    EXPECT_EQ(stte.get_entries_number(), 0);
+
+    std::filesystem::remove(state_file_pth);
+}
+
+
+TEST(classifier_state_file, track_changes)
+{
+    classifier::state_file stte;
+    classifier::entry_state entry_stte = make_entry(1, "Genres/Drama/a");
+    std::vector<classifier::state_file::string_type> entry_pths;
+
+    entry_stte.dirs.push_back(native("Seen"));
+    stte.add_entry(native("src/a/.categories.json"), entry_stte);
+    stte.track_changes();
+    stte.add_entry(native("src/ab/.categories.json"), make_entry(2, "Genres/Drama/ab"));
+    stte.add_entry(native("src/a/b/.categories.json"), make_entry(3, "Genres/Comedy/b"));
+
+    EXPECT_TRUE(stte.is_link_used(native("Genres/Drama/a")));
+    EXPECT_FALSE(stte.is_link_used(native("Genres/Drama/b")));
+    EXPECT_TRUE(stte.is_directory_used(native("Genres/Comedy")));
+    EXPECT_TRUE(stte.is_directory_used(native("Genres")));
+    EXPECT_TRUE(stte.is_directory_used(native("Seen")));
+
+    // The entries inside a directory are found by their path, in order.
+    stte.for_each_entry_under(native("src/a"), [&](auto pth)
+    {
+        entry_pths.emplace_back(pth);
+    });
+
+    ASSERT_EQ(entry_pths.size(), 2u);
+    EXPECT_EQ(entry_pths[0], native("src/a/.categories.json"));
+    EXPECT_EQ(entry_pths[1], native("src/a/b/.categories.json"));
+
+    // A directory is no longer used once its last link is gone.
+    stte.remove_entry(native("src/a/b/.categories.json"));
+    EXPECT_FALSE(stte.is_directory_used(native("Genres/Comedy")));
+    EXPECT_TRUE(stte.is_directory_used(native("Genres")));
+
+    stte.add_entry(native("src/a/.categories.json"), make_entry(1, "Genres/Comedy/a"));
+    EXPECT_FALSE(stte.is_link_used(native("Genres/Drama/a")));
+    EXPECT_TRUE(stte.is_directory_used(native("Genres/Comedy")));
+    EXPECT_FALSE(stte.is_directory_used(native("Seen")));
+}
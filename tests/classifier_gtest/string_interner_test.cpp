@@ -0,0 +1,93 @@
+/* classifier
+ * Copyright (C) 2024 Killian Valverde.
+ *
+ * This file is part of classifier.
+ *
+ * classifier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * classifier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with classifier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file        classifier_gtest/string_interner_test.cpp
+ * @brief       string_interner unit test.
+ * @author      Killian Valverde
+ * @date        2026/10/16
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "classifier/string_interner.hpp"
+
+
+TEST(classifier_string_interner, intern)
+{
+    classifier::string_interner interner;
+    std::string large_str(classifier::string_interner::BLOCK_SIZE, 'x');
+    std::vector<std::uint32_t> ids;
+
+    EXPECT_EQ(interner.find("Drama"), classifier::string_interner::NPOS);
+
+    EXPECT_EQ(interner.intern("Drama"), 0);
+    EXPECT_EQ(interner.intern("Comedy"), 1);
+    EXPECT_EQ(interner.intern(std::string("Drama")), 0);
+    EXPECT_EQ(interner.intern(""), 2);
+    EXPECT_EQ(interner.intern(large_str), 3);
+    EXPECT_EQ(interner.find("Comedy"), 1);
+
+    // Enough strings to fill many blocks, the first ones must not move.
+    for (std::size_t i = 0; i < 20000; ++i)
+    {
+        ids.push_back(interner.intern("Genre " + std::to_string(i)));
+    }
+
+    EXPECT_EQ(interner.size(), 20004);
+    EXPECT_EQ(interner.get_string(0), "Drama");
+    EXPECT_EQ(interner.get_string(2), "");
+    EXPECT_EQ(interner.get_string(3), large_str);
+
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        EXPECT_EQ(interner.get_string(ids[i]), "Genre " + std::to_string(i));
+    }
+
+    interner.clear();
+    EXPECT_EQ(interner.size(), 0);
+    EXPECT_EQ(interner.find("Drama"), classifier::string_interner::NPOS);
+    EXPECT_EQ(interner.intern("Comedy"), 0);
+}
+
+
+TEST(classifier_string_interner, remove)
+{
+    classifier::string_interner interner;
+
+    interner.intern("Drama");
+    interner.intern("Comedy");
+    interner.intern("Action");
+
+    // The last string takes the identifier of the removed one.
+    interner.remove(0);
+    EXPECT_EQ(interner.size(), 2);
+    EXPECT_EQ(interner.find("Drama"), classifier::string_interner::NPOS);
+    EXPECT_EQ(interner.find("Action"), 0);
+    EXPECT_EQ(interner.get_string(0), "Action");
+    EXPECT_EQ(interner.find("Comedy"), 1);
+
+    interner.remove(1);
+    EXPECT_EQ(interner.size(), 1);
+    EXPECT_EQ(interner.find("Comedy"), classifier::string_interner::NPOS);
+    EXPECT_EQ(interner.intern("Drama"), 1);
+}